@@ -0,0 +1,248 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Allocation churn benchmark: allocate and free buffers in a loop, from one or more threads, 
+// for each memory type (shared, device, host), size class (64 B - 1 GB) and alignment. 
+// Reports the number of alloc+free operations per second and the latency percentiles of 
+// each call.
+
+#include <ze_api.h>
+#include "benchStats.hpp"
+#include "phaseTimer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define WARMUP_ITERATIONS 4
+
+#define VALIDATECALL(myZeCall) \
+    if (myZeCall != ZE_RESULT_SUCCESS){ \
+        std::cout << "Error at "       \
+            << #myZeCall << ": "       \
+            << __FUNCTION__ << ": "    \
+            << __LINE__ << std::endl;  \
+        std::cout << "Exit with Error Code: " \
+            << "0x" << std::hex \
+            << myZeCall \
+            << std::dec << std::endl; \
+        std::terminate(); \
+    }
+
+void init(ze_driver_handle_t &driverHandle, ze_context_handle_t &context, ze_device_handle_t &device ) {
+    // Initialization
+    VALIDATECALL(zeInit(ZE_INIT_FLAG_GPU_ONLY));
+
+    // Get the driver
+    uint32_t driverCount = 1;
+    VALIDATECALL(zeDriverGet(&driverCount, &driverHandle));
+
+    // Create the context
+    ze_context_desc_t contextDescription = {};
+    contextDescription.stype = ZE_STRUCTURE_TYPE_CONTEXT_DESC;
+    VALIDATECALL(zeContextCreate(driverHandle, &contextDescription, &context));
+
+    // Get the device
+    uint32_t deviceCount = 1;
+    VALIDATECALL(zeDeviceGet(driverHandle, &deviceCount, &device));
+}
+
+void printBasicInfo(ze_device_handle_t device) {
+    // Print basic properties of the device
+    ze_device_properties_t deviceProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES};
+    VALIDATECALL(zeDeviceGetProperties(device, &deviceProperties));
+    std::cout << "Device   : " << deviceProperties.name << "\n" 
+              << "Type     : " << ((deviceProperties.type == ZE_DEVICE_TYPE_GPU) ? "GPU" : "FPGA") << "\n"
+              << "Vendor ID: " << std::hex << deviceProperties.vendorId << std::dec << "\n"
+              << "Max Allocation Size: " << deviceProperties.maxMemAllocSize << " (bytes)" << std::endl;
+}
+
+ze_result_t allocate(ze_context_handle_t context, ze_device_handle_t device, char type, size_t size, size_t alignment, void **buffer) {
+    ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
+    memAllocDesc.ordinal = 0;
+    ze_host_mem_alloc_desc_t hostDesc = {ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC};
+    if (type == 's') {
+        return zeMemAllocShared(context, &memAllocDesc, &hostDesc, size, alignment, device, buffer);
+    } else if (type == 'd') {
+        return zeMemAllocDevice(context, &memAllocDesc, size, alignment, device, buffer);
+    }
+    return zeMemAllocHost(context, &hostDesc, size, alignment, buffer);
+}
+
+const char *memoryTypeName(char type) {
+    switch (type) {
+        case 's': return "SHARED";
+        case 'd': return "DEVICE";
+        default: return "HOST";
+    }
+}
+
+struct ThreadResult {
+    std::vector<double> allocLatencies;
+    std::vector<double> freeLatencies;
+    uint64_t failures;
+    std::chrono::steady_clock::time_point begin;
+    std::chrono::steady_clock::time_point end;
+};
+
+// Alloc/free loop executed by each thread
+void allocFreeLoop(ze_context_handle_t context, ze_device_handle_t device, char type, size_t size, size_t alignment,
+                   int operations, std::atomic<int> &ready, int numThreads, ThreadResult &result) {
+    result.allocLatencies.reserve(operations);
+    result.freeLatencies.reserve(operations);
+    result.failures = 0;
+
+    // Warm-up, then wait for all threads to start at the same time
+    for (int i = 0; i < WARMUP_ITERATIONS; i++) {
+        void *buffer = nullptr;
+        if (allocate(context, device, type, size, alignment, &buffer) == ZE_RESULT_SUCCESS) {
+            VALIDATECALL(zeMemFree(context, buffer));
+        }
+    }
+    ready.fetch_add(1);
+    while (ready.load() < numThreads) {
+    }
+
+    result.begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < operations; i++) {
+        void *buffer = nullptr;
+        auto begin = std::chrono::steady_clock::now();
+        ze_result_t status = allocate(context, device, type, size, alignment, &buffer);
+        auto end = std::chrono::steady_clock::now();
+        if (status != ZE_RESULT_SUCCESS) {
+            result.failures++;
+            continue;
+        }
+        result.allocLatencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count());
+
+        begin = std::chrono::steady_clock::now();
+        VALIDATECALL(zeMemFree(context, buffer));
+        end = std::chrono::steady_clock::now();
+        result.freeLatencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count());
+    }
+    result.end = std::chrono::steady_clock::now();
+}
+
+void benchmarkAllocFree(ze_context_handle_t context, ze_device_handle_t device, char type, size_t size, size_t alignment,
+                        int iterations, int numThreads) {
+
+    // Large buffers are slow to allocate; scale down the number of operations above 1 MB
+    const size_t oneMB = 1 << 20;
+    int operations = iterations;
+    if (size > oneMB) {
+        operations = std::max(4, static_cast<int>(iterations / (size / oneMB)));
+    }
+
+    std::vector<ThreadResult> results(numThreads);
+    std::vector<std::thread> threads;
+    std::atomic<int> ready(0);
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back(allocFreeLoop, context, device, type, size, alignment, operations, 
+                             std::ref(ready), numThreads, std::ref(results[t]));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::vector<double> allocLatencies;
+    std::vector<double> freeLatencies;
+    uint64_t failures = 0;
+    for (auto &result : results) {
+        allocLatencies.insert(allocLatencies.end(), result.allocLatencies.begin(), result.allocLatencies.end());
+        freeLatencies.insert(freeLatencies.end(), result.freeLatencies.begin(), result.freeLatencies.end());
+        failures += result.failures;
+    }
+
+    // The wall-clock time includes the warm-up and thread creation. The throughput is computed 
+    // over the measured loops only: from the first thread starting to the last thread finishing.
+    auto firstBegin = results[0].begin;
+    auto lastEnd = results[0].end;
+    for (auto &result : results) {
+        firstBegin = std::min(firstBegin, result.begin);
+        lastEnd = std::max(lastEnd, result.end);
+    }
+    double loopNs = std::chrono::duration_cast<std::chrono::nanoseconds> (lastEnd - firstBegin).count();
+    double opsPerSecond = (loopNs > 0) ? allocLatencies.size() / (loopNs * 1e-9) : 0;
+
+    std::string label = std::string(memoryTypeName(type)) + " size=" + std::to_string(size) 
+                      + " align=" + std::to_string(alignment) + " threads=" + std::to_string(numThreads);
+    std::cout << "OPS " << label << ": " << opsPerSecond << " alloc+free/s"
+              << " (ops=" << allocLatencies.size() << " failures=" << failures 
+              << " wall=" << std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count() << " [ns])" << std::endl;
+    if (!allocLatencies.empty()) {
+        printStats("ALLOC " + label, computeStats(allocLatencies));
+        printStats("FREE " + label, computeStats(freeLatencies));
+    }
+}
+
+int main(int argc, char **argv) {
+
+    // ./allocThroughput [threads] [iterations] [memory types: s|d|h]
+    int numThreads = (argc > 1) ? atoi(argv[1]) : 1;
+    int iterations = (argc > 2) ? atoi(argv[2]) : 1000;
+    std::string types = (argc > 3) ? argv[3] : "sdh";
+    if (numThreads < 1 || iterations < 1) {
+        std::cout << "Usage: " << argv[0] << " [threads] [iterations] [memory types: s|d|h]\n"
+                  << "       The number of threads and iterations must be positive numbers" << std::endl;
+        return -1;
+    }
+    std::cout << "#Threads: " << numThreads << " #Iterations: " << iterations << std::endl;
+
+    PhaseTimer initTimer("init");
+    ze_driver_handle_t driverHandle;
+    ze_context_handle_t context;
+    ze_device_handle_t device;
+    init(driverHandle, context, device);
+    printBasicInfo(device);
+    initTimer.stop();
+
+    // Size classes from 64 B to 1 GB (x16)
+    std::vector<size_t> sizes;
+    for (size_t size = 64; size <= (1UL << 30); size *= 16) {
+        sizes.push_back(size);
+    }
+
+    // 0 lets the driver choose the alignment
+    const std::vector<size_t> alignments = {0, 64, 4096, 65536};
+
+    PHASE_TIMER("alloc");
+    for (char type : types) {
+        for (auto size : sizes) {
+            for (auto alignment : alignments) {
+                benchmarkAllocFree(context, device, type, size, alignment, iterations, numThreads);
+            }
+        }
+    }
+
+    VALIDATECALL(zeContextDestroy(context));
+    return 0;
+}
@@ -27,13 +27,16 @@
 //      https://github.com/intel/compute-runtime/blob/master/level_zero/core/test/black_box_tests/zello_timestamp.cpp
 
 #include <ze_api.h>
+#include "phaseTimer.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <string>
 #include <vector>
 
 #define VALIDATION 0
@@ -51,14 +54,149 @@
         std::terminate(); \
     }
 
+enum class MemoryType {
+    SHARED,
+    DEVICE,
+    HOST
+};
+
+const char *memoryTypeName(MemoryType type) {
+    switch (type) {
+        case MemoryType::SHARED: return "SHARED";
+        case MemoryType::DEVICE: return "DEVICE";
+        default: return "HOST";
+    }
+}
+
+struct AllocationSample {
+    size_t size;
+    bool success;
+    int64_t allocNs;
+    int64_t freeNs;
+};
+
+// Allocate and free one buffer of the given size, measuring the latency of each call
+AllocationSample tryAllocation(ze_context_handle_t context, ze_device_handle_t device, MemoryType type, size_t size, bool relaxed) {
+
+    ze_relaxed_allocation_limits_exp_desc_t exceedCapacity = {
+        ZE_STRUCTURE_TYPE_RELAXED_ALLOCATION_LIMITS_EXP_DESC,
+        nullptr, 
+        ZE_RELAXED_ALLOCATION_LIMITS_EXP_FLAG_MAX_SIZE
+    };
+    ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
+    memAllocDesc.flags = ZE_DEVICE_MEM_ALLOC_FLAG_BIAS_CACHED;
+    memAllocDesc.ordinal = 0;
+    ze_host_mem_alloc_desc_t hostDesc = {ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC};
+    if (relaxed) {
+        hostDesc.pNext = &exceedCapacity;
+        memAllocDesc.pNext = &exceedCapacity;
+    }
+
+    AllocationSample sample = {size, false, 0, 0};
+    void *buffer = nullptr;
+    ze_result_t result;
+    auto begin = std::chrono::steady_clock::now();
+    if (type == MemoryType::SHARED) {
+        result = zeMemAllocShared(context, &memAllocDesc, &hostDesc, size, 128, device, &buffer);
+    } else if (type == MemoryType::DEVICE) {
+        result = zeMemAllocDevice(context, &memAllocDesc, size, 64, device, &buffer);
+    } else {
+        result = zeMemAllocHost(context, &hostDesc, size, 64, &buffer);
+    }
+    auto end = std::chrono::steady_clock::now();
+    sample.allocNs = std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
+    sample.success = (result == ZE_RESULT_SUCCESS && buffer != nullptr);
+
+    if (sample.success) {
+        begin = std::chrono::steady_clock::now();
+        VALIDATECALL(zeMemFree(context, buffer));
+        end = std::chrono::steady_clock::now();
+        sample.freeNs = std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
+    }
+
+    std::cout << "PROBE " << memoryTypeName(type) << (relaxed ? " RELAXED" : " STRICT") 
+              << " size=" << size << " (" << (size * 1e-9) << " GB)"
+              << " alloc=" << sample.allocNs << " [ns]"
+              << " free=" << sample.freeNs << " [ns] "
+              << (sample.success ? "OK" : "FAIL") << std::endl;
+    return sample;
+}
+
+// Find the largest allocation that succeeds for a memory type. The size is doubled from 1 MB
+// (or the granularity, if it is smaller) until the allocation fails, which gives the cost curve 
+// for powers of two. The last step is clamped to the limit, so the limit itself is always tried. 
+// The result is then refined with a binary search down to the given granularity.
+size_t probeMaxAllocation(ze_context_handle_t context, ze_device_handle_t device, MemoryType type, bool relaxed, 
+                          size_t granularity, size_t limit) {
+    size_t lastSuccess = 0;
+    size_t firstFailure = 0;
+    size_t size = std::min(std::min(static_cast<size_t>(1 << 20), granularity), limit);
+    while (true) {
+        if (tryAllocation(context, device, type, size, relaxed).success) {
+            lastSuccess = size;
+        } else {
+            firstFailure = size;
+            break;
+        }
+        if (size == limit) {
+            break;
+        }
+        size = (size > limit / 2) ? limit : size * 2;
+    }
+    if (firstFailure == 0) {
+        // Every size up to the limit succeeded
+        return lastSuccess;
+    }
+    while (firstFailure - lastSuccess > granularity) {
+        size_t middle = lastSuccess + (firstFailure - lastSuccess) / 2;
+        middle -= middle % granularity;
+        if (middle <= lastSuccess) {
+            break;
+        }
+        if (tryAllocation(context, device, type, middle, relaxed).success) {
+            lastSuccess = middle;
+        } else {
+            firstFailure = middle;
+        }
+    }
+    return lastSuccess;
+}
+
+void runProbe(ze_context_handle_t context, ze_device_handle_t device, size_t granularity, size_t limit) {
+    const MemoryType types[] = {MemoryType::SHARED, MemoryType::DEVICE, MemoryType::HOST};
+    std::vector<std::string> summary;
+    for (auto type : types) {
+        for (bool relaxed : {false, true}) {
+            size_t maxSize = probeMaxAllocation(context, device, type, relaxed, granularity, limit);
+            summary.push_back(std::string("MAX-") + memoryTypeName(type) + (relaxed ? "-RELAXED" : "-STRICT") 
+                              + " = " + std::to_string(maxSize) + " bytes (" + std::to_string(maxSize * 1e-9) + " GB)");
+        }
+    }
+    std::cout << std::endl;
+    for (auto &line : summary) {
+        std::cout << line << std::endl;
+    }
+}
+
 int main(int argc, char **argv) {
 
+    // ./levelZeroAlloc probe [granularityInBytes] [limitInBytes]
+    bool probe = (argc > 1) && (std::string(argv[1]) == "probe");
+    long long probeGranularity = (probe && argc > 2) ? atoll(argv[2]) : (1 << 20);
+    long long probeLimit = (probe && argc > 3) ? atoll(argv[3]) : (1LL << 40);
+    if (probe && (probeGranularity <= 0 || probeLimit <= 0)) {
+        std::cout << "Usage: " << argv[0] << " probe [granularityInBytes] [limitInBytes]\n"
+                  << "       The granularity and the limit must be positive numbers of bytes" << std::endl;
+        return -1;
+    }
+
     size_t allocSize = 2147483648L;
-    if (argc > 1) {
+    if (argc > 1 && !probe) {
         allocSize = atoll(argv[1]);
     }
 
     // Initialization
+    PhaseTimer initTimer("init");
     VALIDATECALL(zeInit(ZE_INIT_FLAG_GPU_ONLY));
 
     // Get the driver
@@ -117,6 +255,19 @@ int main(int argc, char **argv) {
     ze_command_list_desc_t cmdListDesc = {};
     cmdListDesc.commandQueueGroupOrdinal = cmdQueueDesc.ordinal;    
     VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &cmdList));
+    initTimer.stop();
+
+    if (probe) {
+        std::cout << "Max Allocation Size (device properties): " << deviceProperties.maxMemAllocSize << " bytes" << std::endl;
+        {
+            PHASE_TIMER("probe");
+            runProbe(context, device, probeGranularity, probeLimit);
+        }
+        VALIDATECALL(zeCommandListDestroy(cmdList));
+        VALIDATECALL(zeCommandQueueDestroy(cmdQueue));
+        VALIDATECALL(zeContextDestroy(context));
+        return 0;
+    }
 
 
     ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
@@ -140,7 +291,9 @@ int main(int argc, char **argv) {
     memAllocDesc.pNext = &exceedCapacity;
 
     std::cout << "Allocating Shared Memory: " << allocSize << " bytes - " << (allocSize * 1e-9 ) << " (GB) " << std::endl;
+    PhaseTimer sharedTimer("alloc-shared");
     result = zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 128, device, &sharedBuffer);
+    sharedTimer.stop();
     if (result == 0x78000009) {
          std::cout << "size argument is not supported by the device \n";
     } else if (result == ZE_RESULT_SUCCESS) {
@@ -150,7 +303,9 @@ int main(int argc, char **argv) {
     // Option B) Device Memory
     void *deviceBuffer = nullptr;
     std::cout << "Allocating Device Memory: " << allocSize << " bytes - " << (allocSize * 1e-9 ) << " (GB) " << std::endl;
+    PhaseTimer deviceTimer("alloc-device");
     result = zeMemAllocDevice(context, &memAllocDesc, allocSize, 64, device, &deviceBuffer);
+    deviceTimer.stop();
     if (result == 0x78000009) {
         std::cout << "size argument is not supported by the device \n";
     } else if (result == ZE_RESULT_SUCCESS) {
@@ -160,7 +315,9 @@ int main(int argc, char **argv) {
     // Option C) Host Allocated Memory
     void *hostBuffer = nullptr;
     std::cout << "Allocating Host Memory: " << allocSize << " bytes - " << (allocSize * 1e-9 ) << " (GB) " << std::endl;
+    PhaseTimer hostTimer("alloc-host");
     result = zeMemAllocHost(context, &hostDesc, allocSize, 64, &hostBuffer);
+    hostTimer.stop();
     if (result == 0x78000009) {
         std::cout << "size argument is not supported by the device \n";
     } else if (result == ZE_RESULT_SUCCESS) {
@@ -168,6 +325,7 @@ int main(int argc, char **argv) {
     }
      
     // Cleanup
+    PHASE_TIMER("cleanup");
     if (sharedBuffer != nullptr) {
         VALIDATECALL(zeMemFree(context, sharedBuffer));
     }
@@ -0,0 +1,3 @@
+
+clang -cc1 -triple spir outOfCoreMxM.cl -O2 -finclude-default-header -emit-llvm-bc -o outOfCoreMxM.bc
+llvm-spirv outOfCoreMxM.bc -o outOfCoreMxM.spv
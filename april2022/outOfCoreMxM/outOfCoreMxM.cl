@@ -0,0 +1,32 @@
+// One step of the out-of-core matrix multiplication: C tile (+)= A tile x B tile.
+// All tiles are tile x tile, row major, and tile is a multiple of BLOCK.
+// Each work-group computes a BLOCK x BLOCK block of C, staging blocks of A and B in local memory.
+// With accumulate == 0 the C tile is overwritten (first step of each C tile).
+#define BLOCK 16
+
+__kernel __attribute__((reqd_work_group_size(BLOCK, BLOCK, 1)))
+void mxmTile(__global const float *a, __global const float *b, __global float *c, const int tile, const int accumulate) {
+	__local float blockA[BLOCK][BLOCK];
+	__local float blockB[BLOCK][BLOCK];
+
+	uint jdx = get_global_id(0);
+	uint idx = get_global_id(1);
+	uint localJ = get_local_id(0);
+	uint localI = get_local_id(1);
+
+	float sum = 0.0f;
+	for (int kk = 0; kk < tile; kk += BLOCK) {
+		blockA[localI][localJ] = a[idx * tile + kk + localJ];
+		blockB[localI][localJ] = b[(kk + localI) * tile + jdx];
+		barrier(CLK_LOCAL_MEM_FENCE);
+		for (int k = 0; k < BLOCK; k++) {
+			sum += blockA[localI][k] * blockB[k][localJ];
+		}
+		barrier(CLK_LOCAL_MEM_FENCE);
+	}
+
+	if (accumulate) {
+		sum += c[idx * tile + jdx];
+	}
+	c[idx * tile + jdx] = sum;
+}
@@ -0,0 +1,750 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Out-of-core matrix multiplication: C = A x B (n x n) with A, B and C in host memory, for
+// matrices that do not fit in device memory. The matrices are split in tile x tile tiles, and
+// C(i, j) = sum_k A(i, k) x B(k, j) is computed on the device with a fixed working set:
+//  - a cache of A and B tiles (as many slots as the device budget allows). Tiles that are
+//    already resident are reused; the tile evicted is the one used furthest in the future
+//    (the whole schedule is known in advance)
+//  - two C tiles, accumulated on the device over k and copied back once (double buffered, so
+//    the copy of C(i, j) overlaps the computation of the next tile)
+// Uploads run on a copy queue (copy engine if available) and kernels on a compute queue,
+// ordered with events only, so the upload of the next tiles overlaps the current kernel.
+// The traversal is serpentine in j and k, so consecutive steps share tiles.
+
+#include <ze_api.h>
+#include "benchStats.hpp"
+#include "cpuBackend.hpp"
+#include "phaseTimer.hpp"
+#include "zeTimestamps.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Steps in flight: command lists and events are used in a ring of RING_DEPTH entries
+#define RING_DEPTH 4
+
+// Work-group size of mxmTile (BLOCK in outOfCoreMxM.cl)
+#define BLOCK 16
+
+#define VALIDATECALL(myZeCall) \
+    if (myZeCall != ZE_RESULT_SUCCESS){ \
+        std::cout << "Error at "       \
+            << #myZeCall << ": "       \
+            << __FUNCTION__ << ": "    \
+            << __LINE__ << std::endl;  \
+        std::cout << "Exit with Error Code: " \
+            << "0x" << std::hex \
+            << myZeCall \
+            << std::dec << std::endl; \
+        std::terminate(); \
+    }
+
+constexpr size_t NEVER = std::numeric_limits<size_t>::max();
+
+enum TileMatrix { MATRIX_A = 0, MATRIX_B = 1 };
+
+uint64_t tileKey(TileMatrix matrix, uint32_t row, uint32_t col) {
+    return (static_cast<uint64_t>(matrix) << 62) | (static_cast<uint64_t>(row) << 31) | col;
+}
+
+// One kernel launch: C(i, j) (+)= A(i, k) x B(k, j)
+struct TileStep {
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+    bool firstK;
+    bool lastK;
+    uint64_t keyA;
+    uint64_t keyB;
+    // Next step that uses the same A/B tile (NEVER if none)
+    size_t nextUseA;
+    size_t nextUseB;
+};
+
+// Serpentine order: j alternates its direction for each row of C, and k for each C tile, so
+// the tiles of the last steps of a C tile are the first ones needed by the next C tile
+std::vector<TileStep> buildSchedule(uint32_t tiles) {
+    std::vector<TileStep> schedule;
+    bool kForward = true;
+    for (uint32_t i = 0; i < tiles; i++) {
+        for (uint32_t jj = 0; jj < tiles; jj++) {
+            uint32_t j = (i % 2 == 0) ? jj : tiles - 1 - jj;
+            for (uint32_t kk = 0; kk < tiles; kk++) {
+                uint32_t k = kForward ? kk : tiles - 1 - kk;
+                TileStep step = {i, j, k, kk == 0, kk == tiles - 1, tileKey(MATRIX_A, i, k), tileKey(MATRIX_B, k, j), NEVER, NEVER};
+                schedule.push_back(step);
+            }
+            kForward = !kForward;
+        }
+    }
+    std::unordered_map<uint64_t, size_t> nextUse;
+    for (size_t s = schedule.size(); s-- > 0;) {
+        auto a = nextUse.find(schedule[s].keyA);
+        auto b = nextUse.find(schedule[s].keyB);
+        schedule[s].nextUseA = (a == nextUse.end()) ? NEVER : a->second;
+        schedule[s].nextUseB = (b == nextUse.end()) ? NEVER : b->second;
+        nextUse[schedule[s].keyA] = s;
+        nextUse[schedule[s].keyB] = s;
+    }
+    return schedule;
+}
+
+// Resident A/B tiles of the device working set. The victim is the tile whose next use is the
+// furthest in the future (Belady), never the other tile of the current step.
+class TileCache {
+public:
+    explicit TileCache(size_t numSlots) : keys(numSlots), valid(numSlots, false), nextUse(numSlots, NEVER), lastUse(numSlots, -1) {}
+
+    // Slot for the tile used at step: resident is true on a hit. On a miss, victimLastUse is
+    // the last step that read the slot (-1 if it was empty), which must finish before the upload.
+    size_t acquire(uint64_t key, size_t keyNextUse, long step, uint64_t pinnedKey, bool &resident, long &victimLastUse) {
+        auto it = slotOf.find(key);
+        resident = (it != slotOf.end());
+        size_t slot;
+        if (resident) {
+            slot = it->second;
+            hits++;
+        } else {
+            slot = victim(pinnedKey);
+            victimLastUse = lastUse[slot];
+            if (valid[slot]) {
+                slotOf.erase(keys[slot]);
+            }
+            keys[slot] = key;
+            valid[slot] = true;
+            slotOf[key] = slot;
+            misses++;
+        }
+        nextUse[slot] = keyNextUse;
+        lastUse[slot] = step;
+        return slot;
+    }
+
+    size_t hits = 0;
+    size_t misses = 0;
+
+private:
+    size_t victim(uint64_t pinnedKey) {
+        size_t best = 0;
+        bool found = false;
+        for (size_t slot = 0; slot < keys.size(); slot++) {
+            if (!valid[slot]) {
+                return slot;
+            }
+            if (keys[slot] == pinnedKey) {
+                continue;
+            }
+            if (!found || nextUse[slot] > nextUse[best]) {
+                best = slot;
+                found = true;
+            }
+        }
+        return best;
+    }
+
+    std::vector<uint64_t> keys;
+    std::vector<bool> valid;
+    std::vector<size_t> nextUse;
+    std::vector<long> lastUse;
+    std::unordered_map<uint64_t, size_t> slotOf;
+};
+
+// Random values in [-1, 1], each thread with its own generator
+void initMatrix(float *matrix, size_t elements, unsigned seed) {
+    parallelFor(0, elements, [=](size_t begin, size_t end) {
+        std::mt19937 generator(seed + static_cast<unsigned>(begin));
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+        for (size_t i = begin; i < end; i++) {
+            matrix[i] = distribution(generator);
+        }
+    });
+}
+
+// A full reference is O(n^3) on the host: validate a random sample of elements of C, each one
+// computed in double with the tolerance of an fp32 dot product of length n
+bool validateSample(const float *a, const float *b, const float *c, uint32_t n, int samples) {
+    PHASE_TIMER("validation");
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<uint32_t> index(0, n - 1);
+    const double eps = std::numeric_limits<float>::epsilon();
+    for (int s = 0; s < samples; s++) {
+        size_t i = index(generator);
+        size_t j = index(generator);
+        double sum = 0;
+        double absSum = 0;
+        for (size_t k = 0; k < n; k++) {
+            sum += static_cast<double>(a[i * n + k]) * b[k * n + j];
+            absSum += std::abs(static_cast<double>(a[i * n + k]) * b[k * n + j]);
+        }
+        if (std::abs(c[i * n + j] - sum) > n * eps * absSum + std::numeric_limits<float>::min()) {
+            std::cout << "Mismatch at C[" << i << "][" << j << "]: " << c[i * n + j] << " vs " << sum << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+struct OutOfCoreResult {
+    double totalNs;
+    std::vector<double> kernelNs;
+    size_t hits;
+    size_t misses;
+};
+
+void printResult(const OutOfCoreResult &result, uint32_t n, uint32_t tile, size_t slots, bool valid) {
+    double flops = 2.0 * n * static_cast<double>(n) * n;
+    double uploadBytes = static_cast<double>(result.misses) * tile * tile * sizeof(float);
+    double kernelSum = 0;
+    for (auto ns : result.kernelNs) {
+        kernelSum += ns;
+    }
+    if (!result.kernelNs.empty()) {
+        printStats("TILE-KERNEL", computeStats(result.kernelNs));
+    }
+    std::cout << "TOTAL = " << result.totalNs << " [ns]" << std::endl;
+    std::cout << "GFLOPS = " << flops / result.totalNs << " GFLOP/s" << std::endl;
+    if (kernelSum > 0) {
+        std::cout << "GFLOPS-KERNEL = " << flops / kernelSum << " GFLOP/s (kernels only)" << std::endl;
+        std::cout << "OVERLAP-EFFICIENCY = " << kernelSum / result.totalNs << " (kernel time / total time)" << std::endl;
+    }
+    std::cout << "TILE-UPLOADS = " << result.misses << " hits=" << result.hits << " slots=" << slots
+              << " hitRate=" << 100.0 * result.hits / (result.hits + result.misses) << "%" << std::endl;
+    std::cout << "UPLOAD-GB = " << uploadBytes * 1e-9 << " (" << uploadBytes / (2.0 * n * n * sizeof(float))
+              << "x the size of A and B) GB/s=" << uploadBytes / result.totalNs << std::endl;
+    std::cout << "\nOut-of-core Matrix Multiply validation " << (valid ? "PASSED" : "FAILED") << "\n";
+}
+
+// Number of A/B tile slots that fit in the budget, after the two C tiles
+size_t tileSlots(size_t budgetBytes, uint32_t tile) {
+    size_t tileBytes = static_cast<size_t>(tile) * tile * sizeof(float);
+    size_t total = budgetBytes / tileBytes;
+    return (total > 2) ? total - 2 : 0;
+}
+
+// Same schedule and tile cache on the host (no overlap): checks the schedule without a GPU
+// and gives a CPU baseline
+int runCpuBackend(uint32_t n, uint32_t tile, size_t budgetBytes) {
+    std::cout << "Device   : CPU backend (" << cpuBackendThreads() << " threads" << (cpuSupportsAVX2() ? ", AVX2" : "") << ")\n"
+              << "Type     : CPU" << std::endl;
+
+    size_t slots = tileSlots(budgetBytes, tile);
+    size_t tileElements = static_cast<size_t>(tile) * tile;
+    size_t elements = static_cast<size_t>(n) * n;
+
+    PhaseTimer allocTimer("alloc");
+    std::vector<float> a(elements);
+    std::vector<float> b(elements);
+    std::vector<float> c(elements);
+    std::vector<std::vector<float>> slotBuffers(slots, std::vector<float>(tileElements));
+    std::vector<float> cTile(tileElements);
+    std::vector<float> product(tileElements);
+    allocTimer.stop();
+
+    PhaseTimer hostInitTimer("host-init");
+    initMatrix(a.data(), elements, 1);
+    initMatrix(b.data(), elements, 2);
+    hostInitTimer.stop();
+
+    std::vector<TileStep> schedule = buildSchedule(n / tile);
+    TileCache cache(slots);
+    auto upload = [&](const float *matrix, uint32_t row, uint32_t col, float *dst) {
+        for (uint32_t r = 0; r < tile; r++) {
+            memcpy(dst + static_cast<size_t>(r) * tile, matrix + (static_cast<size_t>(row) * tile + r) * n + static_cast<size_t>(col) * tile, tile * sizeof(float));
+        }
+    };
+
+    PhaseTimer kernelTimer("kernel");
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t s = 0; s < schedule.size(); s++) {
+        const TileStep &step = schedule[s];
+        bool resident;
+        long victimLastUse;
+        size_t slotA = cache.acquire(step.keyA, step.nextUseA, s, step.keyB, resident, victimLastUse);
+        if (!resident) {
+            upload(a.data(), step.i, step.k, slotBuffers[slotA].data());
+        }
+        size_t slotB = cache.acquire(step.keyB, step.nextUseB, s, step.keyA, resident, victimLastUse);
+        if (!resident) {
+            upload(b.data(), step.k, step.j, slotBuffers[slotB].data());
+        }
+        float *target = step.firstK ? cTile.data() : product.data();
+        cpuMatrixMultiply(slotBuffers[slotA].data(), slotBuffers[slotB].data(), target, tile);
+        if (!step.firstK) {
+            cpuVectorAdd(cTile.data(), product.data(), cTile.data(), tileElements);
+        }
+        if (step.lastK) {
+            for (uint32_t r = 0; r < tile; r++) {
+                memcpy(c.data() + (static_cast<size_t>(step.i) * tile + r) * n + static_cast<size_t>(step.j) * tile,
+                       cTile.data() + static_cast<size_t>(r) * tile, tile * sizeof(float));
+            }
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    kernelTimer.stop();
+
+    OutOfCoreResult result;
+    result.totalNs = std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
+    result.hits = cache.hits;
+    result.misses = cache.misses;
+    bool valid = validateSample(a.data(), b.data(), c.data(), n, 256);
+    printResult(result, n, tile, slots, valid);
+    return 0;
+}
+
+// Ordinal of a copy-only queue group (copy engine), or of the compute group if there is none
+uint32_t findQueueOrdinal(ze_device_handle_t device, bool copyOnly) {
+    uint32_t numQueueGroups = 0;
+    VALIDATECALL(zeDeviceGetCommandQueueGroupProperties(device, &numQueueGroups, nullptr));
+    std::vector<ze_command_queue_group_properties_t> queueProperties(numQueueGroups);
+    VALIDATECALL(zeDeviceGetCommandQueueGroupProperties(device, &numQueueGroups, queueProperties.data()));
+    uint32_t computeOrdinal = 0;
+    for (uint32_t i = 0; i < numQueueGroups; i++) {
+        bool compute = (queueProperties[i].flags & ZE_COMMAND_QUEUE_GROUP_PROPERTY_FLAG_COMPUTE) != 0;
+        bool copy = (queueProperties[i].flags & ZE_COMMAND_QUEUE_GROUP_PROPERTY_FLAG_COPY) != 0;
+        if (copyOnly && copy && !compute) {
+            return i;
+        }
+        if (compute) {
+            computeOrdinal = i;
+        }
+    }
+    return computeOrdinal;
+}
+
+ze_module_handle_t createModule(ze_context_handle_t context, ze_device_handle_t device, const char *fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "SPIR-V binary file not found\n";
+        std::terminate();
+    }
+    file.seekg(0, file.end);
+    auto length = file.tellg();
+    file.seekg(0, file.beg);
+
+    std::unique_ptr<char[]> spirvInput(new char[length]);
+    file.read(spirvInput.get(), length);
+    file.close();
+
+    ze_module_desc_t moduleDesc = {ZE_STRUCTURE_TYPE_MODULE_DESC};
+    ze_module_build_log_handle_t buildLog;
+    moduleDesc.format = ZE_MODULE_FORMAT_IL_SPIRV;
+    moduleDesc.pInputModule = reinterpret_cast<const uint8_t *>(spirvInput.get());
+    moduleDesc.inputSize = length;
+    moduleDesc.pBuildFlags = "";
+
+    ze_module_handle_t module;
+    auto status = zeModuleCreate(context, device, &moduleDesc, &module, &buildLog);
+    if (status != ZE_RESULT_SUCCESS) {
+        // print log
+        size_t szLog = 0;
+        zeModuleBuildLogGetString(buildLog, &szLog, nullptr);
+
+        char* stringLog = (char*)malloc(szLog);
+        zeModuleBuildLogGetString(buildLog, &szLog, stringLog);
+        std::cout << "Build log: " << stringLog << std::endl;
+    }
+    VALIDATECALL(zeModuleBuildLogDestroy(buildLog));
+    VALIDATECALL(status);
+    return module;
+}
+
+int main(int argc, char **argv) {
+
+    // ./outOfCoreMxM [n] [tile] [deviceBudgetMB]
+    uint32_t n = 8192;
+    uint32_t tile = 1024;
+    size_t budgetBytes = 0;
+    if (argc > 1) {
+        n = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        tile = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        budgetBytes = static_cast<size_t>(atol(argv[3])) * 1024 * 1024;
+    }
+    if (tile == 0 || n % tile != 0 || tile % BLOCK != 0) {
+        std::cout << "The size must be a multiple of the tile, and the tile a multiple of " << BLOCK << std::endl;
+        return -1;
+    }
+    size_t tileBytes = static_cast<size_t>(tile) * tile * sizeof(float);
+    size_t matrixBytes = static_cast<size_t>(n) * n * sizeof(float);
+    std::cout << "Matrix Size: " << n << " x " << n << " tile=" << tile
+              << " footprint(A+B+C)=" << 3 * matrixBytes * 1e-9 << " GB" << std::endl;
+
+    // Default budget: a quarter of the matrices, so the run is out of core even for small sizes
+    bool cpuBackend = useCpuBackend();
+    if (budgetBytes == 0) {
+        budgetBytes = 3 * matrixBytes / 4;
+    }
+
+    if (cpuBackend) {
+        if (tileSlots(budgetBytes, tile) < 2) {
+            std::cout << "The budget must fit at least 4 tiles (" << 4.0 * tileBytes / (1024 * 1024) << " MB)" << std::endl;
+            return -1;
+        }
+        return runCpuBackend(n, tile, budgetBytes);
+    }
+
+    PhaseTimer initTimer("init");
+    VALIDATECALL(initLevelZero());
+    uint32_t driverCount = 1;
+    ze_driver_handle_t driverHandle;
+    VALIDATECALL(zeDriverGet(&driverCount, &driverHandle));
+
+    ze_context_desc_t contextDescription = {ZE_STRUCTURE_TYPE_CONTEXT_DESC};
+    ze_context_handle_t context;
+    VALIDATECALL(zeContextCreate(driverHandle, &contextDescription, &context));
+
+    uint32_t deviceCount = 1;
+    ze_device_handle_t device;
+    VALIDATECALL(zeDeviceGet(driverHandle, &deviceCount, &device));
+
+    ze_device_properties_t deviceProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES_1_2};
+    VALIDATECALL(zeDeviceGetProperties(device, &deviceProperties));
+    DeviceTimer timer = deviceTimer(driverHandle, device);
+
+    uint32_t memoryCount = 0;
+    VALIDATECALL(zeDeviceGetMemoryProperties(device, &memoryCount, nullptr));
+    std::vector<ze_device_memory_properties_t> memoryProperties(memoryCount, {ZE_STRUCTURE_TYPE_DEVICE_MEMORY_PROPERTIES});
+    VALIDATECALL(zeDeviceGetMemoryProperties(device, &memoryCount, memoryProperties.data()));
+    uint64_t deviceMemory = 0;
+    for (auto &memory : memoryProperties) {
+        deviceMemory += memory.totalSize;
+    }
+    if (deviceMemory > 0) {
+        budgetBytes = std::min<size_t>(budgetBytes, deviceMemory / 2);
+    }
+    size_t slots = tileSlots(budgetBytes, tile);
+    std::cout << "Device   : " << deviceProperties.name << "\n"
+              << "Device memory: " << deviceMemory * 1e-9 << " GB (A+B+C = " << (deviceMemory > 0 ? 3.0 * matrixBytes / deviceMemory : 0) << "x)\n"
+              << "Working set: " << (slots + 2) * tileBytes * 1e-9 << " GB (" << slots << " A/B tile slots + 2 C tiles)" << std::endl;
+    if (slots < 2) {
+        std::cout << "The budget must fit at least 4 tiles (" << 4.0 * tileBytes / (1024 * 1024) << " MB)" << std::endl;
+        return -1;
+    }
+
+    uint32_t computeOrdinal = findQueueOrdinal(device, false);
+    uint32_t copyOrdinal = findQueueOrdinal(device, true);
+    std::cout << "Copy queue: " << (copyOrdinal != computeOrdinal ? "copy engine" : "compute engine (no copy engine)")
+              << " (ordinal " << copyOrdinal << ")" << std::endl;
+
+    ze_command_queue_desc_t cmdQueueDesc = {ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC};
+    cmdQueueDesc.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
+    cmdQueueDesc.ordinal = computeOrdinal;
+    ze_command_queue_handle_t computeQueue;
+    VALIDATECALL(zeCommandQueueCreate(context, device, &cmdQueueDesc, &computeQueue));
+    cmdQueueDesc.ordinal = copyOrdinal;
+    ze_command_queue_handle_t copyQueue;
+    VALIDATECALL(zeCommandQueueCreate(context, device, &cmdQueueDesc, &copyQueue));
+
+    ze_command_list_desc_t computeListDesc = {ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC};
+    computeListDesc.commandQueueGroupOrdinal = computeOrdinal;
+    ze_command_list_desc_t copyListDesc = {ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC};
+    copyListDesc.commandQueueGroupOrdinal = copyOrdinal;
+    ze_command_list_handle_t computeLists[RING_DEPTH];
+    ze_command_list_handle_t copyLists[RING_DEPTH];
+    for (int e = 0; e < RING_DEPTH; e++) {
+        VALIDATECALL(zeCommandListCreate(context, device, &computeListDesc, &computeLists[e]));
+        VALIDATECALL(zeCommandListCreate(context, device, &copyListDesc, &copyLists[e]));
+    }
+    ze_command_list_handle_t finalList;
+    VALIDATECALL(zeCommandListCreate(context, device, &copyListDesc, &finalList));
+
+    // kernelDone[e]: kernel of the step in ring entry e (with timestamps)
+    // copyDone[e]: uploads of the step in ring entry e. readDone[c]: copy back of C slot c
+    ze_event_pool_desc_t kernelPoolDesc = {ZE_STRUCTURE_TYPE_EVENT_POOL_DESC};
+    kernelPoolDesc.count = RING_DEPTH;
+    kernelPoolDesc.flags = ZE_EVENT_POOL_FLAG_KERNEL_TIMESTAMP | ZE_EVENT_POOL_FLAG_HOST_VISIBLE;
+    ze_event_pool_handle_t kernelPool;
+    VALIDATECALL(zeEventPoolCreate(context, &kernelPoolDesc, 1, &device, &kernelPool));
+    ze_event_pool_desc_t copyPoolDesc = {ZE_STRUCTURE_TYPE_EVENT_POOL_DESC};
+    copyPoolDesc.count = RING_DEPTH + 2;
+    copyPoolDesc.flags = ZE_EVENT_POOL_FLAG_HOST_VISIBLE;
+    ze_event_pool_handle_t copyPool;
+    VALIDATECALL(zeEventPoolCreate(context, &copyPoolDesc, 1, &device, &copyPool));
+
+    ze_event_desc_t eventDesc = {ZE_STRUCTURE_TYPE_EVENT_DESC};
+    eventDesc.signal = ZE_EVENT_SCOPE_FLAG_HOST;
+    eventDesc.wait = ZE_EVENT_SCOPE_FLAG_HOST;
+    ze_event_handle_t kernelDone[RING_DEPTH];
+    ze_event_handle_t copyDone[RING_DEPTH];
+    ze_event_handle_t readDone[2];
+    for (uint32_t e = 0; e < RING_DEPTH; e++) {
+        eventDesc.index = e;
+        VALIDATECALL(zeEventCreate(kernelPool, &eventDesc, &kernelDone[e]));
+        VALIDATECALL(zeEventCreate(copyPool, &eventDesc, &copyDone[e]));
+    }
+    for (uint32_t c = 0; c < 2; c++) {
+        eventDesc.index = RING_DEPTH + c;
+        VALIDATECALL(zeEventCreate(copyPool, &eventDesc, &readDone[c]));
+    }
+    initTimer.stop();
+
+    // Host matrices in host USM (pinned, so the copy engine reads them directly), and the
+    // device working set
+    PhaseTimer allocTimer("alloc");
+    ze_relaxed_allocation_limits_exp_desc_t exceedCapacity = {
+        ZE_STRUCTURE_TYPE_RELAXED_ALLOCATION_LIMITS_EXP_DESC,
+        nullptr,
+        ZE_RELAXED_ALLOCATION_LIMITS_EXP_FLAG_MAX_SIZE
+    };
+    ze_host_mem_alloc_desc_t hostDesc = {ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC};
+    hostDesc.pNext = &exceedCapacity;
+    void *hostA = nullptr;
+    void *hostB = nullptr;
+    void *hostC = nullptr;
+    VALIDATECALL(zeMemAllocHost(context, &hostDesc, matrixBytes, 64, &hostA));
+    VALIDATECALL(zeMemAllocHost(context, &hostDesc, matrixBytes, 64, &hostB));
+    VALIDATECALL(zeMemAllocHost(context, &hostDesc, matrixBytes, 64, &hostC));
+
+    ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
+    std::vector<void *> tileBuffers(slots);
+    for (auto &buffer : tileBuffers) {
+        VALIDATECALL(zeMemAllocDevice(context, &memAllocDesc, tileBytes, 64, device, &buffer));
+    }
+    void *cBuffers[2];
+    for (auto &buffer : cBuffers) {
+        VALIDATECALL(zeMemAllocDevice(context, &memAllocDesc, tileBytes, 64, device, &buffer));
+    }
+    allocTimer.stop();
+
+    PhaseTimer hostInitTimer("host-init");
+    float *a = static_cast<float *>(hostA);
+    float *b = static_cast<float *>(hostB);
+    float *c = static_cast<float *>(hostC);
+    initMatrix(a, static_cast<size_t>(n) * n, 1);
+    initMatrix(b, static_cast<size_t>(n) * n, 2);
+    hostInitTimer.stop();
+
+    ze_module_handle_t module = createModule(context, device, "outOfCoreMxM.spv");
+    ze_kernel_desc_t kernelDesc = {ZE_STRUCTURE_TYPE_KERNEL_DESC};
+    kernelDesc.pKernelName = "mxmTile";
+    ze_kernel_handle_t kernel;
+    VALIDATECALL(zeKernelCreate(module, &kernelDesc, &kernel));
+    VALIDATECALL(zeKernelSetGroupSize(kernel, BLOCK, BLOCK, 1));
+    ze_group_count_t dispatch = {tile / BLOCK, tile / BLOCK, 1};
+
+    // Tile (row, col) of a host matrix <-> contiguous tile x tile buffer
+    uint32_t rowPitch = n * sizeof(float);
+    uint32_t tilePitch = tile * sizeof(float);
+    auto hostRegion = [&](uint32_t row, uint32_t col) {
+        ze_copy_region_t region = {col * tilePitch, row * tile, 0, tilePitch, tile, 1};
+        return region;
+    };
+    ze_copy_region_t tileRegion = {0, 0, 0, tilePitch, tile, 1};
+
+    std::vector<TileStep> schedule = buildSchedule(n / tile);
+    TileCache cache(slots);
+    OutOfCoreResult result;
+
+    // completedStep: all kernels up to this step are done (kernels run in order)
+    long completedStep = -1;
+    auto waitStep = [&](long step) {
+        if (step > completedStep) {
+            VALIDATECALL(zeEventHostSynchronize(kernelDone[step % RING_DEPTH], std::numeric_limits<uint64_t>::max()));
+            completedStep = step;
+        }
+    };
+    // Copy back of each C slot: recorded in the copy list of the step after the last kernel
+    // of the C tile, and waits on that kernel
+    struct Readback {
+        bool pending;
+        long recordedAt;
+    };
+    Readback readbacks[2] = {{false, 0}, {false, 0}};
+    auto waitReadback = [&](int slot) {
+        if (readbacks[slot].pending) {
+            VALIDATECALL(zeEventHostSynchronize(readDone[slot], std::numeric_limits<uint64_t>::max()));
+            VALIDATECALL(zeEventHostReset(readDone[slot]));
+            readbacks[slot].pending = false;
+        }
+    };
+    auto appendReadback = [&](ze_command_list_handle_t cmdList, const TileStep &last, long lastStep, int slot, long step) {
+        ze_copy_region_t dstRegion = hostRegion(last.i, last.j);
+        ze_event_handle_t waitEvent = kernelDone[lastStep % RING_DEPTH];
+        VALIDATECALL(zeCommandListAppendMemoryCopyRegion(cmdList, hostC, &dstRegion, rowPitch, 0, cBuffers[slot], &tileRegion, tilePitch, 0,
+                                                         readDone[slot], 1, &waitEvent));
+        readbacks[slot] = {true, step};
+    };
+    auto collectKernelTime = [&](long step) {
+        ze_kernel_timestamp_result_t timestamp;
+        VALIDATECALL(zeEventQueryKernelTimestamp(kernelDone[step % RING_DEPTH], &timestamp));
+        result.kernelNs.push_back(kernelTimestampNs(timer, timestamp));
+    };
+
+    PhaseTimer kernelTimer("kernel");
+    auto begin = std::chrono::steady_clock::now();
+    long lastStepOfTile = -1;
+    int cSlot = 0;
+    bool readbackToRecord = false;
+    for (long s = 0; s < static_cast<long>(schedule.size()); s++) {
+        const TileStep &step = schedule[s];
+        int e = s % RING_DEPTH;
+
+        // Reuse the ring entry of step s - RING_DEPTH: wait for the step after it, because that
+        // kernel waits on its event, and for the copy back recorded then, which waits on it too
+        if (s >= RING_DEPTH) {
+            waitStep(s - RING_DEPTH + 1);
+            for (int slot = 0; slot < 2; slot++) {
+                if (readbacks[slot].pending && readbacks[slot].recordedAt <= s - RING_DEPTH + 1) {
+                    waitReadback(slot);
+                }
+            }
+            collectKernelTime(s - RING_DEPTH);
+            VALIDATECALL(zeEventHostReset(kernelDone[e]));
+            VALIDATECALL(zeEventHostReset(copyDone[e]));
+            VALIDATECALL(zeCommandListReset(copyLists[e]));
+            VALIDATECALL(zeCommandListReset(computeLists[e]));
+        }
+        if (step.firstK) {
+            // The copy back of the C tile that used this slot before must be done
+            waitReadback(cSlot);
+        }
+
+        // Uploads of the missing tiles. A victim slot is only overwritten once the last
+        // kernel that read it is done.
+        bool uploads = false;
+        bool resident;
+        long victimLastUse = -1;
+        void *tileA;
+        void *tileB;
+        {
+            size_t slot = cache.acquire(step.keyA, step.nextUseA, s, step.keyB, resident, victimLastUse);
+            if (!resident) {
+                waitStep(victimLastUse);
+                ze_copy_region_t srcRegion = hostRegion(step.i, step.k);
+                VALIDATECALL(zeCommandListAppendMemoryCopyRegion(copyLists[e], tileBuffers[slot], &tileRegion, tilePitch, 0, hostA, &srcRegion, rowPitch, 0, nullptr, 0, nullptr));
+                uploads = true;
+            }
+            tileA = tileBuffers[slot];
+        }
+        {
+            size_t slot = cache.acquire(step.keyB, step.nextUseB, s, step.keyA, resident, victimLastUse);
+            if (!resident) {
+                waitStep(victimLastUse);
+                ze_copy_region_t srcRegion = hostRegion(step.k, step.j);
+                VALIDATECALL(zeCommandListAppendMemoryCopyRegion(copyLists[e], tileBuffers[slot], &tileRegion, tilePitch, 0, hostB, &srcRegion, rowPitch, 0, nullptr, 0, nullptr));
+                uploads = true;
+            }
+            tileB = tileBuffers[slot];
+        }
+        if (uploads) {
+            VALIDATECALL(zeCommandListAppendSignalEvent(copyLists[e], copyDone[e]));
+        }
+        // After the uploads, so the kernel does not wait for it
+        bool readback = readbackToRecord;
+        if (readbackToRecord) {
+            appendReadback(copyLists[e], schedule[lastStepOfTile], lastStepOfTile, 1 - cSlot, s);
+            readbackToRecord = false;
+        }
+        if (uploads || readback) {
+            VALIDATECALL(zeCommandListClose(copyLists[e]));
+            VALIDATECALL(zeCommandQueueExecuteCommandLists(copyQueue, 1, &copyLists[e], nullptr));
+        }
+
+        // Kernel: after its uploads, and after the previous kernel (same C tile)
+        int accumulate = step.firstK ? 0 : 1;
+        VALIDATECALL(zeKernelSetArgumentValue(kernel, 0, sizeof(tileA), &tileA));
+        VALIDATECALL(zeKernelSetArgumentValue(kernel, 1, sizeof(tileB), &tileB));
+        VALIDATECALL(zeKernelSetArgumentValue(kernel, 2, sizeof(cBuffers[cSlot]), &cBuffers[cSlot]));
+        VALIDATECALL(zeKernelSetArgumentValue(kernel, 3, sizeof(int), &tile));
+        VALIDATECALL(zeKernelSetArgumentValue(kernel, 4, sizeof(int), &accumulate));
+        std::vector<ze_event_handle_t> waitEvents;
+        if (uploads) {
+            waitEvents.push_back(copyDone[e]);
+        }
+        if (s > 0) {
+            waitEvents.push_back(kernelDone[(s - 1) % RING_DEPTH]);
+        }
+        VALIDATECALL(zeCommandListAppendLaunchKernel(computeLists[e], kernel, &dispatch, kernelDone[e], waitEvents.size(), waitEvents.data()));
+        VALIDATECALL(zeCommandListClose(computeLists[e]));
+        VALIDATECALL(zeCommandQueueExecuteCommandLists(computeQueue, 1, &computeLists[e], nullptr));
+
+        if (step.lastK) {
+            lastStepOfTile = s;
+            readbackToRecord = true;
+            cSlot = 1 - cSlot;
+        }
+    }
+    // Copy back of the last C tile
+    appendReadback(finalList, schedule[lastStepOfTile], lastStepOfTile, 1 - cSlot, schedule.size());
+    VALIDATECALL(zeCommandListClose(finalList));
+    VALIDATECALL(zeCommandQueueExecuteCommandLists(copyQueue, 1, &finalList, nullptr));
+    VALIDATECALL(zeCommandQueueSynchronize(computeQueue, std::numeric_limits<uint64_t>::max()));
+    VALIDATECALL(zeCommandQueueSynchronize(copyQueue, std::numeric_limits<uint64_t>::max()));
+    auto end = std::chrono::steady_clock::now();
+    kernelTimer.stop();
+
+    for (long s = std::max<long>(0, schedule.size() - RING_DEPTH); s < static_cast<long>(schedule.size()); s++) {
+        collectKernelTime(s);
+    }
+    result.totalNs = std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
+    result.hits = cache.hits;
+    result.misses = cache.misses;
+    bool valid = validateSample(a, b, c, n, 256);
+    printResult(result, n, tile, slots, valid);
+
+    // Cleanup
+    PHASE_TIMER("cleanup");
+    VALIDATECALL(zeKernelDestroy(kernel));
+    VALIDATECALL(zeModuleDestroy(module));
+    for (auto buffer : tileBuffers) {
+        VALIDATECALL(zeMemFree(context, buffer));
+    }
+    for (auto buffer : cBuffers) {
+        VALIDATECALL(zeMemFree(context, buffer));
+    }
+    VALIDATECALL(zeMemFree(context, hostA));
+    VALIDATECALL(zeMemFree(context, hostB));
+    VALIDATECALL(zeMemFree(context, hostC));
+    for (int e = 0; e < RING_DEPTH; e++) {
+        VALIDATECALL(zeEventDestroy(kernelDone[e]));
+        VALIDATECALL(zeEventDestroy(copyDone[e]));
+        VALIDATECALL(zeCommandListDestroy(computeLists[e]));
+        VALIDATECALL(zeCommandListDestroy(copyLists[e]));
+    }
+    for (auto event : readDone) {
+        VALIDATECALL(zeEventDestroy(event));
+    }
+    VALIDATECALL(zeCommandListDestroy(finalList));
+    VALIDATECALL(zeEventPoolDestroy(kernelPool));
+    VALIDATECALL(zeEventPoolDestroy(copyPool));
+    VALIDATECALL(zeCommandQueueDestroy(copyQueue));
+    VALIDATECALL(zeCommandQueueDestroy(computeQueue));
+    VALIDATECALL(zeContextDestroy(context));
+    return 0;
+}
@@ -0,0 +1,5 @@
+# Setup LEVEL_ZERO_ROOT to the level zero directory
+
+export CPLUS_INCLUDE_PATH=$LEVEL_ZERO_ROOT/include:$CPLUS_INCLUDE_PATH
+export LD_LIBRARY_PATH=$LEVEL_ZERO_ROOT/build/lib:$LD_LIBRARY_PATH 
+
@@ -27,6 +27,8 @@
 //      https://github.com/intel/compute-runtime/blob/master/level_zero/core/test/black_box_tests/zello_timestamp.cpp
 
 #include <ze_api.h>
+#include "cpuBackend.hpp"
+#include "phaseTimer.hpp"
 
 #include <chrono>
 #include <cstring>
@@ -52,6 +54,38 @@
         std::terminate(); \
     }
 
+// Vector addition on the CPU backend (multi-threaded + SIMD)
+int runCpuBackend(uint64_t vectorSize) {
+
+    std::cout << "Device   : CPU backend (" << cpuBackendThreads() << " threads" << (cpuSupportsAVX2() ? ", AVX2" : "") << ")\n"
+              << "Type     : CPU" << std::endl;
+
+    PhaseTimer allocTimer("alloc");
+    std::vector<float> srcA(vectorSize, 2.5f);
+    std::vector<float> srcB(vectorSize, 3.2f);
+    std::vector<float> dstFloat(vectorSize, 0.0f);
+    allocTimer.stop();
+
+    PhaseTimer kernelTimer("kernel");
+    auto begin = std::chrono::steady_clock::now();
+    cpuVectorAdd(srcA.data(), srcB.data(), dstFloat.data(), vectorSize);
+    auto end = std::chrono::steady_clock::now();
+    kernelTimer.stop();
+    std::cout << "CPU Kernel = " << std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count() << " [ns]" << std::endl;
+
+    if (VALIDATION) {
+        PHASE_TIMER("validation");
+        bool outputValidationSuccessful = true;
+        for (uint64_t i = 0; i < vectorSize; i++) {
+            if (std::abs((srcA[i] + srcB[i]) - dstFloat[i]) > 0.01 ) {
+                outputValidationSuccessful = false;
+                break;
+            }
+        }
+        std::cout << "\nVector Addition validation " << (outputValidationSuccessful ? "PASSED" : "FAILED") << "\n";
+    }
+    return 0;
+}
 
 int main(int argc, char **argv) {
 
@@ -62,8 +96,14 @@ int main(int argc, char **argv) {
 
     std::cout << "Vector Size: " << vectorSize << " ---> #bytes: " << (vectorSize * 4) << " -- " << ((vectorSize * 4) * 1e-9 ) << " (GB) " << std::endl;
 
+    if (useCpuBackend()) {
+        // No Level Zero GPU available (or CPU_BACKEND=1)
+        return runCpuBackend(vectorSize);
+    }
+
     // Initialization
-    VALIDATECALL(zeInit(ZE_INIT_FLAG_GPU_ONLY));
+    PhaseTimer initTimer("init");
+    VALIDATECALL(initLevelZero());
 
     // Get the driver
     uint32_t driverCount = 0;
@@ -127,6 +167,7 @@ int main(int argc, char **argv) {
     ze_command_list_desc_t cmdListDesc = {};
     cmdListDesc.commandQueueGroupOrdinal = cmdQueueDesc.ordinal;    
     VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &cmdList));
+    initTimer.stop();
 
     // Create two buffers
     uint32_t items = vectorSize;
@@ -151,6 +192,7 @@ int main(int argc, char **argv) {
     hostDesc.pNext = &exceedCapacity;
     memAllocDesc.pNext = &exceedCapacity;
 
+    PhaseTimer allocTimer("alloc");
     void *sharedA = nullptr;
     VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 1, device, &sharedA));
 
@@ -160,15 +202,19 @@ int main(int argc, char **argv) {
     void *dstResult = nullptr;
     VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 1, device, &dstResult));
 
+    allocTimer.stop();
     std::cout << "[INFO] Allocation done" << std::endl; 
 
 
     // memory initialization
+    PhaseTimer hostInitTimer("host-init");
     memset(sharedA, 2.5, allocSize);
     memset(sharedB, 3.2, allocSize);
     memset(dstResult, 0.0, allocSize);
+    hostInitTimer.stop();
 
     // Module Initialization
+    PhaseTimer moduleTimer("module");
     ze_module_handle_t module = nullptr;
     ze_kernel_handle_t kernel = nullptr;
 
@@ -230,14 +276,17 @@ int main(int argc, char **argv) {
 
        
         file.close();
+        moduleTimer.stop();
     } else {
         std::cout << "SPIR-V binary file not found\n";
         std::terminate();
     }
 
+    PhaseTimer kernelTimer("kernel");
     VALIDATECALL(zeCommandListClose(cmdList));
     VALIDATECALL(zeCommandQueueExecuteCommandLists(cmdQueue, 1, &cmdList, nullptr));    
     VALIDATECALL(zeCommandQueueSynchronize(cmdQueue, std::numeric_limits<uint64_t>::max()));
+    kernelTimer.stop();
 
     // Validate
     bool outputValidationSuccessful = true;
@@ -249,6 +298,7 @@ int main(int argc, char **argv) {
 
 
     if (VALIDATION) {
+        PHASE_TIMER("validation");
         int n = items;
         for (int i = 0; i < n; i++) {
             if (std::abs((srcA[i] + srcB[i]) - dstFloat[i]) > 0.01 ) {
@@ -260,6 +310,7 @@ int main(int argc, char **argv) {
     }
  
     // Cleanup
+    PHASE_TIMER("cleanup");
     VALIDATECALL(zeMemFree(context, dstResult));
     VALIDATECALL(zeMemFree(context, sharedA));
     VALIDATECALL(zeMemFree(context, sharedB));
@@ -0,0 +1,100 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Summary statistics for repeated measurements: min, mean, median, tail percentiles (p90, p99),
+// max and standard deviation.
+
+#ifndef BENCH_STATS_HPP
+#define BENCH_STATS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct BenchStats {
+    size_t count;
+    double min;
+    double max;
+    double mean;
+    double stddev;
+    double median;
+    double p90;
+    double p99;
+};
+
+// Percentile with linear interpolation between the closest ranks. Samples must be sorted.
+inline double percentile(const std::vector<double> &sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    double rank = (p / 100.0) * (sorted.size() - 1);
+    size_t lower = static_cast<size_t>(std::floor(rank));
+    size_t upper = std::min(lower + 1, sorted.size() - 1);
+    double fraction = rank - lower;
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * fraction;
+}
+
+inline BenchStats computeStats(std::vector<double> samples) {
+    BenchStats stats = {};
+    stats.count = samples.size();
+    if (samples.empty()) {
+        return stats;
+    }
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (auto s : samples) {
+        sum += s;
+    }
+    stats.mean = sum / samples.size();
+    double squares = 0;
+    for (auto s : samples) {
+        squares += (s - stats.mean) * (s - stats.mean);
+    }
+    stats.stddev = (samples.size() > 1) ? std::sqrt(squares / (samples.size() - 1)) : 0;
+    stats.min = samples.front();
+    stats.max = samples.back();
+    stats.median = percentile(samples, 50);
+    stats.p90 = percentile(samples, 90);
+    stats.p99 = percentile(samples, 99);
+    return stats;
+}
+
+// Print the statistics in one line, so it can be easily filtered with grep/awk:
+//  <label>: n=<count> min=<> mean=<> median=<> p90=<> p99=<> max=<> stddev=<> [unit]
+inline void printStats(const std::string &label, const BenchStats &stats, const std::string &unit = "ns") {
+    std::cout << label << ": "
+              << "n=" << stats.count
+              << " min=" << stats.min
+              << " mean=" << stats.mean
+              << " median=" << stats.median
+              << " p90=" << stats.p90
+              << " p99=" << stats.p99
+              << " max=" << stats.max
+              << " stddev=" << stats.stddev
+              << " [" << unit << "]" << std::endl;
+}
+
+#endif
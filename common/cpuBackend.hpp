@@ -0,0 +1,649 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Multi-threaded CPU backend for the workloads of the examples (matrix multiplication, 
+// vector addition and memory copies). It is used when there is no Level Zero GPU driver 
+// available (or when CPU_BACKEND=1 is set), so the benchmarks can run on any machine and 
+// provide a CPU throughput baseline. 
+// 
+// Work is split across std::threads. The inner loops use AVX2/FMA when the CPU supports it
+// (detected at runtime), with a scalar fallback otherwise.
+
+#ifndef CPU_BACKEND_HPP
+#define CPU_BACKEND_HPP
+
+#include <ze_api.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CPU_BACKEND_X86 1
+#endif
+
+// Number of threads for the CPU backend: CPU_BACKEND_THREADS or all hardware threads
+inline unsigned cpuBackendThreads() {
+    const char *env = std::getenv("CPU_BACKEND_THREADS");
+    if (env != nullptr && std::atoi(env) > 0) {
+        return std::atoi(env);
+    }
+    unsigned threads = std::thread::hardware_concurrency();
+    return (threads == 0) ? 1 : threads;
+}
+
+// zeInit is called once per process, the backend selection and the GPU paths share the result
+inline ze_result_t initLevelZero() {
+    static ze_result_t result = zeInit(ZE_INIT_FLAG_GPU_ONLY);
+    return result;
+}
+
+// True if there is no Level Zero GPU driver, or if the CPU backend is forced with CPU_BACKEND=1.
+// Programs built with zeLazyLoader.cpp also start when the Level Zero loader is not installed.
+inline bool useCpuBackend() {
+    const char *env = std::getenv("CPU_BACKEND");
+    if (env != nullptr && std::string(env) == "1") {
+        return true;
+    }
+    if (initLevelZero() != ZE_RESULT_SUCCESS) {
+        return true;
+    }
+    uint32_t driverCount = 0;
+    return (zeDriverGet(&driverCount, nullptr) != ZE_RESULT_SUCCESS) || (driverCount == 0);
+}
+
+inline bool cpuSupportsAVX2() {
+#ifdef CPU_BACKEND_X86
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+    return false;
+#endif
+}
+
+// Split [begin, end) in contiguous chunks, one per thread, and run f(chunkBegin, chunkEnd) on each
+template <typename F>
+void parallelFor(size_t begin, size_t end, F f, unsigned numThreads = cpuBackendThreads()) {
+    size_t total = end - begin;
+    numThreads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(numThreads, total)));
+    if (numThreads == 1) {
+        f(begin, end);
+        return;
+    }
+    std::vector<std::thread> threads;
+    size_t chunk = (total + numThreads - 1) / numThreads;
+    for (unsigned t = 0; t < numThreads; t++) {
+        size_t chunkBegin = begin + t * chunk;
+        size_t chunkEnd = std::min(end, chunkBegin + chunk);
+        if (chunkBegin >= chunkEnd) {
+            break;
+        }
+        threads.emplace_back(f, chunkBegin, chunkEnd);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------
+// Matrix Multiplication: C = A x B (n x n, row major). 
+// Each thread computes a band of rows of C. The loop order is i-k-j, so the inner loop 
+// streams through one row of B and one row of C, and it is blocked in columns to keep the
+// row segment of C in cache. The row kernels take leading dimensions (lda, ldb, ldc), so they
+// also work on sub-matrices (quadrants of the Strassen-Winograd recursion).
+// ---------------------------------------------------------------------------------------------
+constexpr size_t CPU_MXM_BLOCK_J = 512;
+
+inline void mxmRowsScalar(const float *a, size_t lda, const float *b, size_t ldb, float *c, size_t ldc, 
+                          size_t n, size_t rowBegin, size_t rowEnd) {
+    for (size_t i = rowBegin; i < rowEnd; i++) {
+        float *ci = c + i * ldc;
+        std::fill(ci, ci + n, 0.0f);
+        for (size_t jj = 0; jj < n; jj += CPU_MXM_BLOCK_J) {
+            size_t jEnd = std::min(n, jj + CPU_MXM_BLOCK_J);
+            for (size_t k = 0; k < n; k++) {
+                float aik = a[i * lda + k];
+                const float *bk = b + k * ldb;
+                for (size_t j = jj; j < jEnd; j++) {
+                    ci[j] += aik * bk[j];
+                }
+            }
+        }
+    }
+}
+
+inline void mxmRowsScalar(const float *a, const float *b, float *c, size_t n, size_t rowBegin, size_t rowEnd) {
+    mxmRowsScalar(a, n, b, n, c, n, n, rowBegin, rowEnd);
+}
+
+#ifdef CPU_BACKEND_X86
+__attribute__((target("avx2,fma")))
+inline void mxmRowsAVX2(const float *a, size_t lda, const float *b, size_t ldb, float *c, size_t ldc, 
+                        size_t n, size_t rowBegin, size_t rowEnd) {
+    for (size_t i = rowBegin; i < rowEnd; i++) {
+        float *ci = c + i * ldc;
+        std::fill(ci, ci + n, 0.0f);
+        for (size_t jj = 0; jj < n; jj += CPU_MXM_BLOCK_J) {
+            size_t jEnd = std::min(n, jj + CPU_MXM_BLOCK_J);
+            for (size_t k = 0; k < n; k++) {
+                float aik = a[i * lda + k];
+                __m256 aikVector = _mm256_set1_ps(aik);
+                const float *bk = b + k * ldb;
+                size_t j = jj;
+                for (; j + 8 <= jEnd; j += 8) {
+                    __m256 cVector = _mm256_loadu_ps(ci + j);
+                    cVector = _mm256_fmadd_ps(aikVector, _mm256_loadu_ps(bk + j), cVector);
+                    _mm256_storeu_ps(ci + j, cVector);
+                }
+                for (; j < jEnd; j++) {
+                    ci[j] += aik * bk[j];
+                }
+            }
+        }
+    }
+}
+
+inline void mxmRowsAVX2(const float *a, const float *b, float *c, size_t n, size_t rowBegin, size_t rowEnd) {
+    mxmRowsAVX2(a, n, b, n, c, n, n, rowBegin, rowEnd);
+}
+#endif
+
+inline void cpuMatrixMultiply(const float *a, size_t lda, const float *b, size_t ldb, float *c, size_t ldc, size_t n) {
+    bool avx2 = cpuSupportsAVX2();
+    parallelFor(0, n, [=](size_t rowBegin, size_t rowEnd) {
+#ifdef CPU_BACKEND_X86
+        if (avx2) {
+            mxmRowsAVX2(a, lda, b, ldb, c, ldc, n, rowBegin, rowEnd);
+            return;
+        }
+#endif
+        mxmRowsScalar(a, lda, b, ldb, c, ldc, n, rowBegin, rowEnd);
+    });
+}
+
+inline void cpuMatrixMultiply(const float *a, const float *b, float *c, size_t n) {
+    cpuMatrixMultiply(a, n, b, n, c, n, n);
+}
+
+// ---------------------------------------------------------------------------------------------
+// Strassen-Winograd Matrix Multiplication: C = A x B (n x n, row major), 7 multiplications of
+// n/2 x n/2 quadrants and 15 additions per level instead of 8 multiplications, O(n^2.81).
+// The recursion stops at the crossover size (or at an odd size), and the quadrants are then
+// multiplied with the blocked kernel above. Each level uses two temporaries of n/2 x n/2
+// (schedule of Boyer, Dumas, Pernet and Zhou, 2009), the products are written into the
+// quadrants of C.
+//  - STRASSEN_CROSSOVER: size of the blocked leaves (default 512)
+//  - STRASSEN_MIN_SIZE: smallest size of the references computed with Strassen-Winograd
+//    (default 4096, 0 disables it)
+// The result is not as accurate as the conventional product: there is only a normwise bound
+// (see strassenErrorBound), the error of small elements of C is not bounded by their size.
+// ---------------------------------------------------------------------------------------------
+inline size_t strassenCrossover() {
+    const char *env = std::getenv("STRASSEN_CROSSOVER");
+    if (env != nullptr && std::atoi(env) > 0) {
+        return std::atoi(env);
+    }
+    return 512;
+}
+
+// Square references of power-of-two size from STRASSEN_MIN_SIZE
+inline bool useStrassenReference(size_t n) {
+    size_t minSize = 4096;
+    const char *env = std::getenv("STRASSEN_MIN_SIZE");
+    if (env != nullptr) {
+        minSize = std::atoi(env);
+    }
+    bool powerOfTwo = (n & (n - 1)) == 0;
+    return minSize > 0 && n >= minSize && powerOfTwo && n > strassenCrossover();
+}
+
+// z = x + sign * y (n x n)
+inline void matrixAddStrided(const float *x, size_t ldx, const float *y, size_t ldy, float *z, size_t ldz, 
+                             size_t n, float sign) {
+    parallelFor(0, n, [=](size_t rowBegin, size_t rowEnd) {
+        for (size_t i = rowBegin; i < rowEnd; i++) {
+            const float *xi = x + i * ldx;
+            const float *yi = y + i * ldy;
+            float *zi = z + i * ldz;
+            for (size_t j = 0; j < n; j++) {
+                zi[j] = xi[j] + sign * yi[j];
+            }
+        }
+    });
+}
+
+inline void strassenWinograd(const float *a, size_t lda, const float *b, size_t ldb, float *c, size_t ldc, 
+                             size_t n, size_t crossover) {
+    if (n <= crossover || (n % 2) != 0) {
+        cpuMatrixMultiply(a, lda, b, ldb, c, ldc, n);
+        return;
+    }
+    size_t h = n / 2;
+    const float *a11 = a;
+    const float *a12 = a + h;
+    const float *a21 = a + h * lda;
+    const float *a22 = a + h * lda + h;
+    const float *b11 = b;
+    const float *b12 = b + h;
+    const float *b21 = b + h * ldb;
+    const float *b22 = b + h * ldb + h;
+    float *c11 = c;
+    float *c12 = c + h;
+    float *c21 = c + h * ldc;
+    float *c22 = c + h * ldc + h;
+    std::vector<float> xBuffer(h * h);
+    std::vector<float> yBuffer(h * h);
+    float *x = xBuffer.data();
+    float *y = yBuffer.data();
+
+    matrixAddStrided(a11, lda, a21, lda, x, h, h, -1.0f);      // S3 = A11 - A21
+    matrixAddStrided(b22, ldb, b12, ldb, y, h, h, -1.0f);      // T3 = B22 - B12
+    strassenWinograd(x, h, y, h, c21, ldc, h, crossover);      // P7 = S3 x T3
+    matrixAddStrided(a21, lda, a22, lda, x, h, h, 1.0f);       // S1 = A21 + A22
+    matrixAddStrided(b12, ldb, b11, ldb, y, h, h, -1.0f);      // T1 = B12 - B11
+    strassenWinograd(x, h, y, h, c22, ldc, h, crossover);      // P5 = S1 x T1
+    matrixAddStrided(x, h, a11, lda, x, h, h, -1.0f);          // S2 = S1 - A11
+    matrixAddStrided(b22, ldb, y, h, y, h, h, -1.0f);          // T2 = B22 - T1
+    strassenWinograd(x, h, y, h, c12, ldc, h, crossover);      // P6 = S2 x T2
+    matrixAddStrided(a12, lda, x, h, x, h, h, -1.0f);          // S4 = A12 - S2
+    strassenWinograd(x, h, b22, ldb, c11, ldc, h, crossover);  // P3 = S4 x B22
+    strassenWinograd(a11, lda, b11, ldb, x, h, h, crossover);  // P1 = A11 x B11
+    matrixAddStrided(x, h, c12, ldc, c12, ldc, h, 1.0f);       // U2 = P1 + P6
+    matrixAddStrided(c12, ldc, c21, ldc, c21, ldc, h, 1.0f);   // U3 = U2 + P7
+    matrixAddStrided(c12, ldc, c22, ldc, c12, ldc, h, 1.0f);   // U4 = U2 + P5
+    matrixAddStrided(c21, ldc, c22, ldc, c22, ldc, h, 1.0f);   // C22 = U3 + P5
+    matrixAddStrided(c12, ldc, c11, ldc, c12, ldc, h, 1.0f);   // C12 = U4 + P3
+    matrixAddStrided(y, h, b21, ldb, y, h, h, -1.0f);          // T4 = T2 - B21
+    strassenWinograd(a22, lda, y, h, c11, ldc, h, crossover);  // P4 = A22 x T4
+    matrixAddStrided(c21, ldc, c11, ldc, c21, ldc, h, -1.0f);  // C21 = U3 - P4
+    strassenWinograd(a12, lda, b21, ldb, c11, ldc, h, crossover); // P2 = A12 x B21
+    matrixAddStrided(x, h, c11, ldc, c11, ldc, h, 1.0f);       // C11 = P1 + P2
+}
+
+inline void cpuMatrixMultiplyStrassen(const float *a, const float *b, float *c, size_t n, 
+                                      size_t crossover = strassenCrossover()) {
+    strassenWinograd(a, n, b, n, c, n, n, crossover);
+}
+
+// Normwise error bound of the float Strassen-Winograd product (Higham, Accuracy and Stability
+// of Numerical Algorithms, 2nd ed., chapter 23):
+//   max|C - C'| <= [(n/n0)^log2(18) * (n0^2 + 6 n0) - 6n] * u * max|A| * max|B|
+// with n0 the size of the leaves and u the unit roundoff. With no recursion (n0 = n) the
+// bound is the one of the conventional product, n^2 * u * max|A| * max|B|.
+inline double strassenErrorBound(const float *a, const float *b, size_t n, size_t crossover = strassenCrossover()) {
+    size_t n0 = n;
+    double levels = 0;
+    while (n0 > crossover && (n0 % 2) == 0) {
+        n0 /= 2;
+        levels++;
+    }
+    double factor = std::pow(18.0, levels) * (static_cast<double>(n0) * n0 + 6.0 * n0) - 6.0 * n;
+    double maxA = 0;
+    double maxB = 0;
+    for (size_t i = 0; i < n * n; i++) {
+        maxA = std::max(maxA, static_cast<double>(std::abs(a[i])));
+        maxB = std::max(maxB, static_cast<double>(std::abs(b[i])));
+    }
+    const double unitRoundoff = std::ldexp(1.0, -24);
+    return factor * unitRoundoff * maxA * maxB;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Transposed and packed B. The i-j-k product reads B with stride n in the inner loop (one 
+// cache line per element). B can be rearranged once instead:
+//  - transposed: bT[j * n + k] = b[k * n + j], each dot product reads two contiguous rows
+//  - packed: panels of CPU_PACK_WIDTH columns, packed[(j / W) * n * W + k * W + j % W], so the
+//    W columns of a panel are contiguous for each k and the whole panel is contiguous
+// The transpose is cache-oblivious: the larger dimension is split in halves until the blocks
+// are CPU_TRANSPOSE_LEAF x CPU_TRANSPOSE_LEAF, so both the reads and the writes stay in cache
+// at every level without tuning for the cache sizes. Each thread takes a band of rows.
+// ---------------------------------------------------------------------------------------------
+constexpr size_t CPU_TRANSPOSE_LEAF = 32;
+constexpr size_t CPU_PACK_WIDTH = 16;
+
+inline void transposeRecursive(const float *src, size_t ldSrc, float *dst, size_t ldDst, 
+                               size_t rowBegin, size_t rowEnd, size_t colBegin, size_t colEnd) {
+    size_t rows = rowEnd - rowBegin;
+    size_t cols = colEnd - colBegin;
+    if (rows <= CPU_TRANSPOSE_LEAF && cols <= CPU_TRANSPOSE_LEAF) {
+        for (size_t i = rowBegin; i < rowEnd; i++) {
+            for (size_t j = colBegin; j < colEnd; j++) {
+                dst[j * ldDst + i] = src[i * ldSrc + j];
+            }
+        }
+    } else if (rows >= cols) {
+        size_t rowMiddle = rowBegin + rows / 2;
+        transposeRecursive(src, ldSrc, dst, ldDst, rowBegin, rowMiddle, colBegin, colEnd);
+        transposeRecursive(src, ldSrc, dst, ldDst, rowMiddle, rowEnd, colBegin, colEnd);
+    } else {
+        size_t colMiddle = colBegin + cols / 2;
+        transposeRecursive(src, ldSrc, dst, ldDst, rowBegin, rowEnd, colBegin, colMiddle);
+        transposeRecursive(src, ldSrc, dst, ldDst, rowBegin, rowEnd, colMiddle, colEnd);
+    }
+}
+
+// dst (cols x rows) = transpose of src (rows x cols)
+inline void cpuTranspose(const float *src, float *dst, size_t rows, size_t cols) {
+    parallelFor(0, rows, [=](size_t rowBegin, size_t rowEnd) {
+        transposeRecursive(src, cols, dst, rows, rowBegin, rowEnd, 0, cols);
+    });
+}
+
+// n must be a multiple of CPU_PACK_WIDTH. Each thread packs whole panels.
+inline void cpuPackB(const float *b, float *packed, size_t n) {
+    parallelFor(0, n / CPU_PACK_WIDTH, [=](size_t panelBegin, size_t panelEnd) {
+        for (size_t panel = panelBegin; panel < panelEnd; panel++) {
+            float *dst = packed + panel * n * CPU_PACK_WIDTH;
+            for (size_t k = 0; k < n; k++) {
+                memcpy(dst + k * CPU_PACK_WIDTH, b + k * n + panel * CPU_PACK_WIDTH, CPU_PACK_WIDTH * sizeof(float));
+            }
+        }
+    });
+}
+
+inline void mxmPackedRowsScalar(const float *a, const float *packed, float *c, size_t n, size_t rowBegin, size_t rowEnd) {
+    for (size_t i = rowBegin; i < rowEnd; i++) {
+        for (size_t panel = 0; panel < n / CPU_PACK_WIDTH; panel++) {
+            const float *bPanel = packed + panel * n * CPU_PACK_WIDTH;
+            float sum[CPU_PACK_WIDTH] = {};
+            for (size_t k = 0; k < n; k++) {
+                float aik = a[i * n + k];
+                for (size_t jj = 0; jj < CPU_PACK_WIDTH; jj++) {
+                    sum[jj] += aik * bPanel[k * CPU_PACK_WIDTH + jj];
+                }
+            }
+            memcpy(c + i * n + panel * CPU_PACK_WIDTH, sum, sizeof(sum));
+        }
+    }
+}
+
+#ifdef CPU_BACKEND_X86
+// 4 rows x 16 columns of C in registers (8 accumulators): each load of the panel is used for 
+// 4 rows, and the panel is read sequentially
+__attribute__((target("avx2,fma")))
+inline void mxmPackedRowsAVX2(const float *a, const float *packed, float *c, size_t n, size_t rowBegin, size_t rowEnd) {
+    static_assert(CPU_PACK_WIDTH == 16, "The AVX2 kernel uses two vectors per panel row");
+    size_t i = rowBegin;
+    for (; i + 4 <= rowEnd; i += 4) {
+        for (size_t panel = 0; panel < n / CPU_PACK_WIDTH; panel++) {
+            const float *bPanel = packed + panel * n * CPU_PACK_WIDTH;
+            __m256 sum[4][2];
+            for (int r = 0; r < 4; r++) {
+                sum[r][0] = _mm256_setzero_ps();
+                sum[r][1] = _mm256_setzero_ps();
+            }
+            for (size_t k = 0; k < n; k++) {
+                __m256 b0 = _mm256_loadu_ps(bPanel + k * CPU_PACK_WIDTH);
+                __m256 b1 = _mm256_loadu_ps(bPanel + k * CPU_PACK_WIDTH + 8);
+                for (int r = 0; r < 4; r++) {
+                    __m256 aik = _mm256_set1_ps(a[(i + r) * n + k]);
+                    sum[r][0] = _mm256_fmadd_ps(aik, b0, sum[r][0]);
+                    sum[r][1] = _mm256_fmadd_ps(aik, b1, sum[r][1]);
+                }
+            }
+            for (int r = 0; r < 4; r++) {
+                _mm256_storeu_ps(c + (i + r) * n + panel * CPU_PACK_WIDTH, sum[r][0]);
+                _mm256_storeu_ps(c + (i + r) * n + panel * CPU_PACK_WIDTH + 8, sum[r][1]);
+            }
+        }
+    }
+    mxmPackedRowsScalar(a, packed, c, n, i, rowEnd);
+}
+#endif
+
+// C = A x B with B in the packed layout (see cpuPackB). n must be a multiple of CPU_PACK_WIDTH.
+inline void cpuMatrixMultiplyPackedB(const float *a, const float *packed, float *c, size_t n) {
+    bool avx2 = cpuSupportsAVX2();
+    parallelFor(0, n, [=](size_t rowBegin, size_t rowEnd) {
+#ifdef CPU_BACKEND_X86
+        if (avx2) {
+            mxmPackedRowsAVX2(a, packed, c, n, rowBegin, rowEnd);
+            return;
+        }
+#endif
+        mxmPackedRowsScalar(a, packed, c, n, rowBegin, rowEnd);
+    });
+}
+
+// ---------------------------------------------------------------------------------------------
+// Int8 Matrix Multiplication: C (int32) = A (int8) x B (int8), n x n, row major.
+// With VNNI (AVX-VNNI or AVX512-VNNI), B is used in the packed layout of the dp4a kernels: 
+// groups of 4 consecutive k for each column, packed[((k / 4) * n + j) * 4 + k % 4], so one 
+// vpdpbusd computes 4 products (and their sum) for 8 columns. vpdpbusd multiplies unsigned x 
+// signed bytes, so A is offset by 128 and 128 * sum_k(b_kj) is subtracted at the end.
+// Without VNNI, the AVX2 version widens to int16 (i-k-j order, row-major B).
+// n must be a multiple of 4 for the packed layout.
+// ---------------------------------------------------------------------------------------------
+inline void packInt8B(const int8_t *b, int8_t *packed, size_t n) {
+    parallelFor(0, n / 4, [=](size_t begin, size_t end) {
+        for (size_t kk = begin; kk < end; kk++) {
+            for (size_t j = 0; j < n; j++) {
+                for (size_t r = 0; r < 4; r++) {
+                    packed[(kk * n + j) * 4 + r] = b[(kk * 4 + r) * n + j];
+                }
+            }
+        }
+    });
+}
+
+inline void mxmInt8RowsScalar(const int8_t *a, const int8_t *b, int32_t *c, size_t n, size_t rowBegin, size_t rowEnd) {
+    for (size_t i = rowBegin; i < rowEnd; i++) {
+        int32_t *ci = c + i * n;
+        std::fill(ci, ci + n, 0);
+        for (size_t k = 0; k < n; k++) {
+            int32_t aik = a[i * n + k];
+            const int8_t *bk = b + k * n;
+            for (size_t j = 0; j < n; j++) {
+                ci[j] += aik * bk[j];
+            }
+        }
+    }
+}
+
+inline bool cpuSupportsAVXVNNI() {
+#ifdef CPU_BACKEND_X86
+    return __builtin_cpu_supports("avxvnni");
+#else
+    return false;
+#endif
+}
+
+inline bool cpuSupportsAVX512VNNI() {
+#ifdef CPU_BACKEND_X86
+    return __builtin_cpu_supports("avx512vnni") && __builtin_cpu_supports("avx512vl");
+#else
+    return false;
+#endif
+}
+
+#ifdef CPU_BACKEND_X86
+// |a_ik * b_kj| <= 128 * 128, so the products fit in int16 before the int32 accumulation
+__attribute__((target("avx2")))
+inline void mxmInt8RowsAVX2(const int8_t *a, const int8_t *b, int32_t *c, size_t n, size_t rowBegin, size_t rowEnd) {
+    for (size_t i = rowBegin; i < rowEnd; i++) {
+        int32_t *ci = c + i * n;
+        std::fill(ci, ci + n, 0);
+        for (size_t k = 0; k < n; k++) {
+            int32_t aik = a[i * n + k];
+            __m256i aikVector = _mm256_set1_epi16(static_cast<int16_t>(aik));
+            const int8_t *bk = b + k * n;
+            size_t j = 0;
+            for (; j + 16 <= n; j += 16) {
+                __m256i bVector = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(bk + j)));
+                __m256i products = _mm256_mullo_epi16(aikVector, bVector);
+                __m256i low = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(products));
+                __m256i high = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(products, 1));
+                __m256i *c0 = reinterpret_cast<__m256i *>(ci + j);
+                __m256i *c1 = reinterpret_cast<__m256i *>(ci + j + 8);
+                _mm256_storeu_si256(c0, _mm256_add_epi32(_mm256_loadu_si256(c0), low));
+                _mm256_storeu_si256(c1, _mm256_add_epi32(_mm256_loadu_si256(c1), high));
+            }
+            for (; j < n; j++) {
+                ci[j] += aik * bk[j];
+            }
+        }
+    }
+}
+
+// Same loop for both VNNI encodings: VEX (AVX-VNNI) and EVEX (AVX512-VNNI + VL)
+#define MXM_INT8_ROWS_VNNI(DPBUSD)                                                                      \
+    for (size_t i = rowBegin; i < rowEnd; i++) {                                                        \
+        const int8_t *ai = a + i * n;                                                                   \
+        int32_t *ci = c + i * n;                                                                        \
+        size_t j = 0;                                                                                   \
+        for (; j + 8 <= n; j += 8) {                                                                    \
+            __m256i accumulator = _mm256_setzero_si256();                                               \
+            for (size_t kk = 0; kk < n / 4; kk++) {                                                     \
+                uint32_t aGroup;                                                                        \
+                memcpy(&aGroup, ai + kk * 4, sizeof(aGroup));                                           \
+                __m256i aVector = _mm256_set1_epi32(static_cast<int32_t>(aGroup ^ 0x80808080u));        \
+                __m256i bVector = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bPacked + (kk * n + j) * 4)); \
+                accumulator = DPBUSD(accumulator, aVector, bVector);                                    \
+            }                                                                                           \
+            __m256i offset = _mm256_slli_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(columnSums + j)), 7); \
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(ci + j), _mm256_sub_epi32(accumulator, offset)); \
+        }                                                                                               \
+        for (; j < n; j++) {                                                                            \
+            int32_t sum = 0;                                                                            \
+            for (size_t k = 0; k < n; k++) {                                                            \
+                sum += ai[k] * bPacked[((k / 4) * n + j) * 4 + k % 4];                                  \
+            }                                                                                           \
+            ci[j] = sum;                                                                                \
+        }                                                                                               \
+    }
+
+__attribute__((target("avxvnni")))
+inline void mxmInt8RowsAVXVNNI(const int8_t *a, const int8_t *bPacked, const int32_t *columnSums, int32_t *c, 
+                               size_t n, size_t rowBegin, size_t rowEnd) {
+    MXM_INT8_ROWS_VNNI(_mm256_dpbusd_avx_epi32)
+}
+
+__attribute__((target("avx512vnni,avx512vl")))
+inline void mxmInt8RowsAVX512VNNI(const int8_t *a, const int8_t *bPacked, const int32_t *columnSums, int32_t *c, 
+                                  size_t n, size_t rowBegin, size_t rowEnd) {
+    MXM_INT8_ROWS_VNNI(_mm256_dpbusd_epi32)
+}
+#undef MXM_INT8_ROWS_VNNI
+#endif
+
+// Name of the path used by cpuMatrixMultiplyInt8 on this CPU
+inline std::string cpuInt8Path() {
+    if (cpuSupportsAVX512VNNI()) {
+        return "AVX512-VNNI";
+    } else if (cpuSupportsAVXVNNI()) {
+        return "AVX-VNNI";
+    } else if (cpuSupportsAVX2()) {
+        return "AVX2";
+    }
+    return "scalar";
+}
+
+// b is row major, bPacked is the packed layout of the same matrix (see packInt8B)
+inline void cpuMatrixMultiplyInt8(const int8_t *a, const int8_t *b, const int8_t *bPacked, int32_t *c, size_t n) {
+#ifdef CPU_BACKEND_X86
+    bool avx512vnni = cpuSupportsAVX512VNNI();
+    bool avxvnni = cpuSupportsAVXVNNI();
+    if ((avx512vnni || avxvnni) && n % 4 == 0) {
+        std::vector<int32_t> columnSums(n, 0);
+        for (size_t k = 0; k < n; k++) {
+            for (size_t j = 0; j < n; j++) {
+                columnSums[j] += b[k * n + j];
+            }
+        }
+        const int32_t *sums = columnSums.data();
+        parallelFor(0, n, [=](size_t rowBegin, size_t rowEnd) {
+            if (avx512vnni) {
+                mxmInt8RowsAVX512VNNI(a, bPacked, sums, c, n, rowBegin, rowEnd);
+            } else {
+                mxmInt8RowsAVXVNNI(a, bPacked, sums, c, n, rowBegin, rowEnd);
+            }
+        });
+        return;
+    }
+#endif
+    bool avx2 = cpuSupportsAVX2();
+    parallelFor(0, n, [=](size_t rowBegin, size_t rowEnd) {
+#ifdef CPU_BACKEND_X86
+        if (avx2) {
+            mxmInt8RowsAVX2(a, b, c, n, rowBegin, rowEnd);
+            return;
+        }
+#endif
+        mxmInt8RowsScalar(a, b, c, n, rowBegin, rowEnd);
+    });
+}
+
+// ---------------------------------------------------------------------------------------------
+// Vector Addition: c = a + b
+// ---------------------------------------------------------------------------------------------
+inline void vectorAddScalar(const float *a, const float *b, float *c, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        c[i] = a[i] + b[i];
+    }
+}
+
+#ifdef CPU_BACKEND_X86
+__attribute__((target("avx2")))
+inline void vectorAddAVX2(const float *a, const float *b, float *c, size_t begin, size_t end) {
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        _mm256_storeu_ps(c + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+    vectorAddScalar(a, b, c, i, end);
+}
+#endif
+
+inline void cpuVectorAdd(const float *a, const float *b, float *c, size_t n) {
+    bool avx2 = cpuSupportsAVX2();
+    parallelFor(0, n, [=](size_t begin, size_t end) {
+#ifdef CPU_BACKEND_X86
+        if (avx2) {
+            vectorAddAVX2(a, b, c, begin, end);
+            return;
+        }
+#endif
+        vectorAddScalar(a, b, c, begin, end);
+    });
+}
+
+// ---------------------------------------------------------------------------------------------
+// Memory copy: each thread copies a contiguous chunk (memcpy is already vectorized by the libc)
+// ---------------------------------------------------------------------------------------------
+inline void cpuMemoryCopy(void *dst, const void *src, size_t bytes) {
+    char *dstBytes = static_cast<char *>(dst);
+    const char *srcBytes = static_cast<const char *>(src);
+    // Avoid spawning threads for small copies
+    constexpr size_t minBytesPerThread = 1 << 20;
+    unsigned numThreads = static_cast<unsigned>(std::min<size_t>(cpuBackendThreads(), std::max<size_t>(1, bytes / minBytesPerThread)));
+    parallelFor(0, bytes, [=](size_t begin, size_t end) {
+        std::memcpy(dstBytes + begin, srcBytes + begin, end - begin);
+    }, numThreads);
+}
+
+#endif
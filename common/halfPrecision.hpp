@@ -0,0 +1,234 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Conversions between fp32 and the 16-bit floating point formats used by the reduced
+// precision kernels:
+//  - fp16 (IEEE 754 half): 1 sign, 5 exponent, 10 mantissa bits
+//  - bf16 (bfloat16)     : 1 sign, 8 exponent, 7 mantissa bits (the upper half of a float)
+// Both conversions from fp32 round to nearest even. The buffers are converted in parallel,
+// using F16C (fp16) and AVX2 (bf16) when the CPU supports them, with a scalar fallback.
+
+#ifndef HALF_PRECISION_HPP
+#define HALF_PRECISION_HPP
+
+#include "cpuBackend.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+inline uint32_t floatBits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float bitsToFloat(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline uint16_t floatToHalf(float value) {
+    uint32_t bits = floatBits(value);
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t exponent = (bits >> 23) & 0xFF;
+    uint32_t mantissa = bits & 0x7FFFFF;
+    if (exponent == 0xFF) {
+        // Inf or NaN (NaNs stay quiet NaNs)
+        return sign | 0x7C00 | (mantissa != 0 ? 0x200 : 0);
+    }
+    int halfExponent = static_cast<int>(exponent) - 127 + 15;
+    if (halfExponent >= 31) {
+        return sign | 0x7C00;
+    }
+    if (halfExponent <= 0) {
+        // Subnormal half (or zero)
+        if (halfExponent < -10) {
+            return sign;
+        }
+        mantissa |= 0x800000;
+        uint32_t shift = 14 - halfExponent;
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1))) {
+            half++;
+        }
+        return sign | half;
+    }
+    uint32_t half = (halfExponent << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1FFF;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+        // A carry into the exponent is the correct rounding (up to Inf)
+        half++;
+    }
+    return sign | half;
+}
+
+inline float halfToFloat(uint16_t half) {
+    uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    uint32_t exponent = (half >> 10) & 0x1F;
+    uint32_t mantissa = half & 0x3FF;
+    if (exponent == 0) {
+        // Zero or subnormal: mantissa x 2^-24
+        float value = mantissa * (1.0f / 16777216.0f);
+        return sign ? -value : value;
+    }
+    if (exponent == 31) {
+        return bitsToFloat(sign | 0x7F800000 | (mantissa << 13));
+    }
+    return bitsToFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+inline uint16_t floatToBF16(float value) {
+    uint32_t bits = floatBits(value);
+    if ((bits & 0x7FFFFFFF) > 0x7F800000) {
+        // NaN: keep it quiet (the rounding could turn it into Inf)
+        return static_cast<uint16_t>((bits >> 16) | 0x40);
+    }
+    uint32_t rounding = 0x7FFF + ((bits >> 16) & 1);
+    return static_cast<uint16_t>((bits + rounding) >> 16);
+}
+
+inline float bf16ToFloat(uint16_t value) {
+    return bitsToFloat(static_cast<uint32_t>(value) << 16);
+}
+
+inline bool cpuSupportsF16C() {
+#ifdef CPU_BACKEND_X86
+    return __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+#else
+    return false;
+#endif
+}
+
+#ifdef CPU_BACKEND_X86
+__attribute__((target("avx,f16c")))
+inline void floatToHalfF16C(const float *src, uint16_t *dst, size_t begin, size_t end) {
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), half);
+    }
+    for (; i < end; i++) {
+        dst[i] = floatToHalf(src[i]);
+    }
+}
+
+__attribute__((target("avx,f16c")))
+inline void halfToFloatF16C(const uint16_t *src, float *dst, size_t begin, size_t end) {
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(half));
+    }
+    for (; i < end; i++) {
+        dst[i] = halfToFloat(src[i]);
+    }
+}
+
+__attribute__((target("avx2")))
+inline void floatToBF16AVX2(const float *src, uint16_t *dst, size_t begin, size_t end) {
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i bias = _mm256_set1_epi32(0x7FFF);
+    const __m256i absMask = _mm256_set1_epi32(0x7FFFFFFF);
+    const __m256i infinity = _mm256_set1_epi32(0x7F800000);
+    const __m256i quiet = _mm256_set1_epi32(0x400000);
+    size_t i = begin;
+    for (; i + 16 <= end; i += 16) {
+        __m256i result[2];
+        for (int part = 0; part < 2; part++) {
+            __m256i bits = _mm256_castps_si256(_mm256_loadu_ps(src + i + part * 8));
+            __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+            __m256i rounded = _mm256_add_epi32(bits, _mm256_add_epi32(bias, lsb));
+            __m256i isNaN = _mm256_cmpgt_epi32(_mm256_and_si256(bits, absMask), infinity);
+            __m256i value = _mm256_blendv_epi8(rounded, _mm256_or_si256(bits, quiet), isNaN);
+            result[part] = _mm256_srli_epi32(value, 16);
+        }
+        // Pack both halves to 16 bits, packus works within 128-bit lanes
+        __m256i packed = _mm256_packus_epi32(result[0], result[1]);
+        packed = _mm256_permute4x64_epi64(packed, 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), packed);
+    }
+    for (; i < end; i++) {
+        dst[i] = floatToBF16(src[i]);
+    }
+}
+#endif
+
+inline void convertFloatToHalf(const float *src, uint16_t *dst, size_t count) {
+    bool f16c = cpuSupportsF16C();
+    parallelFor(0, count, [=](size_t begin, size_t end) {
+#ifdef CPU_BACKEND_X86
+        if (f16c) {
+            floatToHalfF16C(src, dst, begin, end);
+            return;
+        }
+#endif
+        for (size_t i = begin; i < end; i++) {
+            dst[i] = floatToHalf(src[i]);
+        }
+    });
+}
+
+inline void convertHalfToFloat(const uint16_t *src, float *dst, size_t count) {
+    bool f16c = cpuSupportsF16C();
+    parallelFor(0, count, [=](size_t begin, size_t end) {
+#ifdef CPU_BACKEND_X86
+        if (f16c) {
+            halfToFloatF16C(src, dst, begin, end);
+            return;
+        }
+#endif
+        for (size_t i = begin; i < end; i++) {
+            dst[i] = halfToFloat(src[i]);
+        }
+    });
+}
+
+inline void convertFloatToBF16(const float *src, uint16_t *dst, size_t count) {
+    bool avx2 = cpuSupportsAVX2();
+    parallelFor(0, count, [=](size_t begin, size_t end) {
+#ifdef CPU_BACKEND_X86
+        if (avx2) {
+            floatToBF16AVX2(src, dst, begin, end);
+            return;
+        }
+#endif
+        for (size_t i = begin; i < end; i++) {
+            dst[i] = floatToBF16(src[i]);
+        }
+    });
+}
+
+// bf16 -> fp32 is a 16-bit shift, the compiler vectorizes the scalar loop
+inline void convertBF16ToFloat(const uint16_t *src, float *dst, size_t count) {
+    parallelFor(0, count, [=](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            dst[i] = bf16ToFloat(src[i]);
+        }
+    });
+}
+
+#endif
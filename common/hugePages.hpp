@@ -0,0 +1,201 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Host buffers backed by huge pages, to compare heap <-> device copies against normal 4KB pages.
+// Pageable heap memory is staged by the driver, and each 4KB page needs its own translation, so
+// large pages reduce both the pinning and the TLB costs of a copy:
+//  - thp: anonymous mmap + madvise(MADV_HUGEPAGE) (transparent huge pages, best effort)
+//  - 2M : mmap(MAP_HUGETLB | MAP_HUGE_2MB), needs pages reserved in /proc/sys/vm/nr_hugepages
+//  - 1G : mmap(MAP_HUGETLB | MAP_HUGE_1GB), needs 1GB pages reserved at boot or in
+//         /sys/kernel/mm/hugepages/hugepages-1048576kB/nr_hugepages
+// The page size is selected with HUGE_PAGES=none|thp|2M|1G. If the explicit huge pages are not
+// available, the allocation falls back to THP and the buffer reports the mode actually used.
+
+#ifndef HUGE_PAGES_HPP
+#define HUGE_PAGES_HPP
+
+#include <sys/mman.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif
+
+enum class HostPageMode {
+    NORMAL,
+    THP,
+    HUGE_2MB,
+    HUGE_1GB
+};
+
+inline std::string hostPageModeName(HostPageMode mode) {
+    switch (mode) {
+        case HostPageMode::THP:
+            return "THP";
+        case HostPageMode::HUGE_2MB:
+            return "2M";
+        case HostPageMode::HUGE_1GB:
+            return "1G";
+        default:
+            return "4K";
+    }
+}
+
+inline HostPageMode hostPageModeFromString(const std::string &name) {
+    if (name == "thp" || name == "THP") {
+        return HostPageMode::THP;
+    } else if (name == "2M" || name == "2m") {
+        return HostPageMode::HUGE_2MB;
+    } else if (name == "1G" || name == "1g") {
+        return HostPageMode::HUGE_1GB;
+    }
+    return HostPageMode::NORMAL;
+}
+
+inline HostPageMode hostPageModeFromEnv() {
+    const char *env = std::getenv("HUGE_PAGES");
+    return (env == nullptr) ? HostPageMode::NORMAL : hostPageModeFromString(env);
+}
+
+struct HostPages {
+    void *ptr;
+    size_t bytes;
+    size_t mappedBytes;     // 0 for heap allocations
+    HostPageMode mode;
+};
+
+inline size_t roundUp(size_t value, size_t multiple) {
+    return ((value + multiple - 1) / multiple) * multiple;
+}
+
+inline HostPages allocHostPages(size_t bytes, HostPageMode mode) {
+    HostPages pages = {nullptr, bytes, 0, mode};
+    if (mode == HostPageMode::NORMAL) {
+        pages.ptr = std::malloc(bytes);
+        return pages;
+    }
+
+    if (mode == HostPageMode::HUGE_2MB || mode == HostPageMode::HUGE_1GB) {
+        size_t pageSize = (mode == HostPageMode::HUGE_2MB) ? (1UL << 21) : (1UL << 30);
+        int sizeFlag = (mode == HostPageMode::HUGE_2MB) ? MAP_HUGE_2MB : MAP_HUGE_1GB;
+        size_t mappedBytes = roundUp(bytes, pageSize);
+        void *ptr = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, 
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | sizeFlag, -1, 0);
+        if (ptr != MAP_FAILED) {
+            pages.ptr = ptr;
+            pages.mappedBytes = mappedBytes;
+            return pages;
+        }
+        std::cout << "[WARNING] No " << hostPageModeName(mode) << " huge pages available (check nr_hugepages). Using THP" << std::endl;
+        pages.mode = HostPageMode::THP;
+    }
+
+    // Transparent huge pages: the mapping must start on a 2MB boundary so the whole buffer can be
+    // promoted. mmap only guarantees 4KB alignment, so map 2MB more and trim the head and the tail
+    const size_t hugePageSize = 1UL << 21;
+    size_t mappedBytes = roundUp(bytes, hugePageSize);
+    void *ptr = mmap(nullptr, mappedBytes + hugePageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        pages.ptr = nullptr;
+        return pages;
+    }
+    uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+    uintptr_t alignedBegin = roundUp(begin, hugePageSize);
+    size_t head = alignedBegin - begin;
+    size_t tail = hugePageSize - head;
+    if (head > 0) {
+        munmap(ptr, head);
+    }
+    if (tail > 0) {
+        munmap(reinterpret_cast<void *>(alignedBegin + mappedBytes), tail);
+    }
+    ptr = reinterpret_cast<void *>(alignedBegin);
+    madvise(ptr, mappedBytes, MADV_HUGEPAGE);
+    pages.ptr = ptr;
+    pages.mappedBytes = mappedBytes;
+    return pages;
+}
+
+inline void freeHostPages(HostPages &pages) {
+    if (pages.ptr == nullptr) {
+        return;
+    }
+    if (pages.mappedBytes == 0) {
+        std::free(pages.ptr);
+    } else {
+        munmap(pages.ptr, pages.mappedBytes);
+    }
+    pages.ptr = nullptr;
+}
+
+// Bytes of the mapping that contains ptr backed by huge pages (AnonHugePages + hugetlbfs),
+// read from /proc/self/smaps. Call it after the buffer has been touched.
+inline size_t hugePageBackedBytes(const void *ptr) {
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    bool inMapping = false;
+    size_t backedKB = 0;
+    uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    while (std::getline(smaps, line)) {
+        unsigned long begin = 0;
+        unsigned long end = 0;
+        char dash = 0;
+        std::istringstream header(line);
+        if (line.find(':') == std::string::npos || line.find('-') < line.find(':')) {
+            // Mapping header: <begin>-<end> perms offset dev inode path
+            if ((header >> std::hex >> begin >> dash >> end) && dash == '-') {
+                if (inMapping) {
+                    break;
+                }
+                inMapping = (address >= begin && address < end);
+                continue;
+            }
+        }
+        if (!inMapping) {
+            continue;
+        }
+        std::istringstream field(line);
+        std::string key;
+        size_t value = 0;
+        field >> key >> value;
+        if (key == "AnonHugePages:" || key == "Private_Hugetlb:" || key == "Shared_Hugetlb:") {
+            backedKB += value;
+        }
+    }
+    return backedKB * 1024;
+}
+
+#endif
@@ -0,0 +1,195 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Parallel, NUMA-aware first-touch initialization of large host buffers.
+//
+// Linux places a page on the NUMA node of the thread that touches it first. The buffer is
+// split in contiguous chunks, one per thread, and each thread is pinned to the CPUs of a
+// NUMA node before filling its chunk:
+//  - spread (default): threads are distributed across all NUMA nodes
+//  - device          : all threads run on the node closest to the device (PCIe root), so
+//                      the pages end up next to the device for host <-> device copies
+//  - <node id>       : all threads run on the given node
+// The placement is selected with FIRST_TOUCH=spread|device|<node> and the number of threads
+// with INIT_THREADS (default: all hardware threads).
+
+#ifndef PARALLEL_INIT_HPP
+#define PARALLEL_INIT_HPP
+
+#include <ze_api.h>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Below this size, the buffer is filled by the calling thread
+#define PARALLEL_INIT_MIN_BYTES (1 << 20)
+
+// Parse a sysfs CPU list, e.g. "0-15,32-47"
+inline std::vector<int> parseCpuList(const std::string &cpuList) {
+    std::vector<int> cpus;
+    std::stringstream stream(cpuList);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        size_t dash = range.find('-');
+        int first = std::atoi(range.substr(0, dash).c_str());
+        int last = (dash == std::string::npos) ? first : std::atoi(range.substr(dash + 1).c_str());
+        for (int cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+// CPUs of each NUMA node (from /sys/devices/system/node). A single node with no CPU list
+// is returned when the information is not available.
+inline std::vector<std::vector<int>> numaNodeCpus() {
+    std::vector<std::vector<int>> nodes;
+    for (int node = 0; ; node++) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!file.is_open()) {
+            break;
+        }
+        std::string cpuList;
+        std::getline(file, cpuList);
+        nodes.push_back(parseCpuList(cpuList));
+    }
+    if (nodes.empty()) {
+        nodes.push_back({});
+    }
+    return nodes;
+}
+
+// NUMA node of the PCIe slot of the device, or -1 if unknown
+inline int deviceNumaNode(ze_device_handle_t device) {
+    ze_pci_ext_properties_t pciProperties = {ZE_STRUCTURE_TYPE_PCI_EXT_PROPERTIES};
+    if (zeDevicePciGetPropertiesExt(device, &pciProperties) != ZE_RESULT_SUCCESS) {
+        return -1;
+    }
+    char address[64];
+    snprintf(address, sizeof(address), "%04x:%02x:%02x.%x",
+             pciProperties.address.domain, pciProperties.address.bus,
+             pciProperties.address.device, pciProperties.address.function);
+    std::ifstream file(std::string("/sys/bus/pci/devices/") + address + "/numa_node");
+    int node = -1;
+    if (file.is_open()) {
+        file >> node;
+    }
+    return node;
+}
+
+// NUMA node used for the first touch: -1 to spread the threads across all nodes
+inline int firstTouchNode(ze_device_handle_t device = nullptr) {
+    const char *env = std::getenv("FIRST_TOUCH");
+    if (env == nullptr || std::string(env) == "spread") {
+        return -1;
+    }
+    if (std::string(env) == "device") {
+        return (device != nullptr) ? deviceNumaNode(device) : -1;
+    }
+    return std::atoi(env);
+}
+
+inline unsigned parallelInitThreads() {
+    const char *env = std::getenv("INIT_THREADS");
+    if (env != nullptr && std::atoi(env) > 0) {
+        return std::atoi(env);
+    }
+    unsigned threads = std::thread::hardware_concurrency();
+    return (threads == 0) ? 1 : threads;
+}
+
+inline void pinCurrentThread(const std::vector<int> &cpus) {
+    if (cpus.empty()) {
+        return;
+    }
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (auto cpu : cpus) {
+        CPU_SET(cpu, &cpuSet);
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+}
+
+// Run fill(begin, end) over [0, count) with threads pinned according to the node policy
+template <typename Function>
+void parallelFirstTouch(size_t count, size_t elementSize, int node, Function fill) {
+    unsigned numThreads = parallelInitThreads();
+    if (count * elementSize < PARALLEL_INIT_MIN_BYTES || numThreads == 1) {
+        fill(0, count);
+        return;
+    }
+    std::vector<std::vector<int>> nodes = numaNodeCpus();
+    if (node >= static_cast<int>(nodes.size())) {
+        node = -1;
+    }
+
+    std::vector<std::thread> threads;
+    size_t chunk = (count + numThreads - 1) / numThreads;
+    for (unsigned t = 0; t < numThreads; t++) {
+        size_t begin = t * chunk;
+        size_t end = std::min(count, begin + chunk);
+        if (begin >= end) {
+            break;
+        }
+        // Spread: consecutive chunks go to consecutive nodes in blocks, so each node gets a
+        // contiguous part of the buffer
+        const std::vector<int> &cpus = (node >= 0) ? nodes[node] : nodes[(t * nodes.size()) / numThreads];
+        threads.emplace_back([&cpus, begin, end, &fill]() {
+            pinCurrentThread(cpus);
+            fill(begin, end);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+template <typename T>
+void parallelFill(T *buffer, size_t count, T value, int node = -1) {
+    parallelFirstTouch(count, sizeof(T), node, [buffer, value](size_t begin, size_t end) {
+        std::fill(buffer + begin, buffer + end, value);
+    });
+}
+
+inline void parallelMemset(void *buffer, int value, size_t bytes, int node = -1) {
+    char *bytesBuffer = static_cast<char *>(buffer);
+    parallelFirstTouch(bytes, 1, node, [bytesBuffer, value](size_t begin, size_t end) {
+        memset(bytesBuffer + begin, value, end - begin);
+    });
+}
+
+#endif
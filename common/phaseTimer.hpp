@@ -0,0 +1,171 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Scoped phase timers to get a breakdown of the total process time: initialization,
+// module build, allocation, transfers, kernel execution and validation. 
+// 
+// Usage:
+//     PHASE_TIMER("init");                      // measures until the end of the scope
+// or
+//     PhaseTimer allocTimer("alloc");           // measures until stop() or the end of the scope
+//     ...
+//     allocTimer.stop();
+// 
+// Timers are enabled at runtime with PHASE_TIMERS=1. When disabled, a timer only checks a 
+// flag. Compiling with -DPHASE_TIMERS_DISABLED removes them completely: PHASE_TIMER expands to
+// nothing and PhaseTimer is an empty class, so there is no registry, no clock read and no output. 
+// The breakdown is printed at exit, in order of first appearance of each phase:
+//     PHASE-<name> = <ns> [ns] (<%> of total) calls=<n>
+// Phases should not overlap: time measured by nested timers is counted in both phases.
+
+#ifndef PHASE_TIMER_HPP
+#define PHASE_TIMER_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef PHASE_TIMERS_DISABLED
+
+class PhaseTimer {
+public:
+    explicit PhaseTimer(const char *) {}
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+    void stop() {}
+};
+
+#define PHASE_TIMER(name)
+
+#else
+
+class PhaseRegistry {
+public:
+    static PhaseRegistry &instance() {
+        // Never destroyed, so timers can still record during static destruction
+        static PhaseRegistry *registry = new PhaseRegistry();
+        return *registry;
+    }
+
+    bool enabled() const {
+        return isEnabled;
+    }
+
+    void record(const char *name, uint64_t ns) {
+        std::lock_guard<std::mutex> guard(lock);
+        for (auto &phase : phases) {
+            if (phase.name == name) {
+                phase.totalNs += ns;
+                phase.calls++;
+                return;
+            }
+        }
+        phases.push_back({name, ns, 1});
+    }
+
+    void print() {
+        std::lock_guard<std::mutex> guard(lock);
+        auto total = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - processStart).count();
+        uint64_t accounted = 0;
+        printf("\n");
+        for (auto &phase : phases) {
+            printf("PHASE-%s = %lu [ns] (%.2f%% of total) calls=%lu\n", phase.name.c_str(),
+                   static_cast<unsigned long>(phase.totalNs), 100.0 * phase.totalNs / total, 
+                   static_cast<unsigned long>(phase.calls));
+            accounted += phase.totalNs;
+        }
+        uint64_t unaccounted = (accounted < static_cast<uint64_t>(total)) ? total - accounted : 0;
+        printf("PHASE-other = %lu [ns] (%.2f%% of total)\n", static_cast<unsigned long>(unaccounted), 100.0 * unaccounted / total);
+        printf("PHASE-total = %lu [ns]\n", static_cast<unsigned long>(total));
+        fflush(stdout);
+    }
+
+private:
+    struct Phase {
+        std::string name;
+        uint64_t totalNs;
+        uint64_t calls;
+    };
+
+    PhaseRegistry() : processStart(std::chrono::steady_clock::now()) {
+        const char *value = std::getenv("PHASE_TIMERS");
+        isEnabled = (value != nullptr && strcmp(value, "0") != 0);
+        if (isEnabled) {
+            std::atexit([] { PhaseRegistry::instance().print(); });
+        }
+    }
+
+    bool isEnabled;
+    std::chrono::steady_clock::time_point processStart;
+    std::mutex lock;
+    std::vector<Phase> phases;
+};
+
+class PhaseTimer {
+public:
+    explicit PhaseTimer(const char *name) : name(name), running(PhaseRegistry::instance().enabled()) {
+        if (running) {
+            begin = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~PhaseTimer() {
+        stop();
+    }
+
+    PhaseTimer(const PhaseTimer &) = delete;
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+    void stop() {
+        if (running) {
+            auto end = std::chrono::steady_clock::now();
+            PhaseRegistry::instance().record(name, std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+            running = false;
+        }
+    }
+
+private:
+    const char *name;
+    bool running;
+    std::chrono::steady_clock::time_point begin;
+};
+
+// Create the registry during static initialization, so the total time starts close to the 
+// process start
+namespace {
+const PhaseRegistry &phaseRegistryInit = PhaseRegistry::instance();
+}
+
+#define PHASE_TIMER_CONCAT_(a, b) a##b
+#define PHASE_TIMER_CONCAT(a, b) PHASE_TIMER_CONCAT_(a, b)
+
+#define PHASE_TIMER(name) PhaseTimer PHASE_TIMER_CONCAT(phaseTimer, __LINE__)(name)
+
+#endif // PHASE_TIMERS_DISABLED
+
+#endif
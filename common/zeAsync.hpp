@@ -0,0 +1,147 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Asynchronous submission for Level Zero command lists. 
+// Submitting work returns a handle (ZeFuture) backed by a ze_fence, so the host can 
+// keep working (e.g., computing the reference result of a previous iteration) while 
+// the device executes the command list. 
+
+#ifndef ZE_ASYNC_HPP
+#define ZE_ASYNC_HPP
+
+#include <ze_api.h>
+#include "zeValidate.hpp"
+
+#include <iostream>
+#include <limits>
+#include <vector>
+
+// Handle to a submission. It does not own the fence: fences are owned and 
+// recycled by the ZeAsyncQueue that created the handle. Each slot of the queue counts its
+// submissions (generation). If the slot has been reused since this handle was created, the 
+// fence belongs to a newer submission, and this one is known to be complete: the queue waits 
+// for a slot before reusing it.
+class ZeFuture {
+public:
+    ZeFuture() : fence(nullptr), slotGeneration(nullptr), generation(0) {}
+    ZeFuture(ze_fence_handle_t fence, const uint64_t *slotGeneration) 
+        : fence(fence), slotGeneration(slotGeneration), generation(*slotGeneration) {}
+
+    bool valid() const {
+        return fence != nullptr;
+    }
+
+    // Non-blocking check
+    bool ready() const {
+        if (recycled()) {
+            return true;
+        }
+        ze_result_t status = zeFenceQueryStatus(fence);
+        if (status == ZE_RESULT_NOT_READY) {
+            return false;
+        }
+        ZE_VALIDATECALL(status);
+        return true;
+    }
+
+    // Block until the device has finished the submitted command lists
+    void wait() const {
+        if (recycled()) {
+            return;
+        }
+        ZE_VALIDATECALL(zeFenceHostSynchronize(fence, std::numeric_limits<uint64_t>::max()));
+    }
+
+private:
+    bool recycled() const {
+        return slotGeneration != nullptr && *slotGeneration != generation;
+    }
+
+    ze_fence_handle_t fence;
+    const uint64_t *slotGeneration;     // owned by the ZeAsyncQueue
+    uint64_t generation;
+};
+
+// Wraps a command queue with a fixed number of fences (slots). Each submission takes 
+// the next slot in round-robin order. If the slot is still in use by an older submission, 
+// submit waits for it before reusing the fence.
+class ZeAsyncQueue {
+public:
+    ZeAsyncQueue(ze_command_queue_handle_t cmdQueue, uint32_t maxInFlight) : cmdQueue(cmdQueue), nextSlot(0) {
+        ze_fence_desc_t fenceDesc = {ZE_STRUCTURE_TYPE_FENCE_DESC};
+        fences.resize(maxInFlight);
+        pending.resize(maxInFlight, false);
+        generations.resize(maxInFlight, 0);
+        for (uint32_t i = 0; i < maxInFlight; i++) {
+            ZE_VALIDATECALL(zeFenceCreate(cmdQueue, &fenceDesc, &fences[i]));
+        }
+    }
+
+    ~ZeAsyncQueue() {
+        synchronize();
+        for (auto fence : fences) {
+            zeFenceDestroy(fence);
+        }
+    }
+
+    ZeAsyncQueue(const ZeAsyncQueue &) = delete;
+    ZeAsyncQueue &operator=(const ZeAsyncQueue &) = delete;
+
+    // Submit closed command lists for execution and return immediately
+    ZeFuture submit(ze_command_list_handle_t *cmdLists, uint32_t numCommandLists) {
+        uint32_t slot = nextSlot;
+        nextSlot = (nextSlot + 1) % fences.size();
+        if (pending[slot]) {
+            ZE_VALIDATECALL(zeFenceHostSynchronize(fences[slot], std::numeric_limits<uint64_t>::max()));
+        }
+        ZE_VALIDATECALL(zeFenceReset(fences[slot]));
+        ZE_VALIDATECALL(zeCommandQueueExecuteCommandLists(cmdQueue, numCommandLists, cmdLists, fences[slot]));
+        pending[slot] = true;
+        generations[slot]++;
+        return ZeFuture(fences[slot], &generations[slot]);
+    }
+
+    ZeFuture submit(ze_command_list_handle_t cmdList) {
+        return submit(&cmdList, 1);
+    }
+
+    // Wait for all in-flight submissions
+    void synchronize() {
+        for (size_t i = 0; i < fences.size(); i++) {
+            if (pending[i]) {
+                ZE_VALIDATECALL(zeFenceHostSynchronize(fences[i], std::numeric_limits<uint64_t>::max()));
+                pending[i] = false;
+            }
+        }
+    }
+
+private:
+    ze_command_queue_handle_t cmdQueue;
+    std::vector<ze_fence_handle_t> fences;
+    std::vector<bool> pending;
+    std::vector<uint64_t> generations;
+    uint32_t nextSlot;
+};
+
+#endif
@@ -0,0 +1,151 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Level Zero entry points that open the loader (libze_loader.so.1) on first use, instead of 
+// linking it. A program built with this file starts on hosts without Level Zero: if the loader 
+// cannot be opened, every call returns ZE_RESULT_ERROR_UNINITIALIZED, so zeInit fails and the
+// program selects the CPU backend (see useCpuBackend in cpuBackend.hpp).
+// 
+// Build it with the program instead of ${ZE_SHARED_LOADER}:
+//     g++ ... -I../../common program.cpp ../../common/zeLazyLoader.cpp -o program -ldl
+// 
+// Environment variables:
+//     ZE_LOADER_LIBRARY=<path>   library to open instead of libze_loader.so.1
+// 
+// The loader is opened with RTLD_GLOBAL and the functions are resolved with RTLD_NEXT, so the 
+// wrappers of zeTracer are still called when it is preloaded.
+
+#include <ze_api.h>
+
+#include <dlfcn.h>
+
+#include <cstdlib>
+
+namespace {
+
+void *loaderHandle() {
+    static void *handle = []() -> void * {
+        const char *env = std::getenv("ZE_LOADER_LIBRARY");
+        if (env != nullptr) {
+            return dlopen(env, RTLD_NOW | RTLD_GLOBAL);
+        }
+        void *library = dlopen("libze_loader.so.1", RTLD_NOW | RTLD_GLOBAL);
+        return (library != nullptr) ? library : dlopen("libze_loader.so", RTLD_NOW | RTLD_GLOBAL);
+    }();
+    return handle;
+}
+
+void *lookupLoaderFunction(const char *name) {
+    if (loaderHandle() == nullptr) {
+        return nullptr;
+    }
+    return dlsym(RTLD_NEXT, name);
+}
+
+} // namespace
+
+// Define an entry point with the same signature as the API. The function is resolved the first 
+// time the API is called.
+#define ZE_LAZY(name, params, args)                                                               \
+    extern "C" ze_result_t name params {                                                          \
+        using FunctionType = ze_result_t (*) params;                                              \
+        static FunctionType realFunction = reinterpret_cast<FunctionType>(lookupLoaderFunction(#name)); \
+        if (realFunction == nullptr) {                                                            \
+            return ZE_RESULT_ERROR_UNINITIALIZED;                                                 \
+        }                                                                                         \
+        return realFunction args;                                                                 \
+    }
+
+// Initialization and devices
+ZE_LAZY(zeInit, (ze_init_flags_t flags), (flags))
+ZE_LAZY(zeDriverGet, (uint32_t *pCount, ze_driver_handle_t *phDrivers), (pCount, phDrivers))
+ZE_LAZY(zeDriverGetApiVersion, (ze_driver_handle_t hDriver, ze_api_version_t *version), (hDriver, version))
+ZE_LAZY(zeDriverGetProperties, (ze_driver_handle_t hDriver, ze_driver_properties_t *pDriverProperties), (hDriver, pDriverProperties))
+ZE_LAZY(zeDeviceGet, (ze_driver_handle_t hDriver, uint32_t *pCount, ze_device_handle_t *phDevices), (hDriver, pCount, phDevices))
+ZE_LAZY(zeDeviceGetSubDevices, (ze_device_handle_t hDevice, uint32_t *pCount, ze_device_handle_t *phSubdevices), (hDevice, pCount, phSubdevices))
+ZE_LAZY(zeDeviceGetProperties, (ze_device_handle_t hDevice, ze_device_properties_t *pDeviceProperties), (hDevice, pDeviceProperties))
+ZE_LAZY(zeDeviceGetModuleProperties, (ze_device_handle_t hDevice, ze_device_module_properties_t *pModuleProperties), (hDevice, pModuleProperties))
+ZE_LAZY(zeDeviceGetMemoryProperties, (ze_device_handle_t hDevice, uint32_t *pCount, ze_device_memory_properties_t *pMemProperties), (hDevice, pCount, pMemProperties))
+ZE_LAZY(zeDeviceGetMemoryAccessProperties, (ze_device_handle_t hDevice, ze_device_memory_access_properties_t *pMemAccessProperties), (hDevice, pMemAccessProperties))
+ZE_LAZY(zeDevicePciGetPropertiesExt, (ze_device_handle_t hDevice, ze_pci_ext_properties_t *pPciProperties), (hDevice, pPciProperties))
+ZE_LAZY(zeDeviceGetCommandQueueGroupProperties, (ze_device_handle_t hDevice, uint32_t *pCount, ze_command_queue_group_properties_t *pCommandQueueGroupProperties), (hDevice, pCount, pCommandQueueGroupProperties))
+ZE_LAZY(zeContextCreate, (ze_driver_handle_t hDriver, const ze_context_desc_t *desc, ze_context_handle_t *phContext), (hDriver, desc, phContext))
+ZE_LAZY(zeContextDestroy, (ze_context_handle_t hContext), (hContext))
+
+// Command queues and command lists
+ZE_LAZY(zeCommandQueueCreate, (ze_context_handle_t hContext, ze_device_handle_t hDevice, const ze_command_queue_desc_t *desc, ze_command_queue_handle_t *phCommandQueue), (hContext, hDevice, desc, phCommandQueue))
+ZE_LAZY(zeCommandQueueDestroy, (ze_command_queue_handle_t hCommandQueue), (hCommandQueue))
+ZE_LAZY(zeCommandQueueExecuteCommandLists, (ze_command_queue_handle_t hCommandQueue, uint32_t numCommandLists, ze_command_list_handle_t *phCommandLists, ze_fence_handle_t hFence), (hCommandQueue, numCommandLists, phCommandLists, hFence))
+ZE_LAZY(zeCommandQueueSynchronize, (ze_command_queue_handle_t hCommandQueue, uint64_t timeout), (hCommandQueue, timeout))
+ZE_LAZY(zeCommandListCreate, (ze_context_handle_t hContext, ze_device_handle_t hDevice, const ze_command_list_desc_t *desc, ze_command_list_handle_t *phCommandList), (hContext, hDevice, desc, phCommandList))
+ZE_LAZY(zeCommandListCreateImmediate, (ze_context_handle_t hContext, ze_device_handle_t hDevice, const ze_command_queue_desc_t *altdesc, ze_command_list_handle_t *phCommandList), (hContext, hDevice, altdesc, phCommandList))
+ZE_LAZY(zeCommandListDestroy, (ze_command_list_handle_t hCommandList), (hCommandList))
+ZE_LAZY(zeCommandListClose, (ze_command_list_handle_t hCommandList), (hCommandList))
+ZE_LAZY(zeCommandListReset, (ze_command_list_handle_t hCommandList), (hCommandList))
+ZE_LAZY(zeCommandListAppendBarrier, (ze_command_list_handle_t hCommandList, ze_event_handle_t hSignalEvent, uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents), (hCommandList, hSignalEvent, numWaitEvents, phWaitEvents))
+ZE_LAZY(zeCommandListAppendMemoryCopy, (ze_command_list_handle_t hCommandList, void *dstptr, const void *srcptr, size_t size, ze_event_handle_t hSignalEvent, uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents), (hCommandList, dstptr, srcptr, size, hSignalEvent, numWaitEvents, phWaitEvents))
+ZE_LAZY(zeCommandListAppendMemoryCopyRegion, (ze_command_list_handle_t hCommandList, void *dstptr, const ze_copy_region_t *dstRegion, uint32_t dstPitch, uint32_t dstSlicePitch, const void *srcptr, const ze_copy_region_t *srcRegion, uint32_t srcPitch, uint32_t srcSlicePitch, ze_event_handle_t hSignalEvent, uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents), (hCommandList, dstptr, dstRegion, dstPitch, dstSlicePitch, srcptr, srcRegion, srcPitch, srcSlicePitch, hSignalEvent, numWaitEvents, phWaitEvents))
+ZE_LAZY(zeCommandListAppendMemoryFill, (ze_command_list_handle_t hCommandList, void *ptr, const void *pattern, size_t patternSize, size_t size, ze_event_handle_t hSignalEvent, uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents), (hCommandList, ptr, pattern, patternSize, size, hSignalEvent, numWaitEvents, phWaitEvents))
+ZE_LAZY(zeCommandListAppendMemoryPrefetch, (ze_command_list_handle_t hCommandList, const void *ptr, size_t size), (hCommandList, ptr, size))
+ZE_LAZY(zeCommandListAppendMemAdvise, (ze_command_list_handle_t hCommandList, ze_device_handle_t hDevice, const void *ptr, size_t size, ze_memory_advice_t advice), (hCommandList, hDevice, ptr, size, advice))
+ZE_LAZY(zeCommandListAppendLaunchKernel, (ze_command_list_handle_t hCommandList, ze_kernel_handle_t hKernel, const ze_group_count_t *pLaunchFuncArgs, ze_event_handle_t hSignalEvent, uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents), (hCommandList, hKernel, pLaunchFuncArgs, hSignalEvent, numWaitEvents, phWaitEvents))
+ZE_LAZY(zeCommandListAppendWriteGlobalTimestamp, (ze_command_list_handle_t hCommandList, uint64_t *dstptr, ze_event_handle_t hSignalEvent, uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents), (hCommandList, dstptr, hSignalEvent, numWaitEvents, phWaitEvents))
+ZE_LAZY(zeCommandListAppendQueryKernelTimestamps, (ze_command_list_handle_t hCommandList, uint32_t numEvents, ze_event_handle_t *phEvents, void *dstptr, const size_t *pOffsets, ze_event_handle_t hSignalEvent, uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents), (hCommandList, numEvents, phEvents, dstptr, pOffsets, hSignalEvent, numWaitEvents, phWaitEvents))
+ZE_LAZY(zeCommandListAppendSignalEvent, (ze_command_list_handle_t hCommandList, ze_event_handle_t hEvent), (hCommandList, hEvent))
+ZE_LAZY(zeCommandListAppendWaitOnEvents, (ze_command_list_handle_t hCommandList, uint32_t numEvents, ze_event_handle_t *phEvents), (hCommandList, numEvents, phEvents))
+ZE_LAZY(zeCommandListAppendEventReset, (ze_command_list_handle_t hCommandList, ze_event_handle_t hEvent), (hCommandList, hEvent))
+
+// Synchronization
+ZE_LAZY(zeFenceCreate, (ze_command_queue_handle_t hCommandQueue, const ze_fence_desc_t *desc, ze_fence_handle_t *phFence), (hCommandQueue, desc, phFence))
+ZE_LAZY(zeFenceDestroy, (ze_fence_handle_t hFence), (hFence))
+ZE_LAZY(zeFenceHostSynchronize, (ze_fence_handle_t hFence, uint64_t timeout), (hFence, timeout))
+ZE_LAZY(zeFenceQueryStatus, (ze_fence_handle_t hFence), (hFence))
+ZE_LAZY(zeFenceReset, (ze_fence_handle_t hFence), (hFence))
+ZE_LAZY(zeEventPoolCreate, (ze_context_handle_t hContext, const ze_event_pool_desc_t *desc, uint32_t numDevices, ze_device_handle_t *phDevices, ze_event_pool_handle_t *phEventPool), (hContext, desc, numDevices, phDevices, phEventPool))
+ZE_LAZY(zeEventPoolDestroy, (ze_event_pool_handle_t hEventPool), (hEventPool))
+ZE_LAZY(zeEventCreate, (ze_event_pool_handle_t hEventPool, const ze_event_desc_t *desc, ze_event_handle_t *phEvent), (hEventPool, desc, phEvent))
+ZE_LAZY(zeEventDestroy, (ze_event_handle_t hEvent), (hEvent))
+ZE_LAZY(zeEventHostSignal, (ze_event_handle_t hEvent), (hEvent))
+ZE_LAZY(zeEventHostSynchronize, (ze_event_handle_t hEvent, uint64_t timeout), (hEvent, timeout))
+ZE_LAZY(zeEventQueryStatus, (ze_event_handle_t hEvent), (hEvent))
+ZE_LAZY(zeEventHostReset, (ze_event_handle_t hEvent), (hEvent))
+ZE_LAZY(zeEventQueryKernelTimestamp, (ze_event_handle_t hEvent, ze_kernel_timestamp_result_t *dstptr), (hEvent, dstptr))
+
+// Memory
+ZE_LAZY(zeMemAllocShared, (ze_context_handle_t hContext, const ze_device_mem_alloc_desc_t *deviceDesc, const ze_host_mem_alloc_desc_t *hostDesc, size_t size, size_t alignment, ze_device_handle_t hDevice, void **pptr), (hContext, deviceDesc, hostDesc, size, alignment, hDevice, pptr))
+ZE_LAZY(zeMemAllocDevice, (ze_context_handle_t hContext, const ze_device_mem_alloc_desc_t *deviceDesc, size_t size, size_t alignment, ze_device_handle_t hDevice, void **pptr), (hContext, deviceDesc, size, alignment, hDevice, pptr))
+ZE_LAZY(zeMemAllocHost, (ze_context_handle_t hContext, const ze_host_mem_alloc_desc_t *hostDesc, size_t size, size_t alignment, void **pptr), (hContext, hostDesc, size, alignment, pptr))
+ZE_LAZY(zeMemFree, (ze_context_handle_t hContext, void *ptr), (hContext, ptr))
+
+// Modules and kernels
+ZE_LAZY(zeModuleCreate, (ze_context_handle_t hContext, ze_device_handle_t hDevice, const ze_module_desc_t *desc, ze_module_handle_t *phModule, ze_module_build_log_handle_t *phBuildLog), (hContext, hDevice, desc, phModule, phBuildLog))
+ZE_LAZY(zeModuleDestroy, (ze_module_handle_t hModule), (hModule))
+ZE_LAZY(zeModuleBuildLogDestroy, (ze_module_build_log_handle_t hModuleBuildLog), (hModuleBuildLog))
+ZE_LAZY(zeModuleBuildLogGetString, (ze_module_build_log_handle_t hModuleBuildLog, size_t *pSize, char *pBuildLog), (hModuleBuildLog, pSize, pBuildLog))
+ZE_LAZY(zeKernelCreate, (ze_module_handle_t hModule, const ze_kernel_desc_t *desc, ze_kernel_handle_t *phKernel), (hModule, desc, phKernel))
+ZE_LAZY(zeKernelDestroy, (ze_kernel_handle_t hKernel), (hKernel))
+ZE_LAZY(zeKernelSetGroupSize, (ze_kernel_handle_t hKernel, uint32_t groupSizeX, uint32_t groupSizeY, uint32_t groupSizeZ), (hKernel, groupSizeX, groupSizeY, groupSizeZ))
+ZE_LAZY(zeKernelSuggestGroupSize, (ze_kernel_handle_t hKernel, uint32_t globalSizeX, uint32_t globalSizeY, uint32_t globalSizeZ, uint32_t *groupSizeX, uint32_t *groupSizeY, uint32_t *groupSizeZ), (hKernel, globalSizeX, globalSizeY, globalSizeZ, groupSizeX, groupSizeY, groupSizeZ))
+ZE_LAZY(zeKernelSetArgumentValue, (ze_kernel_handle_t hKernel, uint32_t argIndex, size_t argSize, const void *pArgValue), (hKernel, argIndex, argSize, pArgValue))
+ZE_LAZY(zeKernelSetIndirectAccess, (ze_kernel_handle_t hKernel, ze_kernel_indirect_access_flags_t flags), (hKernel, flags))
@@ -0,0 +1,111 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Conversion of device timestamps to nanoseconds, for global timestamps
+// (zeCommandListAppendWriteGlobalTimestamp) and kernel timestamp events:
+//  - timerResolution is in cycles/s when the device properties are queried with
+//    ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES_1_2 (Level Zero v1.2 and later), and in ns per cycle
+//    before that. The integer ns/cycle value is truncated (e.g., 52 instead of 52.083 for a
+//    19.2 MHz timer), so the v1.2 query is used when the driver supports it.
+//  - Only the lower timestampValidBits (global) and kernelTimestampValidBits (kernel) bits of a
+//    timestamp are valid. The difference is taken modulo 2^validBits, so an interval that
+//    crosses one wrap of the counter is still correct. Intervals longer than the wrap period
+//    (see timestampWrapNs) cannot be measured with device timestamps.
+
+#ifndef ZE_TIMESTAMPS_HPP
+#define ZE_TIMESTAMPS_HPP
+
+#include <ze_api.h>
+#include "zeValidate.hpp"
+
+#include <cstdint>
+#include <iostream>
+
+struct DeviceTimer {
+    double nsPerCycle;
+    uint64_t cyclesPerSecond;
+    uint64_t timestampMask;
+    uint64_t kernelTimestampMask;
+};
+
+// Mask of the valid bits of a timestamp (all bits if the driver does not report them)
+inline uint64_t validBitsMask(uint32_t validBits) {
+    return (validBits == 0 || validBits >= 64) ? ~0ULL : ((1ULL << validBits) - 1);
+}
+
+// From device properties queried with ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES_1_2 (only if the
+// driver supports v1.2) or with ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES. A driver older than v1.2
+// leaves the stype as set by the caller and returns ns/cycle, so properties queried with the
+// v1.2 structure without checking the API version must use the overload below instead.
+inline DeviceTimer deviceTimer(const ze_device_properties_t &deviceProperties) {
+    DeviceTimer timer;
+    if (deviceProperties.stype == ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES_1_2) {
+        timer.cyclesPerSecond = deviceProperties.timerResolution;
+        timer.nsPerCycle = 1000000000.0 / static_cast<double>(deviceProperties.timerResolution);
+    } else {
+        timer.nsPerCycle = static_cast<double>(deviceProperties.timerResolution);
+        timer.cyclesPerSecond = static_cast<uint64_t>(1000000000.0 / timer.nsPerCycle);
+    }
+    timer.timestampMask = validBitsMask(deviceProperties.timestampValidBits);
+    timer.kernelTimestampMask = validBitsMask(deviceProperties.kernelTimestampValidBits);
+    return timer;
+}
+
+// Queries the device properties with the structure of the API version of the driver
+inline DeviceTimer deviceTimer(ze_driver_handle_t driverHandle, ze_device_handle_t device) {
+    ze_api_version_t apiVersion = ZE_API_VERSION_1_0;
+    ZE_VALIDATECALL(zeDriverGetApiVersion(driverHandle, &apiVersion));
+    ze_device_properties_t deviceProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES};
+    if (apiVersion >= ZE_API_VERSION_1_2) {
+        deviceProperties.stype = ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES_1_2;
+    }
+    ZE_VALIDATECALL(zeDeviceGetProperties(device, &deviceProperties));
+    return deviceTimer(deviceProperties);
+}
+
+// Cycles from start to end, modulo 2^validBits
+inline uint64_t timestampCycles(uint64_t start, uint64_t end, uint64_t mask) {
+    return (end - start) & mask;
+}
+
+inline double cyclesToNs(const DeviceTimer &timer, uint64_t cycles) {
+    return cycles * timer.nsPerCycle;
+}
+
+// Interval between two zeCommandListAppendWriteGlobalTimestamp values
+inline double globalTimestampNs(const DeviceTimer &timer, uint64_t start, uint64_t end) {
+    return cyclesToNs(timer, timestampCycles(start, end, timer.timestampMask));
+}
+
+// Kernel execution time (context timestamps) of a kernel timestamp event
+inline double kernelTimestampNs(const DeviceTimer &timer, const ze_kernel_timestamp_result_t &timestamp) {
+    return cyclesToNs(timer, timestampCycles(timestamp.context.kernelStart, timestamp.context.kernelEnd, timer.kernelTimestampMask));
+}
+
+// Wrap period of a counter: longer intervals cannot be measured
+inline double timestampWrapNs(const DeviceTimer &timer, uint64_t mask) {
+    return (static_cast<double>(mask) + 1.0) * timer.nsPerCycle;
+}
+
+#endif
@@ -0,0 +1,54 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Error check for the Level Zero calls made by the common headers. 
+// The examples keep their own VALIDATECALL (the OpenCL backend has a VALIDATECALL for cl_int),
+// so the headers use ZE_VALIDATECALL to not depend on which one was defined first. 
+// The call is evaluated only once, also when it fails.
+
+#ifndef ZE_VALIDATE_HPP
+#define ZE_VALIDATE_HPP
+
+#include <ze_api.h>
+
+#include <exception>
+#include <iostream>
+
+#define ZE_VALIDATECALL(myZeCall) \
+    { \
+        ze_result_t zeCallResult = (myZeCall); \
+        if (zeCallResult != ZE_RESULT_SUCCESS) { \
+            std::cout << "Error at "       \
+                << #myZeCall << ": "       \
+                << __FUNCTION__ << ": "    \
+                << __LINE__ << std::endl;  \
+            std::cout << "Exit with Error Code: " \
+                << "0x" << std::hex \
+                << zeCallResult \
+                << std::dec << std::endl; \
+            std::terminate(); \
+        } \
+    }
+
+#endif
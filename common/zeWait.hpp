@@ -0,0 +1,185 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Completion-wait strategies for Level Zero submissions. For short kernels, the way the host
+// waits for the device is part of the observed latency:
+//  - queue    : zeCommandQueueSynchronize on an asynchronous queue (default in all examples)
+//  - fence    : zeFenceHostSynchronize on the fence passed at submission
+//  - spin     : busy-poll with zeEventQueryStatus on an event signaled by the last command
+//  - hybrid   : busy-poll for a time budget, then poll with short sleeps in between
+//  - sync     : synchronous queue mode. zeCommandQueueExecuteCommandLists returns when done
+
+#ifndef ZE_WAIT_HPP
+#define ZE_WAIT_HPP
+
+#include <ze_api.h>
+#include "zeValidate.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class WaitStrategy {
+    QueueSynchronize,
+    FenceHostSynchronize,
+    EventBusyPoll,
+    EventSpinThenSleep,
+    SynchronousQueue,
+};
+
+inline std::vector<WaitStrategy> allWaitStrategies() {
+    return {WaitStrategy::QueueSynchronize, WaitStrategy::FenceHostSynchronize, WaitStrategy::EventBusyPoll,
+            WaitStrategy::EventSpinThenSleep, WaitStrategy::SynchronousQueue};
+}
+
+inline const char *waitStrategyName(WaitStrategy strategy) {
+    switch (strategy) {
+        case WaitStrategy::QueueSynchronize: return "queue";
+        case WaitStrategy::FenceHostSynchronize: return "fence";
+        case WaitStrategy::EventBusyPoll: return "spin";
+        case WaitStrategy::EventSpinThenSleep: return "hybrid";
+        case WaitStrategy::SynchronousQueue: return "sync";
+    }
+    return "unknown";
+}
+
+inline bool parseWaitStrategy(const std::string &name, WaitStrategy &strategy) {
+    for (auto s : allWaitStrategies()) {
+        if (name == waitStrategyName(s)) {
+            strategy = s;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Mode to use when creating the command queue for a given strategy
+inline ze_command_queue_mode_t queueModeFor(WaitStrategy strategy) {
+    return (strategy == WaitStrategy::SynchronousQueue) ? ZE_COMMAND_QUEUE_MODE_SYNCHRONOUS : ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
+}
+
+// Submits a command list and waits for it following one strategy. For the event-based
+// strategies, the command list must signal completionEvent() with its last command
+// (e.g., as the signal event of the kernel launch). For the rest, completionEvent()
+// returns nullptr, which can be passed to Level Zero as "no event".
+class ZeCompletionWaiter {
+public:
+    ZeCompletionWaiter(WaitStrategy strategy, ze_context_handle_t context, ze_device_handle_t device,
+                       ze_command_queue_handle_t cmdQueue, uint64_t spinBudgetNs = 50000, uint64_t sleepNs = 5000)
+        : strategy(strategy), cmdQueue(cmdQueue), fence(nullptr), eventPool(nullptr), event(nullptr),
+          spinBudgetNs(spinBudgetNs), sleepNs(sleepNs) {
+
+        if (strategy == WaitStrategy::FenceHostSynchronize) {
+            ze_fence_desc_t fenceDesc = {ZE_STRUCTURE_TYPE_FENCE_DESC};
+            ZE_VALIDATECALL(zeFenceCreate(cmdQueue, &fenceDesc, &fence));
+        } else if (strategy == WaitStrategy::EventBusyPoll || strategy == WaitStrategy::EventSpinThenSleep) {
+            ze_event_pool_desc_t eventPoolDesc = {ZE_STRUCTURE_TYPE_EVENT_POOL_DESC};
+            eventPoolDesc.count = 1;
+            eventPoolDesc.flags = ZE_EVENT_POOL_FLAG_HOST_VISIBLE;
+            ZE_VALIDATECALL(zeEventPoolCreate(context, &eventPoolDesc, 1, &device, &eventPool));
+            ze_event_desc_t eventDesc = {ZE_STRUCTURE_TYPE_EVENT_DESC};
+            eventDesc.index = 0;
+            eventDesc.signal = ZE_EVENT_SCOPE_FLAG_HOST;
+            eventDesc.wait = ZE_EVENT_SCOPE_FLAG_HOST;
+            ZE_VALIDATECALL(zeEventCreate(eventPool, &eventDesc, &event));
+        }
+    }
+
+    ~ZeCompletionWaiter() {
+        if (fence != nullptr) {
+            zeFenceDestroy(fence);
+        }
+        if (event != nullptr) {
+            zeEventDestroy(event);
+            zeEventPoolDestroy(eventPool);
+        }
+    }
+
+    ZeCompletionWaiter(const ZeCompletionWaiter &) = delete;
+    ZeCompletionWaiter &operator=(const ZeCompletionWaiter &) = delete;
+
+    ze_event_handle_t completionEvent() const {
+        return event;
+    }
+
+    void submitAndWait(ze_command_list_handle_t cmdList) {
+        switch (strategy) {
+            case WaitStrategy::QueueSynchronize:
+                ZE_VALIDATECALL(zeCommandQueueExecuteCommandLists(cmdQueue, 1, &cmdList, nullptr));
+                ZE_VALIDATECALL(zeCommandQueueSynchronize(cmdQueue, std::numeric_limits<uint64_t>::max()));
+                break;
+            case WaitStrategy::FenceHostSynchronize:
+                ZE_VALIDATECALL(zeFenceReset(fence));
+                ZE_VALIDATECALL(zeCommandQueueExecuteCommandLists(cmdQueue, 1, &cmdList, fence));
+                ZE_VALIDATECALL(zeFenceHostSynchronize(fence, std::numeric_limits<uint64_t>::max()));
+                break;
+            case WaitStrategy::EventBusyPoll:
+                ZE_VALIDATECALL(zeEventHostReset(event));
+                ZE_VALIDATECALL(zeCommandQueueExecuteCommandLists(cmdQueue, 1, &cmdList, nullptr));
+                while (!eventSignaled()) {
+                    // spin
+                }
+                break;
+            case WaitStrategy::EventSpinThenSleep: {
+                ZE_VALIDATECALL(zeEventHostReset(event));
+                ZE_VALIDATECALL(zeCommandQueueExecuteCommandLists(cmdQueue, 1, &cmdList, nullptr));
+                auto begin = std::chrono::steady_clock::now();
+                auto budget = std::chrono::nanoseconds(spinBudgetNs);
+                while (!eventSignaled()) {
+                    if (std::chrono::steady_clock::now() - begin > budget) {
+                        std::this_thread::sleep_for(std::chrono::nanoseconds(sleepNs));
+                    }
+                }
+                break;
+            }
+            case WaitStrategy::SynchronousQueue:
+                // The call returns once the command list has been executed
+                ZE_VALIDATECALL(zeCommandQueueExecuteCommandLists(cmdQueue, 1, &cmdList, nullptr));
+                break;
+        }
+    }
+
+private:
+    bool eventSignaled() {
+        ze_result_t status = zeEventQueryStatus(event);
+        if (status == ZE_RESULT_NOT_READY) {
+            return false;
+        }
+        ZE_VALIDATECALL(status);
+        return true;
+    }
+
+    WaitStrategy strategy;
+    ze_command_queue_handle_t cmdQueue;
+    ze_fence_handle_t fence;
+    ze_event_pool_handle_t eventPool;
+    ze_event_handle_t event;
+    uint64_t spinBudgetNs;
+    uint64_t sleepNs;
+};
+
+#endif
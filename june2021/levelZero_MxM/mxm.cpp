@@ -3,6 +3,7 @@
 //      https://github.com/intel/compute-runtime/blob/master/level_zero/core/test/black_box_tests/zello_world_gpu.cpp
 
 #include "ze_api.h"
+#include "phaseTimer.hpp"
 
 #include <chrono>
 #include <cstring>
@@ -41,6 +42,7 @@ void matrixMultply(uint32_t *a, uint32_t *b, uint32_t *c, int n) {
 int main(int argc, char **argv) {
 
     // Initialization
+    PhaseTimer initTimer("init");
     VALIDATECALL(zeInit(ZE_INIT_FLAG_GPU_ONLY));
 
     // Get the driver
@@ -99,6 +101,7 @@ int main(int argc, char **argv) {
     ze_command_list_desc_t cmdListDesc = {};
     cmdListDesc.commandQueueGroupOrdinal = cmdQueueDesc.ordinal;    
     VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &cmdList));
+    initTimer.stop();
 
     // Create two buffers
     const uint32_t items = 1024;
@@ -111,6 +114,7 @@ int main(int argc, char **argv) {
     //hostDesc.flags = ZE_HOST_MEM_ALLOC_FLAG_BIAS_UNCACHED;
 
 
+    PhaseTimer allocTimer("alloc");
     void *sharedA = nullptr;
     VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 1, device, &sharedA));
 
@@ -120,13 +124,18 @@ int main(int argc, char **argv) {
     void *dstResult = nullptr;
     VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 1, device, &dstResult));
 
+    allocTimer.stop();
+
     // memory initialization
+    PhaseTimer hostInitTimer("host-init");
     constexpr uint8_t val = 2;
     memset(sharedA, val, allocSize);
     memset(sharedB, 3, allocSize);
     memset(dstResult, 0, allocSize);
+    hostInitTimer.stop();
 
     // Module Initialization
+    PhaseTimer moduleTimer("module");
     ze_module_handle_t module = nullptr;
     ze_kernel_handle_t kernel = nullptr;
 
@@ -188,20 +197,24 @@ int main(int argc, char **argv) {
         VALIDATECALL(zeCommandListAppendLaunchKernel(cmdList, kernel, &dispatch, nullptr, 0, nullptr));
 
         file.close();
+        moduleTimer.stop();
     } else {
         std::cout << "SPIR-V binary file not found\n";
         std::terminate();
     }
 
+    PhaseTimer kernelTimer("kernel");
     std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
     // Close list abd submit for execution
     VALIDATECALL(zeCommandListClose(cmdList));
     VALIDATECALL(zeCommandQueueExecuteCommandLists(cmdQueue, 1, &cmdList, nullptr));    
     VALIDATECALL(zeCommandQueueSynchronize(cmdQueue, std::numeric_limits<uint64_t>::max()));
     std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    kernelTimer.stop();
 
 
     // Validate
+    PhaseTimer validationTimer("validation");
     bool outputValidationSuccessful = true;
 
     uint32_t *resultSeq = (uint32_t *)malloc(allocSize);
@@ -231,9 +244,11 @@ int main(int argc, char **argv) {
     }
 
 
+    validationTimer.stop();
     std::cout << "\nMatrix Multiply validation " << (outputValidationSuccessful ? "PASSED" : "FAILED") << "\n";
 
     // Cleanup
+    PHASE_TIMER("cleanup");
     VALIDATECALL(zeMemFree(context, dstResult));
     VALIDATECALL(zeMemFree(context, sharedA));
     VALIDATECALL(zeMemFree(context, sharedB));
@@ -27,6 +27,10 @@
 //      https://github.com/intel/compute-runtime/blob/master/level_zero/core/test/black_box_tests/zello_timestamp.cpp
 
 #include <ze_api.h>
+#include "phaseTimer.hpp"
+#include "parallelInit.hpp"
+#include "hugePages.hpp"
+#include "zeTimestamps.hpp"
 
 #include <chrono>
 #include <cstring>
@@ -77,10 +81,12 @@ int main(int argc, char **argv) {
     // "d" : device
     // "c" : combined (host/device)
     // "h" : host
+    // "z" : zero-copy on heap memory (shared-system USM)
     bool use_shared_memory = false;
     bool use_device_memory = false;
     bool use_combined_host_device_memory = false;
     bool use_host_only_memory = false;
+    bool use_system_memory = false;
     if ( version == "s" ) {
         // Shared memory
         std::cout << "Using Shared Memory" << std::endl;
@@ -98,10 +104,16 @@ int main(int argc, char **argv) {
         // Host Only memory
         std::cout << "Using Host ONLY Memory" << std::endl;
         use_host_only_memory = true;
+    } else if ( version == "z" ) {
+        // Heap memory (malloc) passed directly to the kernel, if the device supports shared-system
+        // allocations. Managed runtimes could then use their own heap without any copies.
+        std::cout << "Using System (heap) Memory" << std::endl;
+        use_system_memory = true;
     }
 
 
     // Initialization
+    PhaseTimer initTimer("init");
     VALIDATECALL(zeInit(ZE_INIT_FLAG_GPU_ONLY));
 
     // Get the driver
@@ -131,6 +143,22 @@ int main(int argc, char **argv) {
               << "Type     : " << ((deviceProperties.type == ZE_DEVICE_TYPE_GPU) ? "GPU" : "FPGA") << "\n"
               << "Vendor ID: " << std::hex << deviceProperties.vendorId << std::dec << "\n";
 
+    if (use_system_memory) {
+        // Shared-system allocations: any pointer from malloc/new is accessible by the device.
+        // Otherwise, fall back to the device version, which copies the heap buffers directly
+        // to device memory (one copy each way, instead of two through host USM as in "c").
+        ze_device_memory_access_properties_t accessProperties = {ZE_STRUCTURE_TYPE_DEVICE_MEMORY_ACCESS_PROPERTIES};
+        VALIDATECALL(zeDeviceGetMemoryAccessProperties(device, &accessProperties));
+        if (accessProperties.sharedSystemAllocCapabilities & ZE_MEMORY_ACCESS_CAP_FLAG_RW) {
+            std::cout << "ZERO-COPY: supported (sharedSystemAllocCapabilities=0x" << std::hex 
+                      << accessProperties.sharedSystemAllocCapabilities << std::dec << ")" << std::endl;
+        } else {
+            std::cout << "ZERO-COPY: not supported, fall back to heap -> device copies" << std::endl;
+            use_system_memory = false;
+            use_device_memory = true;
+        }
+    }
+
     // Create a command queue
     uint32_t numQueueGroups = 0;
     VALIDATECALL(zeDeviceGetCommandQueueGroupProperties(device, &numQueueGroups, nullptr));
@@ -160,6 +188,7 @@ int main(int argc, char **argv) {
     ze_command_list_desc_t cmdListDesc = {};
     cmdListDesc.commandQueueGroupOrdinal = cmdQueueDesc.ordinal;    
     VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &cmdList));
+    initTimer.stop();
 
 
     ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
@@ -184,6 +213,7 @@ int main(int argc, char **argv) {
     hostDesc.pNext = &exceedCapacity;
     memAllocDesc.pNext = &exceedCapacity;
 
+    PhaseTimer allocTimer("alloc");
     if (use_shared_memory) {  
         std::cout << "Allocating Shared Memory: " << allocSize << " bytes - " << (allocSize * 1e-9 ) << " (GB) " << std::endl;
         result = zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 128, device, &computeBufferA);
@@ -229,31 +259,55 @@ int main(int argc, char **argv) {
         checkMemoryError(result);
     }
 
-    void *deviceBuffer = nullptr;
-    void *hostBuffer = nullptr;
     int *heapBuffer = nullptr;
     int *resultBuffer = nullptr;
+    // Heap buffers of the "d" and "z" versions. HUGE_PAGES=thp|2M|1G backs the "d" ones with huge pages
+    HostPages heapPages = {};
+    HostPages resultPages = {};
+    if (use_system_memory) {
+        std::cout << "Allocating System Memory: " << allocSize << " bytes - " << (allocSize * 1e-9 ) << " (GB) " << std::endl;
+        heapPages = allocHostPages(allocSize, HostPageMode::NORMAL);
+        resultPages = allocHostPages(allocSize, HostPageMode::NORMAL);
+        heapBuffer = static_cast<int *>(heapPages.ptr);
+        resultBuffer = static_cast<int *>(resultPages.ptr);
+    }
+
+    allocTimer.stop();
+
+    void *deviceBuffer = nullptr;
+    void *hostBuffer = nullptr;
 
+    PhaseTimer hostInitTimer("host-init");
+    int firstTouch = firstTouchNode(device);
     if (use_shared_memory) {
         // memory initialization
         constexpr uint8_t val = 100;
         int32_t *srcCharBufferInit = static_cast<int32_t *>(computeBufferA);
-        for (size_t i = 0; i < items; i++) {
-            srcCharBufferInit[i] = 100;
-        }
+        parallelFill(srcCharBufferInit, items, 100, firstTouch);
     } else if (use_device_memory) {
-        heapBuffer = new int[items];
-        resultBuffer = new int[items];
-        for (size_t i = 0; i < items; i++) {
-            heapBuffer[i] = 100;
+        HostPageMode pageMode = hostPageModeFromEnv();
+        heapPages = allocHostPages(allocSize, pageMode);
+        resultPages = allocHostPages(allocSize, pageMode);
+        heapBuffer = static_cast<int *>(heapPages.ptr);
+        resultBuffer = static_cast<int *>(resultPages.ptr);
+        parallelFill(heapBuffer, items, 100, firstTouch);
+        // The result buffer is only pre-faulted with huge pages, so the page size is in place
+        // before the copy back. With 4KB pages it is left untouched, as in the original version
+        if (pageMode != HostPageMode::NORMAL) {
+            parallelFill(resultBuffer, items, 0, firstTouch);
         }
+        std::cout << "HEAP-PAGES: " << hostPageModeName(heapPages.mode) 
+                  << " (" << hugePageBackedBytes(heapBuffer) << " bytes backed by huge pages)" << std::endl;
+    } else if (use_system_memory) {
+        parallelFill(heapBuffer, items, 100, firstTouch);
     } else if (use_combined_host_device_memory || use_host_only_memory) {
-         for (size_t i = 0; i < items; ++i) {
-            hostBufferA[i] = static_cast<int>(100);
-        }
+        parallelFill(hostBufferA, items, 100, firstTouch);
     }
 
+    hostInitTimer.stop();
+
     // Module Initialization
+    PhaseTimer moduleTimer("module");
     ze_module_handle_t module = nullptr;
     ze_kernel_handle_t kernel = nullptr;
 
@@ -289,6 +343,7 @@ int main(int argc, char **argv) {
     ze_kernel_desc_t kernelDesc = {};
     kernelDesc.pKernelName = "vectorAddition";
     VALIDATECALL(zeKernelCreate(module, &kernelDesc, &kernel));
+    moduleTimer.stop();
 
     void *timeStampStartOut = nullptr;
     void *timeStampStopOut = nullptr;
@@ -300,6 +355,9 @@ int main(int argc, char **argv) {
     uint64_t firstIteration = 0;
     uint64_t lastIteration = 0;
 
+    // The copies in/out are recorded in the same command list as the kernel, so the 
+    // transfers are included in this phase
+    PhaseTimer kernelTimer("kernel");
     for (int i = 0; i < 10; i++) {
 
         auto begin = std::chrono::steady_clock::now();
@@ -324,6 +382,9 @@ int main(int argc, char **argv) {
         if (use_host_only_memory) {
             VALIDATECALL(zeKernelSetArgumentValue(kernel, 0, sizeof(hostBufferA), &hostBufferA));
             VALIDATECALL(zeKernelSetArgumentValue(kernel, 1, sizeof(hostBufferB), &hostBufferB));
+        } else if (use_system_memory) {
+            VALIDATECALL(zeKernelSetArgumentValue(kernel, 0, sizeof(heapBuffer), &heapBuffer));
+            VALIDATECALL(zeKernelSetArgumentValue(kernel, 1, sizeof(resultBuffer), &resultBuffer));
         } else {
             VALIDATECALL(zeKernelSetArgumentValue(kernel, 0, sizeof(computeBufferA), &computeBufferA));
             VALIDATECALL(zeKernelSetArgumentValue(kernel, 1, sizeof(computeBufferB), &computeBufferB));
@@ -363,13 +424,10 @@ int main(int argc, char **argv) {
         auto elapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
         std::cout << "C++-Timer: " << elapsedTime << " [ns]" << std::endl;
 
-        ze_device_properties_t devProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES};  
-        VALIDATECALL(zeDeviceGetProperties(device, &devProperties));
+        DeviceTimer timer = deviceTimer(driverHandle, device);
 
-        uint64_t copyOutDuration = timeStopOut - timeStartOut;
-        uint64_t timerResolution = devProperties.timerResolution;
-        uint64_t total =  copyOutDuration * timerResolution;
-        std::cout << "GPU-Timer    : " << copyOutDuration * timerResolution << " [ns]\n";
+        uint64_t total = static_cast<uint64_t>(globalTimestampNs(timer, timeStartOut, timeStopOut));
+        std::cout << "GPU-Timer    : " << total << " [ns]\n";
  
         // Reset command list
         VALIDATECALL(zeCommandListReset(cmdList));
@@ -381,10 +439,18 @@ int main(int argc, char **argv) {
         }
     }
 
+    kernelTimer.stop();
+
     std::cout << "TIMER-FIRST-ITERATION: " << firstIteration << std::endl;
     std::cout << "TIMER-LAST-ITERATION: " << lastIteration << std::endl;
+    if (use_device_memory && lastIteration > 0) {
+        // Heap->Device + Device->Heap copies of the last iteration (kernel time included)
+        std::cout << "HEAP-BANDWIDTH-" << hostPageModeName(heapPages.mode) << ": " 
+                  << (2.0 * allocSize) / lastIteration << " GB/s" << std::endl;
+    }
 
     // Validate
+    PhaseTimer validationTimer("validation");
     bool outputValidationSuccessful = true;
     if (use_shared_memory) {
         int32_t *srcCharBuffer = static_cast<int32_t *>(computeBufferA);
@@ -396,7 +462,7 @@ int main(int argc, char **argv) {
                 break;
             }
         }
-    } else if (use_device_memory) {
+    } else if (use_device_memory || use_system_memory) {
         for (size_t i = 0; i < items; i++) {
             //std::cout << resultBuffer[i] << std::endl;
             if (resultBuffer[i] != (heapBuffer[i] + 100)) {
@@ -414,9 +480,14 @@ int main(int argc, char **argv) {
         }
     }
 
+    validationTimer.stop();
+
     std::cout << "\nResults validation " << (outputValidationSuccessful ? "PASSED" : "FAILED") << "\n";
 
     // Cleanup
+    PHASE_TIMER("cleanup");
+    freeHostPages(heapPages);
+    freeHostPages(resultPages);
     if (computeBufferA != nullptr) {
         VALIDATECALL(zeMemFree(context, computeBufferA));
     }
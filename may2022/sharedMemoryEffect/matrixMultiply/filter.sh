@@ -12,3 +12,6 @@ cat COMBINED_DEVICE_HOST.log | grep ${keyword} | awk '{print $2}'
 
 echo "HOST_ONLY"
 cat HOST.log | grep ${keyword} | awk '{print $2}'
+
+echo "SYSTEM"
+cat SYSTEM.log | grep ${keyword} | awk '{print $2}'
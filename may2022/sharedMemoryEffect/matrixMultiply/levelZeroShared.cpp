@@ -27,6 +27,9 @@
 //      https://github.com/intel/compute-runtime/blob/master/level_zero/core/test/black_box_tests/zello_timestamp.cpp
 
 #include <ze_api.h>
+#include "phaseTimer.hpp"
+#include "parallelInit.hpp"
+#include "zeTimestamps.hpp"
 
 #include <chrono>
 #include <cstring>
@@ -91,10 +94,12 @@ int main(int argc, char **argv) {
     // "d" : device
     // "c" : combined (host/device)
     // "h" : host
+    // "z" : zero-copy on heap memory (shared-system USM)
     bool use_shared_memory = false;
     bool use_device_memory = false;
     bool use_combined_host_device_memory = false;
     bool use_host_only_memory = false;
+    bool use_system_memory = false;
     if ( version == "s" ) {
         // Shared memory
         std::cout << "Using Shared Memory" << std::endl;
@@ -112,9 +117,15 @@ int main(int argc, char **argv) {
         // Host Only memory
         std::cout << "Using Host ONLY Memory" << std::endl;
         use_host_only_memory = true;
+    } else if ( version == "z" ) {
+        // Heap memory (new) passed directly to the kernel, if the device supports shared-system
+        // allocations. Managed runtimes could then use their own heap without any copies.
+        std::cout << "Using System (heap) Memory" << std::endl;
+        use_system_memory = true;
     }
 
     // Initialization
+    PhaseTimer initTimer("init");
     VALIDATECALL(zeInit(ZE_INIT_FLAG_GPU_ONLY));
 
     // Get the driver
@@ -143,6 +154,22 @@ int main(int argc, char **argv) {
     std::cout << "Device   : " << deviceProperties.name << "\n" 
               << "Type     : " << ((deviceProperties.type == ZE_DEVICE_TYPE_GPU) ? "GPU" : "FPGA") << "\n";
 
+    if (use_system_memory) {
+        // Shared-system allocations: any pointer from malloc/new is accessible by the device.
+        // Otherwise, fall back to the device version, which copies the heap buffers directly
+        // to device memory (one copy each way, instead of two through host USM as in "c").
+        ze_device_memory_access_properties_t accessProperties = {ZE_STRUCTURE_TYPE_DEVICE_MEMORY_ACCESS_PROPERTIES};
+        VALIDATECALL(zeDeviceGetMemoryAccessProperties(device, &accessProperties));
+        if (accessProperties.sharedSystemAllocCapabilities & ZE_MEMORY_ACCESS_CAP_FLAG_RW) {
+            std::cout << "ZERO-COPY: supported (sharedSystemAllocCapabilities=0x" << std::hex 
+                      << accessProperties.sharedSystemAllocCapabilities << std::dec << ")" << std::endl;
+        } else {
+            std::cout << "ZERO-COPY: not supported, fall back to heap -> device copies" << std::endl;
+            use_system_memory = false;
+            use_device_memory = true;
+        }
+    }
+
     // Create a command queue
     uint32_t numQueueGroups = 0;
     VALIDATECALL(zeDeviceGetCommandQueueGroupProperties(device, &numQueueGroups, nullptr));
@@ -172,6 +199,7 @@ int main(int argc, char **argv) {
     ze_command_list_desc_t cmdListDesc = {};
     cmdListDesc.commandQueueGroupOrdinal = cmdQueueDesc.ordinal;    
     VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &cmdList));
+    initTimer.stop();
 
 
     ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
@@ -195,9 +223,13 @@ int main(int argc, char **argv) {
     int *hostBufferA = nullptr;
     int *hostBufferB = nullptr;
     int *hostBufferC = nullptr;
+    int *heapBufferA = nullptr;
+    int *heapBufferB = nullptr;
+    int *heapBufferC = nullptr;
     hostDesc.pNext = &exceedCapacity;
     memAllocDesc.pNext = &exceedCapacity;
 
+    PhaseTimer allocTimer("alloc");
     if (use_shared_memory) {  
         std::cout << "Allocating Shared Memory: " << allocSize << " bytes - " << (allocSize * 1e-9 ) << " (GB) " << std::endl;
         result = zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 128, device, &computeBufferA);
@@ -262,15 +294,20 @@ int main(int argc, char **argv) {
         std::cout << "Allocating Host Only Memory: " << allocSize << " bytes - " << (allocSize * 1e-9 ) << " (GB) " << std::endl;
         result = zeMemAllocHost(context, &hostDesc, allocSize, 64, &hostBufferC);
         checkMemoryError(result);
+    } else if (use_system_memory) {
+        std::cout << "Allocating System Memory: " << allocSize << " bytes - " << (allocSize * 1e-9 ) << " (GB) " << std::endl;
+        heapBufferA = new int[N * N];
+        heapBufferB = new int[N * N];
+        heapBufferC = new int[N * N];
     }
 
+    allocTimer.stop();
+
     void *deviceBuffer = nullptr;
     void *hostBuffer = nullptr;
-    int *heapBufferA = nullptr;
-    int *heapBufferB = nullptr;
-    int *heapBufferC = nullptr;
 
     // memory initialization
+    PhaseTimer hostInitTimer("host-init");
     if (use_shared_memory) {
         int32_t *srcCharBufferInitA = static_cast<int32_t *>(computeBufferA);
         int32_t *srcCharBufferInitB = static_cast<int32_t *>(computeBufferB);
@@ -290,6 +327,11 @@ int main(int argc, char **argv) {
                 heapBufferB[i * N + j] = 2;
             }
         }
+    } else if (use_system_memory) {
+        // The device reads the heap buffers in place, so place their pages next to it
+        int firstTouch = firstTouchNode(device);
+        parallelFill(heapBufferA, N * N, 2, firstTouch);
+        parallelFill(heapBufferB, N * N, 2, firstTouch);
     } else if (use_combined_host_device_memory || use_host_only_memory) {
          for (size_t i = 0; i < N; ++i) {
              for (size_t j = 0; j < N; j++) {
@@ -299,7 +341,10 @@ int main(int argc, char **argv) {
         }
     }
 
+    hostInitTimer.stop();
+
     // Module Initialization
+    PhaseTimer moduleTimer("module");
     ze_module_handle_t module = nullptr;
     ze_kernel_handle_t kernel = nullptr;
 
@@ -335,6 +380,7 @@ int main(int argc, char **argv) {
     ze_kernel_desc_t kernelDesc = {};
     kernelDesc.pKernelName = "mxm";
     VALIDATECALL(zeKernelCreate(module, &kernelDesc, &kernel));
+    moduleTimer.stop();
 
     void *timeStampStartOut = nullptr;
     void *timeStampStopOut = nullptr;
@@ -346,6 +392,9 @@ int main(int argc, char **argv) {
     uint64_t firstIteration = 0;
     uint64_t lastIteration = 0;
 
+    // The copies in/out are recorded in the same command list as the kernel, so the 
+    // transfers are included in this phase
+    PhaseTimer kernelTimer("kernel");
     for (int i = 0; i < MAX_ITERATIONS; i++) {
 
         auto begin = std::chrono::steady_clock::now();
@@ -373,6 +422,11 @@ int main(int argc, char **argv) {
             VALIDATECALL(zeKernelSetArgumentValue(kernel, 1, sizeof(hostBufferB), &hostBufferB));
             VALIDATECALL(zeKernelSetArgumentValue(kernel, 2, sizeof(hostBufferC), &hostBufferC));
             VALIDATECALL(zeKernelSetArgumentValue(kernel, 3, sizeof(int), &N));
+        } else if (use_system_memory) {
+            VALIDATECALL(zeKernelSetArgumentValue(kernel, 0, sizeof(heapBufferA), &heapBufferA));
+            VALIDATECALL(zeKernelSetArgumentValue(kernel, 1, sizeof(heapBufferB), &heapBufferB));
+            VALIDATECALL(zeKernelSetArgumentValue(kernel, 2, sizeof(heapBufferC), &heapBufferC));
+            VALIDATECALL(zeKernelSetArgumentValue(kernel, 3, sizeof(int), &N));
         } else {
             VALIDATECALL(zeKernelSetArgumentValue(kernel, 0, sizeof(computeBufferA), &computeBufferA));
             VALIDATECALL(zeKernelSetArgumentValue(kernel, 1, sizeof(computeBufferB), &computeBufferB));
@@ -412,12 +466,9 @@ int main(int argc, char **argv) {
         auto elapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
         std::cout << "C++-Timer: " << elapsedTime << " [ns]" << std::endl;
 
-        ze_device_properties_t devProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES};  
-        VALIDATECALL(zeDeviceGetProperties(device, &devProperties));
+        DeviceTimer timer = deviceTimer(driverHandle, device);
 
-        uint64_t copyOutDuration = timeStopOut - timeStartOut;
-        uint64_t timerResolution = devProperties.timerResolution;
-        uint64_t total =  copyOutDuration * timerResolution;
+        uint64_t total = static_cast<uint64_t>(globalTimestampNs(timer, timeStartOut, timeStopOut));
         std::cout << "GPU-Timer    : " << total << " [ns]\n";
 
         if (i == 0) {
@@ -430,12 +481,15 @@ int main(int argc, char **argv) {
         VALIDATECALL(zeCommandListReset(cmdList));
     }
 
+    kernelTimer.stop();
+
     std::cout << "TIMER-FIRST-ITERATION: " << firstIteration << std::endl;
     std::cout << "TIMER-LAST-ITERATION: " << lastIteration << std::endl;
 
 
     if (VALIDATE) {
     // Validate
+    PHASE_TIMER("validation");
     bool outputValidationSuccessful = true;
     if (use_shared_memory) {
 
@@ -454,7 +508,7 @@ int main(int argc, char **argv) {
                 }
             }
         }
-    } else if (use_device_memory) {
+    } else if (use_device_memory || use_system_memory) {
         
         int32_t *resultSeq = (uint32_t *)malloc(allocSize);
 
@@ -488,6 +542,7 @@ int main(int argc, char **argv) {
     }
 
     // Cleanup
+    PHASE_TIMER("cleanup");
     if (computeBufferA != nullptr) {
         VALIDATECALL(zeMemFree(context, computeBufferA));
     }
@@ -506,6 +561,9 @@ int main(int argc, char **argv) {
     if (hostBufferB != nullptr) {
         VALIDATECALL(zeMemFree(context, hostBufferB));
     }
+    delete[] heapBufferA;
+    delete[] heapBufferB;
+    delete[] heapBufferC;
     VALIDATECALL(zeCommandListDestroy(cmdList));
     VALIDATECALL(zeCommandQueueDestroy(cmdQueue));
     VALIDATECALL(zeContextDestroy(context));
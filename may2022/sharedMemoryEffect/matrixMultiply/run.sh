@@ -29,3 +29,10 @@ do
     echo "Running with Size: ${size}"
     ./levelZeroShared h $size >> HOST.log
 done
+
+#### Run with System (heap) Memory: zero-copy if the device supports shared-system allocations
+for size in ${sizes[@]}
+do
+    echo "Running with Size: ${size}"
+    ./levelZeroShared z $size >> SYSTEM.log
+done
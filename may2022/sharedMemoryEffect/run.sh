@@ -17,6 +17,13 @@ do
     ./levelZeroShared d $size >> DEVICE.log
 done
 
+#### Run with Device Memory, heap buffers backed by transparent huge pages
+for size in ${sizes[@]}
+do
+    echo "Running with Size: ${size}"
+    HUGE_PAGES=thp ./levelZeroShared d $size >> DEVICE_THP.log
+done
+
 #### Run with Combined Device/Host Memory
 for size in ${sizes[@]}
 do
@@ -31,3 +38,9 @@ do
     ./levelZeroShared h $size >> HOST.log
 done
 
+#### Run with System (heap) Memory: zero-copy if the device supports shared-system allocations
+for size in ${sizes[@]}
+do
+    echo "Running with Size: ${size}"
+    ./levelZeroShared z $size >> SYSTEM.log
+done
@@ -0,0 +1,3 @@
+
+clang -cc1 -triple spir touchPages.cl -O2 -finclude-default-header -emit-llvm-bc -o touchPages.bc
+llvm-spirv touchPages.bc -o touchPages.spv
@@ -0,0 +1,344 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Page-migration cost of shared allocations (zeMemAllocShared) depending on who touches the
+// pages first and on the order in which pages are visited:
+//  1. HOST-FIRST->DEVICE : the host initializes the buffer, then the device touches every page
+//  2. DEVICE-RESIDENT    : the device touches the pages again (no migration, reference)
+//  3. DEVICE->HOST       : the host touches every page after the device
+//  4. DEVICE-FIRST       : first touch of a new buffer on the device (no data to migrate)
+//  5. DEVICE-FIRST->HOST : the host touches the pages after the device first touch
+//  6. PING-PONG          : device pass + host pass on every iteration
+// The buffer is split in blocks of 4KB, 64KB or 2MB, and the blocks are visited in sequential,
+// strided or random order. Inside a block, every 4KB page is touched (one int per page), so the
+// whole buffer has to migrate whatever the migration granularity of the driver is, and the
+// throughput is the buffer size over the time. The block size only changes the access order.
+
+#include <ze_api.h>
+#include "benchStats.hpp"
+#include "phaseTimer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#define PING_PONG_ITERATIONS 10
+#define STRIDE_BLOCKS 16
+#define PAGE_SIZE 4096
+
+#define VALIDATECALL(myZeCall) \
+    if (myZeCall != ZE_RESULT_SUCCESS){ \
+        std::cout << "Error at "       \
+            << #myZeCall << ": "       \
+            << __FUNCTION__ << ": "    \
+            << __LINE__ << std::endl;  \
+        std::cout << "Exit with Error Code: " \
+            << "0x" << std::hex \
+            << myZeCall \
+            << std::dec << std::endl; \
+        std::terminate(); \
+    }
+
+void init(ze_driver_handle_t &driverHandle, ze_context_handle_t &context, ze_device_handle_t &device ) {
+    // Initialization
+    VALIDATECALL(zeInit(ZE_INIT_FLAG_GPU_ONLY));
+
+    // Get the driver
+    uint32_t driverCount = 1;
+    VALIDATECALL(zeDriverGet(&driverCount, &driverHandle));
+
+    // Create the context
+    ze_context_desc_t contextDescription = {};
+    contextDescription.stype = ZE_STRUCTURE_TYPE_CONTEXT_DESC;
+    VALIDATECALL(zeContextCreate(driverHandle, &contextDescription, &context));
+
+    // Get the device
+    uint32_t deviceCount = 1;
+    VALIDATECALL(zeDeviceGet(driverHandle, &deviceCount, &device));
+}
+
+void printBasicInfo(ze_device_handle_t device) {
+    // Print basic properties of the device
+    ze_device_properties_t deviceProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES};
+    VALIDATECALL(zeDeviceGetProperties(device, &deviceProperties));
+    std::cout << "Device   : " << deviceProperties.name << "\n" 
+              << "Type     : " << ((deviceProperties.type == ZE_DEVICE_TYPE_GPU) ? "GPU" : "FPGA") << "\n"
+              << "Vendor ID: " << std::hex << deviceProperties.vendorId << std::dec << "\n";
+}
+
+uint32_t createCommandQueue(ze_device_handle_t device, ze_context_handle_t context, ze_command_queue_handle_t &cmdQueue) {
+    // Create a command queue
+    uint32_t numQueueGroups = 0;
+    VALIDATECALL(zeDeviceGetCommandQueueGroupProperties(device, &numQueueGroups, nullptr));
+    if (numQueueGroups == 0) {
+        std::cout << "No queue groups found\n";
+        std::terminate();
+    }
+    std::vector<ze_command_queue_group_properties_t> queueProperties(numQueueGroups);
+    VALIDATECALL(zeDeviceGetCommandQueueGroupProperties(device, &numQueueGroups, queueProperties.data()));
+
+    ze_command_queue_desc_t cmdQueueDesc = {ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC};
+    for (uint32_t i = 0; i < numQueueGroups; i++) { 
+        if (queueProperties[i].flags & ZE_COMMAND_QUEUE_GROUP_PROPERTY_FLAG_COMPUTE) {
+            cmdQueueDesc.ordinal = i;
+        }
+    }
+
+    cmdQueueDesc.index = 0;
+    cmdQueueDesc.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
+    VALIDATECALL(zeCommandQueueCreate(context, device, &cmdQueueDesc, &cmdQueue));
+
+    return cmdQueueDesc.ordinal;
+}
+
+ze_kernel_handle_t createTouchKernel(ze_context_handle_t context, ze_device_handle_t device, ze_module_handle_t &module) {
+    std::ifstream file("touchPages.spv", std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "SPIR-V binary file not found\n";
+        std::terminate();
+    }
+    file.seekg(0, file.end);
+    auto length = file.tellg();
+    file.seekg(0, file.beg);
+
+    std::unique_ptr<char[]> spirvInput(new char[length]);
+    file.read(spirvInput.get(), length);
+    file.close();
+
+    ze_module_desc_t moduleDesc = {ZE_STRUCTURE_TYPE_MODULE_DESC};
+    ze_module_build_log_handle_t buildLog;
+    moduleDesc.format = ZE_MODULE_FORMAT_IL_SPIRV;
+    moduleDesc.pInputModule = reinterpret_cast<const uint8_t *>(spirvInput.get());
+    moduleDesc.inputSize = length;
+    moduleDesc.pBuildFlags = "";
+
+    auto status = zeModuleCreate(context, device, &moduleDesc, &module, &buildLog);
+    if (status != ZE_RESULT_SUCCESS) {
+        // print log
+        size_t szLog = 0;
+        zeModuleBuildLogGetString(buildLog, &szLog, nullptr);
+
+        char* stringLog = (char*)malloc(szLog);
+        zeModuleBuildLogGetString(buildLog, &szLog, stringLog);
+        std::cout << "Build log: " << stringLog << std::endl;
+    }
+    VALIDATECALL(zeModuleBuildLogDestroy(buildLog));
+
+    ze_kernel_handle_t kernel;
+    ze_kernel_desc_t kernelDesc = {ZE_STRUCTURE_TYPE_KERNEL_DESC};
+    kernelDesc.pKernelName = "touchPages";
+    VALIDATECALL(zeKernelCreate(module, &kernelDesc, &kernel));
+    return kernel;
+}
+
+// Order in which the blocks are visited
+std::vector<uint32_t> blockOrder(const std::string &order, uint32_t numBlocks) {
+    std::vector<uint32_t> blocks(numBlocks);
+    if (order == "sequential") {
+        std::iota(blocks.begin(), blocks.end(), 0);
+    } else if (order == "strided") {
+        // 0, S, 2S, ..., 1, S+1, 2S+1, ...
+        uint32_t i = 0;
+        for (uint32_t offset = 0; offset < STRIDE_BLOCKS; offset++) {
+            for (uint32_t block = offset; block < numBlocks; block += STRIDE_BLOCKS) {
+                blocks[i++] = block;
+            }
+        }
+    } else {
+        std::iota(blocks.begin(), blocks.end(), 0);
+        std::mt19937 generator(42);
+        std::shuffle(blocks.begin(), blocks.end(), generator);
+    }
+    return blocks;
+}
+
+struct TouchContext {
+    ze_context_handle_t context;
+    ze_device_handle_t device;
+    ze_command_queue_handle_t cmdQueue;
+    ze_command_list_handle_t cmdList;
+    ze_kernel_handle_t kernel;
+    uint32_t *deviceOrder;      // block order in host memory, readable by the device
+    const std::vector<uint32_t> *hostOrder;
+    uint32_t pagesPerBlock;
+    uint32_t numBlocks;
+};
+
+double elapsedNs(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
+}
+
+// Record the device pass over all the pages of the buffer
+void recordDeviceTouch(TouchContext &touch, int *buffer) {
+    uint32_t numPages = touch.numBlocks * touch.pagesPerBlock;
+    uint32_t groupSizeX = 256u;
+    uint32_t groupSizeY = 1u;
+    uint32_t groupSizeZ = 1u;
+    VALIDATECALL(zeKernelSuggestGroupSize(touch.kernel, numPages, 1U, 1U, &groupSizeX, &groupSizeY, &groupSizeZ));
+    VALIDATECALL(zeKernelSetGroupSize(touch.kernel, groupSizeX, groupSizeY, groupSizeZ));
+    VALIDATECALL(zeKernelSetArgumentValue(touch.kernel, 0, sizeof(buffer), &buffer));
+    VALIDATECALL(zeKernelSetArgumentValue(touch.kernel, 1, sizeof(touch.deviceOrder), &touch.deviceOrder));
+    VALIDATECALL(zeKernelSetArgumentValue(touch.kernel, 2, sizeof(uint32_t), &touch.pagesPerBlock));
+    VALIDATECALL(zeKernelSetArgumentValue(touch.kernel, 3, sizeof(uint32_t), &touch.numBlocks));
+
+    ze_group_count_t dispatch;
+    dispatch.groupCountX = (numPages + groupSizeX - 1) / groupSizeX;
+    dispatch.groupCountY = 1;
+    dispatch.groupCountZ = 1;
+
+    VALIDATECALL(zeCommandListReset(touch.cmdList));
+    VALIDATECALL(zeCommandListAppendLaunchKernel(touch.cmdList, touch.kernel, &dispatch, nullptr, 0, nullptr));
+    VALIDATECALL(zeCommandListClose(touch.cmdList));
+}
+
+double deviceTouch(TouchContext &touch) {
+    auto begin = std::chrono::steady_clock::now();
+    VALIDATECALL(zeCommandQueueExecuteCommandLists(touch.cmdQueue, 1, &touch.cmdList, nullptr));
+    VALIDATECALL(zeCommandQueueSynchronize(touch.cmdQueue, std::numeric_limits<uint64_t>::max()));
+    auto end = std::chrono::steady_clock::now();
+    return elapsedNs(begin, end);
+}
+
+double hostTouch(TouchContext &touch, int *buffer) {
+    auto begin = std::chrono::steady_clock::now();
+    const size_t intsPerPage = PAGE_SIZE / sizeof(int);
+    for (auto block : *touch.hostOrder) {
+        size_t firstPage = static_cast<size_t>(block) * touch.pagesPerBlock;
+        for (size_t page = firstPage; page < firstPage + touch.pagesPerBlock; page++) {
+            buffer[page * intsPerPage] += 1;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return elapsedNs(begin, end);
+}
+
+void report(const std::string &pattern, const std::string &order, size_t blockSize, size_t bytes, double ns) {
+    std::cout << "MIGRATION " << pattern << " " << order << " block=" << blockSize 
+              << ": " << ns << " [ns] " << (bytes / ns) << " GB/s" << std::endl;
+}
+
+void benchmarkMigration(TouchContext &touch, const std::string &order, size_t blockSize, size_t bufferSize) {
+    ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
+    memAllocDesc.ordinal = 0;
+    ze_host_mem_alloc_desc_t hostDesc = {ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC};
+    // Every 4KB page of the blocks is touched
+    size_t bytes = static_cast<size_t>(touch.numBlocks) * blockSize;
+
+    // Host first touch, then device
+    int *buffer = nullptr;
+    VALIDATECALL(zeMemAllocShared(touch.context, &memAllocDesc, &hostDesc, bufferSize, blockSize, touch.device, (void **)&buffer));
+    memset(buffer, 0, bufferSize);
+    recordDeviceTouch(touch, buffer);
+    report("HOST-FIRST->DEVICE", order, blockSize, bytes, deviceTouch(touch));
+    report("DEVICE-RESIDENT", order, blockSize, bytes, deviceTouch(touch));
+    report("DEVICE->HOST", order, blockSize, bytes, hostTouch(touch, buffer));
+    VALIDATECALL(zeMemFree(touch.context, buffer));
+
+    // Device first touch, then host
+    buffer = nullptr;
+    VALIDATECALL(zeMemAllocShared(touch.context, &memAllocDesc, &hostDesc, bufferSize, blockSize, touch.device, (void **)&buffer));
+    recordDeviceTouch(touch, buffer);
+    report("DEVICE-FIRST", order, blockSize, bytes, deviceTouch(touch));
+    report("DEVICE-FIRST->HOST", order, blockSize, bytes, hostTouch(touch, buffer));
+
+    // Ping-pong: the pages move on every pass
+    std::vector<double> rounds;
+    for (int i = 0; i < PING_PONG_ITERATIONS; i++) {
+        double ns = deviceTouch(touch) + hostTouch(touch, buffer);
+        rounds.push_back(ns);
+    }
+    BenchStats stats = computeStats(rounds);
+    // Two migrations per round
+    report("PING-PONG", order, blockSize, 2 * bytes, stats.median);
+    printStats("PING-PONG-ROUND " + order + " block=" + std::to_string(blockSize), stats);
+    VALIDATECALL(zeMemFree(touch.context, buffer));
+}
+
+int main(int argc, char **argv) {
+
+    size_t bufferSize = 256UL << 20;
+    if (argc > 1) {
+        bufferSize = atoll(argv[1]);
+    }
+    std::cout << "Buffer size: " << bufferSize << " bytes" << std::endl;
+
+    PhaseTimer initTimer("init");
+    ze_driver_handle_t driverHandle;
+    ze_context_handle_t context;
+    ze_device_handle_t device;
+    init(driverHandle, context, device);
+    printBasicInfo(device);
+
+    TouchContext touch = {};
+    touch.context = context;
+    touch.device = device;
+    uint32_t ordinal = createCommandQueue(device, context, touch.cmdQueue);
+    ze_command_list_desc_t cmdListDesc = {ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC};
+    cmdListDesc.commandQueueGroupOrdinal = ordinal;
+    VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &touch.cmdList));
+    initTimer.stop();
+
+    PhaseTimer moduleTimer("module");
+    ze_module_handle_t module;
+    touch.kernel = createTouchKernel(context, device, module);
+    moduleTimer.stop();
+
+    const std::vector<size_t> blockSizes = {PAGE_SIZE, 65536, 2UL << 20};
+    const std::vector<std::string> orders = {"sequential", "strided", "random"};
+
+    PHASE_TIMER("transfer");
+    for (auto blockSize : blockSizes) {
+        touch.numBlocks = bufferSize / blockSize;
+        touch.pagesPerBlock = blockSize / PAGE_SIZE;
+        if (touch.numBlocks == 0) {
+            continue;
+        }
+        ze_host_mem_alloc_desc_t hostDesc = {ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC};
+        VALIDATECALL(zeMemAllocHost(context, &hostDesc, touch.numBlocks * sizeof(uint32_t), 64, (void **)&touch.deviceOrder));
+
+        for (auto &order : orders) {
+            std::vector<uint32_t> blocks = blockOrder(order, touch.numBlocks);
+            memcpy(touch.deviceOrder, blocks.data(), blocks.size() * sizeof(uint32_t));
+            touch.hostOrder = &blocks;
+            benchmarkMigration(touch, order, blockSize, bufferSize);
+        }
+        VALIDATECALL(zeMemFree(context, touch.deviceOrder));
+    }
+
+    // Cleanup
+    VALIDATECALL(zeKernelDestroy(touch.kernel));
+    VALIDATECALL(zeModuleDestroy(module));
+    VALIDATECALL(zeCommandListDestroy(touch.cmdList));
+    VALIDATECALL(zeCommandQueueDestroy(touch.cmdQueue));
+    VALIDATECALL(zeContextDestroy(context));
+    return 0;
+}
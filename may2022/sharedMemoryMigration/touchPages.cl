@@ -0,0 +1,12 @@
+// The buffer is split in blocks, visited in the order given by blockOrder. Each work-item
+// touches (read + write) the first int of one 4KB page of a block, so every page of the buffer
+// is touched and the whole buffer has to migrate, whatever the migration granularity is.
+#define INTS_PER_PAGE 1024
+__kernel void touchPages(__global int* buffer, __global const uint* blockOrder, const uint pagesPerBlock, const uint numBlocks) {
+	uint idx = get_global_id(0);
+	if (idx < numBlocks * pagesPerBlock) {
+		uint block = blockOrder[idx / pagesPerBlock];
+		uint page = block * pagesPerBlock + idx % pagesPerBlock;
+		buffer[page * INTS_PER_PAGE] += 1;
+	}
+}
@@ -0,0 +1,37 @@
+// Batched matrix multiplication C[b] = A[b] x B[b] for many small n x n matrices in one dispatch.
+// global id 0: column, global id 1: row, global id 2: matrix in the batch.
+// Columns are mapped to the first dimension, so consecutive work-items access consecutive elements of B and C.
+
+// Matrices stored one after the other. A stride of 0 reuses the same matrix for the whole batch.
+__kernel void mxmBatchedStrided(__global const float *a, __global const float *b, __global float *c, const int n,
+                                const ulong strideA, const ulong strideB, const ulong strideC) {
+	uint col = get_global_id(0);
+	uint row = get_global_id(1);
+	ulong batch = get_global_id(2);
+
+	__global const float *aRow = a + batch * strideA + row * n;
+	__global const float *bCol = b + batch * strideB + col;
+	float sum = 0.0f;
+	for (int k = 0; k < n; k++) {
+		sum += aRow[k] * bCol[k * n];
+	}
+	c[batch * strideC + row * n + col] = sum;
+}
+
+// Arrays of pointers (one per matrix). OpenCL C 1.2 does not allow pointer-to-pointer kernel
+// arguments, so the addresses are passed as 64-bit integers.
+__kernel void mxmBatchedPointers(__global const ulong *aPointers, __global const ulong *bPointers, __global const ulong *cPointers,
+                                 const int n) {
+	uint col = get_global_id(0);
+	uint row = get_global_id(1);
+	uint batch = get_global_id(2);
+
+	__global const float *aRow = (__global const float *) aPointers[batch] + row * n;
+	__global const float *bCol = (__global const float *) bPointers[batch] + col;
+	float sum = 0.0f;
+	for (int k = 0; k < n; k++) {
+		sum += aRow[k] * bCol[k * n];
+	}
+	__global float *cMatrix = (__global float *) cPointers[batch];
+	cMatrix[row * n + col] = sum;
+}
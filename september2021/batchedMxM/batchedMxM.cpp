@@ -0,0 +1,526 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Batched matrix multiplication of many small independent matrices in a single dispatch.
+// For small sizes (e.g., 32x32) the launch and synchronization costs are much higher than the
+// multiplication itself, so one launch per matrix is dominated by the overhead. The batched 
+// kernels take all matrices of the batch at once:
+//  - STRIDED : matrices are stored one after the other (fixed stride between matrices)
+//  - POINTERS: one array of pointers per operand, matrices can live anywhere
+//  - LOOP    : baseline, one launch per matrix recorded in the same command list
+// Reports matrices per second for batch sizes from 1 to 10000, validated against a CPU reference.
+
+#include <ze_api.h>
+#include "benchStats.hpp"
+#include "cpuBackend.hpp"
+#include "phaseTimer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#define WARMUP_ITERATIONS 3
+
+// Batches larger than this skip the LOOP baseline (one launch per matrix)
+#define MAX_LOOP_BATCH 1000
+
+#define VALIDATECALL(myZeCall) \
+    if (myZeCall != ZE_RESULT_SUCCESS){ \
+        std::cout << "Error at "       \
+            << #myZeCall << ": "       \
+            << __FUNCTION__ << ": "    \
+            << __LINE__ << std::endl;  \
+        std::cout << "Exit with Error Code: " \
+            << "0x" << std::hex \
+            << myZeCall \
+            << std::dec << std::endl; \
+        std::terminate(); \
+    }
+
+void init(ze_driver_handle_t &driverHandle, ze_context_handle_t &context, ze_device_handle_t &device ) {
+    // Initialization
+    VALIDATECALL(initLevelZero());
+
+    // Get the driver
+    uint32_t driverCount = 1;
+    VALIDATECALL(zeDriverGet(&driverCount, &driverHandle));
+
+    // Create the context
+    ze_context_desc_t contextDescription = {};
+    contextDescription.stype = ZE_STRUCTURE_TYPE_CONTEXT_DESC;
+    VALIDATECALL(zeContextCreate(driverHandle, &contextDescription, &context));
+
+    // Get the device
+    uint32_t deviceCount = 1;
+    VALIDATECALL(zeDeviceGet(driverHandle, &deviceCount, &device));
+}
+
+void printBasicInfo(ze_device_handle_t device) {
+    // Print basic properties of the device
+    ze_device_properties_t deviceProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES};
+    VALIDATECALL(zeDeviceGetProperties(device, &deviceProperties));
+    std::cout << "Device   : " << deviceProperties.name << "\n" 
+              << "Type     : " << ((deviceProperties.type == ZE_DEVICE_TYPE_GPU) ? "GPU" : "FPGA") << "\n"
+              << "Vendor ID: " << std::hex << deviceProperties.vendorId << std::dec << "\n";
+}
+
+uint32_t createCommandQueue(ze_device_handle_t device, ze_context_handle_t context, ze_command_queue_handle_t &cmdQueue) {
+    // Create a command queue
+    uint32_t numQueueGroups = 0;
+    VALIDATECALL(zeDeviceGetCommandQueueGroupProperties(device, &numQueueGroups, nullptr));
+    if (numQueueGroups == 0) {
+        std::cout << "No queue groups found\n";
+        std::terminate();
+    }
+    std::vector<ze_command_queue_group_properties_t> queueProperties(numQueueGroups);
+    VALIDATECALL(zeDeviceGetCommandQueueGroupProperties(device, &numQueueGroups, queueProperties.data()));
+
+    ze_command_queue_desc_t cmdQueueDesc = {ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC};
+    for (uint32_t i = 0; i < numQueueGroups; i++) { 
+        if (queueProperties[i].flags & ZE_COMMAND_QUEUE_GROUP_PROPERTY_FLAG_COMPUTE) {
+            cmdQueueDesc.ordinal = i;
+        }
+    }
+
+    cmdQueueDesc.index = 0;
+    cmdQueueDesc.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
+    VALIDATECALL(zeCommandQueueCreate(context, device, &cmdQueueDesc, &cmdQueue));
+
+    return cmdQueueDesc.ordinal;
+}
+
+void createCommandList(ze_device_handle_t device, ze_context_handle_t context, ze_command_list_handle_t &cmdList, uint32_t ordinal) {
+    // Create a command list
+    ze_command_list_desc_t cmdListDesc = {ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC};
+    cmdListDesc.commandQueueGroupOrdinal = ordinal;    
+    VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &cmdList));
+}
+
+ze_module_handle_t createModule(ze_context_handle_t context, ze_device_handle_t device, const char *fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "SPIR-V binary file not found\n";
+        std::terminate();
+    }
+    file.seekg(0, file.end);
+    auto length = file.tellg();
+    file.seekg(0, file.beg);
+
+    std::unique_ptr<char[]> spirvInput(new char[length]);
+    file.read(spirvInput.get(), length);
+    file.close();
+
+    ze_module_desc_t moduleDesc = {ZE_STRUCTURE_TYPE_MODULE_DESC};
+    ze_module_build_log_handle_t buildLog;
+    moduleDesc.format = ZE_MODULE_FORMAT_IL_SPIRV;
+    moduleDesc.pInputModule = reinterpret_cast<const uint8_t *>(spirvInput.get());
+    moduleDesc.inputSize = length;
+    moduleDesc.pBuildFlags = "";
+
+    ze_module_handle_t module;
+    auto status = zeModuleCreate(context, device, &moduleDesc, &module, &buildLog);
+    if (status != ZE_RESULT_SUCCESS) {
+        // print log
+        size_t szLog = 0;
+        zeModuleBuildLogGetString(buildLog, &szLog, nullptr);
+
+        char* stringLog = (char*)malloc(szLog);
+        zeModuleBuildLogGetString(buildLog, &szLog, stringLog);
+        std::cout << "Build log: " << stringLog << std::endl;
+    }
+    VALIDATECALL(zeModuleBuildLogDestroy(buildLog));
+    VALIDATECALL(status);
+    return module;
+}
+
+ze_kernel_handle_t createKernel(ze_module_handle_t module, const char *name) {
+    ze_kernel_handle_t kernel;
+    ze_kernel_desc_t kernelDesc = {ZE_STRUCTURE_TYPE_KERNEL_DESC};
+    kernelDesc.pKernelName = name;
+    VALIDATECALL(zeKernelCreate(module, &kernelDesc, &kernel));
+    return kernel;
+}
+
+double elapsedNs(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
+}
+
+// CPU reference: C[i] = A[i] x B[i], the matrices of the batch are distributed across threads
+void cpuBatchedMatrixMultiply(const std::vector<float *> &a, const std::vector<float *> &b, const std::vector<float *> &c, 
+                              size_t n, size_t batch) {
+    bool avx2 = cpuSupportsAVX2();
+    parallelFor(0, batch, [&, avx2](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; m++) {
+#ifdef CPU_BACKEND_X86
+            if (avx2) {
+                mxmRowsAVX2(a[m], b[m], c[m], n, 0, n);
+                continue;
+            }
+#endif
+            mxmRowsScalar(a[m], b[m], c[m], n, 0, n);
+        }
+    });
+}
+
+bool validateBatch(const std::vector<float *> &c, const std::vector<float *> &reference, size_t n, size_t batch) {
+    for (size_t m = 0; m < batch; m++) {
+        for (size_t i = 0; i < n * n; i++) {
+            float expected = reference[m][i];
+            if (std::abs(c[m][i] - expected) > 1e-3f * std::max(1.0f, std::abs(expected))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Operands of the benchmark. The strided view uses the matrices in memory order. The pointer
+// view uses a random permutation of the same matrices, so consecutive entries of the batch 
+// are not contiguous in memory.
+struct BatchBuffers {
+    size_t n;
+    size_t maxBatch;
+    float *a;
+    float *b;
+    float *c;
+    uint64_t *aPointers;
+    uint64_t *bPointers;
+    uint64_t *cPointers;
+    std::vector<size_t> permutation;
+};
+
+// validation: PASSED/FAILED for the GPU versions, REFERENCE for the CPU
+void printBatchResult(const std::string &label, size_t n, size_t batch, const std::vector<double> &samples, const std::string &validation) {
+    BenchStats stats = computeStats(samples);
+    double matricesPerSecond = batch / (stats.median * 1e-9);
+    double gflops = (2.0 * n * n * n * batch) / stats.median;
+    printStats(label + "-" + std::to_string(batch), stats);
+    std::cout << label << " n=" << n << " batch=" << batch 
+              << " matrices/s=" << matricesPerSecond 
+              << " GFLOP/s=" << gflops
+              << " validation=" << validation << std::endl;
+}
+
+// Submit and synchronize the command list (recorded once), and return the wall-clock time of each repetition
+std::vector<double> timeCommandList(ze_command_queue_handle_t cmdQueue, ze_command_list_handle_t cmdList, int repetitions) {
+    std::vector<double> samples;
+    for (int i = 0; i < WARMUP_ITERATIONS + repetitions; i++) {
+        auto begin = std::chrono::steady_clock::now();
+        VALIDATECALL(zeCommandQueueExecuteCommandLists(cmdQueue, 1, &cmdList, nullptr));
+        VALIDATECALL(zeCommandQueueSynchronize(cmdQueue, std::numeric_limits<uint64_t>::max()));
+        auto end = std::chrono::steady_clock::now();
+        if (i >= WARMUP_ITERATIONS) {
+            samples.push_back(elapsedNs(begin, end));
+        }
+    }
+    return samples;
+}
+
+// Work-group size that divides (n, n, batch), as required by the dispatch
+void setBatchGroupSize(ze_kernel_handle_t kernel, size_t n, size_t batch, ze_group_count_t &dispatch) {
+    uint32_t groupSizeX = 1u;
+    uint32_t groupSizeY = 1u;
+    uint32_t groupSizeZ = 1u;
+    VALIDATECALL(zeKernelSuggestGroupSize(kernel, n, n, batch, &groupSizeX, &groupSizeY, &groupSizeZ));
+    VALIDATECALL(zeKernelSetGroupSize(kernel, groupSizeX, groupSizeY, groupSizeZ));
+    dispatch.groupCountX = n / groupSizeX;
+    dispatch.groupCountY = n / groupSizeY;
+    dispatch.groupCountZ = batch / groupSizeZ;
+}
+
+std::vector<float *> stridedView(float *base, size_t n, size_t batch) {
+    std::vector<float *> view(batch);
+    for (size_t m = 0; m < batch; m++) {
+        view[m] = base + m * n * n;
+    }
+    return view;
+}
+
+std::vector<float *> pointerView(const uint64_t *pointers, size_t batch) {
+    std::vector<float *> view(batch);
+    for (size_t m = 0; m < batch; m++) {
+        view[m] = reinterpret_cast<float *>(pointers[m]);
+    }
+    return view;
+}
+
+void runBatch(ze_context_handle_t context, ze_device_handle_t device, ze_command_queue_handle_t cmdQueue, uint32_t ordinal, 
+              ze_kernel_handle_t stridedKernel, ze_kernel_handle_t pointersKernel, BatchBuffers &buffers, 
+              size_t batch, int repetitions) {
+
+    size_t n = buffers.n;
+    size_t matrixElements = n * n;
+    std::vector<float> referenceStorage(batch * matrixElements);
+    std::vector<float *> reference = stridedView(referenceStorage.data(), n, batch);
+
+    ze_command_list_handle_t cmdList;
+    createCommandList(device, context, cmdList, ordinal);
+
+    // STRIDED: one dispatch for the whole batch
+    {
+        std::vector<float *> a = stridedView(buffers.a, n, batch);
+        std::vector<float *> b = stridedView(buffers.b, n, batch);
+        std::vector<float *> c = stridedView(buffers.c, n, batch);
+        cpuBatchedMatrixMultiply(a, b, reference, n, batch);
+
+        int size = n;
+        uint64_t stride = matrixElements;
+        VALIDATECALL(zeKernelSetArgumentValue(stridedKernel, 0, sizeof(buffers.a), &buffers.a));
+        VALIDATECALL(zeKernelSetArgumentValue(stridedKernel, 1, sizeof(buffers.b), &buffers.b));
+        VALIDATECALL(zeKernelSetArgumentValue(stridedKernel, 2, sizeof(buffers.c), &buffers.c));
+        VALIDATECALL(zeKernelSetArgumentValue(stridedKernel, 3, sizeof(size), &size));
+        VALIDATECALL(zeKernelSetArgumentValue(stridedKernel, 4, sizeof(stride), &stride));
+        VALIDATECALL(zeKernelSetArgumentValue(stridedKernel, 5, sizeof(stride), &stride));
+        VALIDATECALL(zeKernelSetArgumentValue(stridedKernel, 6, sizeof(stride), &stride));
+        ze_group_count_t dispatch;
+        setBatchGroupSize(stridedKernel, n, batch, dispatch);
+        VALIDATECALL(zeCommandListAppendLaunchKernel(cmdList, stridedKernel, &dispatch, nullptr, 0, nullptr));
+        VALIDATECALL(zeCommandListClose(cmdList));
+
+        memset(buffers.c, 0, batch * matrixElements * sizeof(float));
+        std::vector<double> samples = timeCommandList(cmdQueue, cmdList, repetitions);
+        printBatchResult("STRIDED", n, batch, samples, validateBatch(c, reference, n, batch) ? "PASSED" : "FAILED");
+        VALIDATECALL(zeCommandListReset(cmdList));
+    }
+
+    // LOOP: same kernel, one launch per matrix (batch of 1 with the matrix offsets as arguments)
+    if (batch <= MAX_LOOP_BATCH) {
+        int size = n;
+        uint64_t stride = 0;
+        VALIDATECALL(zeKernelSetArgumentValue(stridedKernel, 3, sizeof(size), &size));
+        VALIDATECALL(zeKernelSetArgumentValue(stridedKernel, 4, sizeof(stride), &stride));
+        VALIDATECALL(zeKernelSetArgumentValue(stridedKernel, 5, sizeof(stride), &stride));
+        VALIDATECALL(zeKernelSetArgumentValue(stridedKernel, 6, sizeof(stride), &stride));
+        ze_group_count_t dispatch;
+        setBatchGroupSize(stridedKernel, n, 1, dispatch);
+        for (size_t m = 0; m < batch; m++) {
+            // Arguments are captured when the launch is appended
+            float *a = buffers.a + m * matrixElements;
+            float *b = buffers.b + m * matrixElements;
+            float *c = buffers.c + m * matrixElements;
+            VALIDATECALL(zeKernelSetArgumentValue(stridedKernel, 0, sizeof(a), &a));
+            VALIDATECALL(zeKernelSetArgumentValue(stridedKernel, 1, sizeof(b), &b));
+            VALIDATECALL(zeKernelSetArgumentValue(stridedKernel, 2, sizeof(c), &c));
+            VALIDATECALL(zeCommandListAppendLaunchKernel(cmdList, stridedKernel, &dispatch, nullptr, 0, nullptr));
+        }
+        VALIDATECALL(zeCommandListClose(cmdList));
+
+        memset(buffers.c, 0, batch * matrixElements * sizeof(float));
+        std::vector<double> samples = timeCommandList(cmdQueue, cmdList, repetitions);
+        printBatchResult("LOOP", n, batch, samples, validateBatch(stridedView(buffers.c, n, batch), reference, n, batch) ? "PASSED" : "FAILED");
+        VALIDATECALL(zeCommandListReset(cmdList));
+    }
+
+    // POINTERS: one dispatch, the matrices are read through the pointer arrays
+    {
+        std::vector<float *> a = pointerView(buffers.aPointers, batch);
+        std::vector<float *> b = pointerView(buffers.bPointers, batch);
+        std::vector<float *> c = pointerView(buffers.cPointers, batch);
+        cpuBatchedMatrixMultiply(a, b, reference, n, batch);
+
+        int size = n;
+        VALIDATECALL(zeKernelSetArgumentValue(pointersKernel, 0, sizeof(buffers.aPointers), &buffers.aPointers));
+        VALIDATECALL(zeKernelSetArgumentValue(pointersKernel, 1, sizeof(buffers.bPointers), &buffers.bPointers));
+        VALIDATECALL(zeKernelSetArgumentValue(pointersKernel, 2, sizeof(buffers.cPointers), &buffers.cPointers));
+        VALIDATECALL(zeKernelSetArgumentValue(pointersKernel, 3, sizeof(size), &size));
+        // The matrices are only reachable through the pointer arrays, so the driver has to make
+        // the shared allocations resident for the kernel
+        VALIDATECALL(zeKernelSetIndirectAccess(pointersKernel, ZE_KERNEL_INDIRECT_ACCESS_FLAG_SHARED));
+        ze_group_count_t dispatch;
+        setBatchGroupSize(pointersKernel, n, batch, dispatch);
+        VALIDATECALL(zeCommandListAppendLaunchKernel(cmdList, pointersKernel, &dispatch, nullptr, 0, nullptr));
+        VALIDATECALL(zeCommandListClose(cmdList));
+
+        memset(buffers.c, 0, buffers.maxBatch * matrixElements * sizeof(float));
+        std::vector<double> samples = timeCommandList(cmdQueue, cmdList, repetitions);
+        printBatchResult("POINTERS", n, batch, samples, validateBatch(c, reference, n, batch) ? "PASSED" : "FAILED");
+    }
+
+    // CPU reference throughput, for comparison
+    {
+        std::vector<float *> a = stridedView(buffers.a, n, batch);
+        std::vector<float *> b = stridedView(buffers.b, n, batch);
+        std::vector<double> samples;
+        for (int i = 0; i < repetitions; i++) {
+            auto begin = std::chrono::steady_clock::now();
+            cpuBatchedMatrixMultiply(a, b, reference, n, batch);
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back(elapsedNs(begin, end));
+        }
+        printBatchResult("CPU", n, batch, samples, "REFERENCE");
+    }
+
+    VALIDATECALL(zeCommandListDestroy(cmdList));
+}
+
+void initBatchBuffers(BatchBuffers &buffers) {
+    size_t elements = buffers.maxBatch * buffers.n * buffers.n;
+    for (size_t i = 0; i < elements; i++) {
+        buffers.a[i] = static_cast<float>(i % 7) * 0.5f;
+        buffers.b[i] = static_cast<float>(i % 5) * 0.25f;
+    }
+    memset(buffers.c, 0, elements * sizeof(float));
+
+    buffers.permutation.resize(buffers.maxBatch);
+    std::iota(buffers.permutation.begin(), buffers.permutation.end(), 0);
+    std::mt19937 generator(7);
+    std::shuffle(buffers.permutation.begin(), buffers.permutation.end(), generator);
+    size_t matrixElements = buffers.n * buffers.n;
+    for (size_t m = 0; m < buffers.maxBatch; m++) {
+        size_t offset = buffers.permutation[m] * matrixElements;
+        buffers.aPointers[m] = reinterpret_cast<uint64_t>(buffers.a + offset);
+        buffers.bPointers[m] = reinterpret_cast<uint64_t>(buffers.b + offset);
+        buffers.cPointers[m] = reinterpret_cast<uint64_t>(buffers.c + offset);
+    }
+}
+
+std::vector<size_t> batchSizes(size_t maxBatch) {
+    std::vector<size_t> sizes;
+    for (size_t batch = 1; batch <= maxBatch; batch *= 10) {
+        sizes.push_back(batch);
+    }
+    if (sizes.back() != maxBatch) {
+        sizes.push_back(maxBatch);
+    }
+    return sizes;
+}
+
+// No Level Zero GPU available (or CPU_BACKEND=1): report the CPU reference only
+int runCpuBackend(size_t n, size_t maxBatch, int repetitions) {
+    std::cout << "Device   : CPU backend (" << cpuBackendThreads() << " threads)\n"
+              << "Type     : CPU" << std::endl;
+    size_t elements = maxBatch * n * n;
+    std::vector<float> a(elements);
+    std::vector<float> b(elements);
+    std::vector<float> c(elements);
+    for (size_t i = 0; i < elements; i++) {
+        a[i] = static_cast<float>(i % 7) * 0.5f;
+        b[i] = static_cast<float>(i % 5) * 0.25f;
+    }
+    PHASE_TIMER("kernel");
+    for (auto batch : batchSizes(maxBatch)) {
+        std::vector<float *> aView = stridedView(a.data(), n, batch);
+        std::vector<float *> bView = stridedView(b.data(), n, batch);
+        std::vector<float *> cView = stridedView(c.data(), n, batch);
+        std::vector<double> samples;
+        for (int i = 0; i < repetitions; i++) {
+            auto begin = std::chrono::steady_clock::now();
+            cpuBatchedMatrixMultiply(aView, bView, cView, n, batch);
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back(elapsedNs(begin, end));
+        }
+        printBatchResult("CPU", n, batch, samples, "REFERENCE");
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+
+    size_t n = 16;
+    size_t maxBatch = 10000;
+    int repetitions = 20;
+    if (argc > 1) {
+        n = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        maxBatch = atol(argv[2]);
+    }
+    if (argc > 3) {
+        repetitions = atoi(argv[3]);
+    }
+    std::cout << "#Matrix size: " << n << "x" << n << " max batch: " << maxBatch << " repetitions: " << repetitions << std::endl;
+
+    if (useCpuBackend()) {
+        return runCpuBackend(n, maxBatch, repetitions);
+    }
+
+    PhaseTimer initTimer("init");
+    ze_driver_handle_t driverHandle;
+    ze_context_handle_t context;
+    ze_device_handle_t device;
+    init(driverHandle, context, device);
+    printBasicInfo(device);
+
+    ze_command_queue_handle_t cmdQueue;
+    uint32_t ordinal = createCommandQueue(device, context, cmdQueue);
+    initTimer.stop();
+
+    PhaseTimer moduleTimer("module");
+    ze_module_handle_t module = createModule(context, device, "batchedMxM.spv");
+    ze_kernel_handle_t stridedKernel = createKernel(module, "mxmBatchedStrided");
+    ze_kernel_handle_t pointersKernel = createKernel(module, "mxmBatchedPointers");
+    moduleTimer.stop();
+
+    PhaseTimer allocTimer("alloc");
+    BatchBuffers buffers = {};
+    buffers.n = n;
+    buffers.maxBatch = maxBatch;
+    size_t allocSize = maxBatch * n * n * sizeof(float);
+    size_t pointersSize = maxBatch * sizeof(uint64_t);
+    ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
+    ze_host_mem_alloc_desc_t hostDesc = {ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC};
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 64, device, (void **)&buffers.a));
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 64, device, (void **)&buffers.b));
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 64, device, (void **)&buffers.c));
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, pointersSize, 64, device, (void **)&buffers.aPointers));
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, pointersSize, 64, device, (void **)&buffers.bPointers));
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, pointersSize, 64, device, (void **)&buffers.cPointers));
+    allocTimer.stop();
+
+    PhaseTimer hostInitTimer("host-init");
+    initBatchBuffers(buffers);
+    hostInitTimer.stop();
+
+    {
+        // Validation against the CPU reference is included in this phase
+        PHASE_TIMER("kernel");
+        for (auto batch : batchSizes(maxBatch)) {
+            runBatch(context, device, cmdQueue, ordinal, stridedKernel, pointersKernel, buffers, batch, repetitions);
+        }
+    }
+
+    // Cleanup
+    PHASE_TIMER("cleanup");
+    VALIDATECALL(zeMemFree(context, buffers.a));
+    VALIDATECALL(zeMemFree(context, buffers.b));
+    VALIDATECALL(zeMemFree(context, buffers.c));
+    VALIDATECALL(zeMemFree(context, buffers.aPointers));
+    VALIDATECALL(zeMemFree(context, buffers.bPointers));
+    VALIDATECALL(zeMemFree(context, buffers.cPointers));
+    VALIDATECALL(zeKernelDestroy(stridedKernel));
+    VALIDATECALL(zeKernelDestroy(pointersKernel));
+    VALIDATECALL(zeModuleDestroy(module));
+    VALIDATECALL(zeCommandQueueDestroy(cmdQueue));
+    VALIDATECALL(zeContextDestroy(context));
+    return 0;
+}
@@ -0,0 +1,3 @@
+
+clang -cc1 -triple spir batchedMxM.cl -O2 -finclude-default-header -emit-llvm-bc -o batchedMxM.bc
+llvm-spirv batchedMxM.bc -o batchedMxM.spv
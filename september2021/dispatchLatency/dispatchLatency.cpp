@@ -0,0 +1,369 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Micro-benchmarks to isolate the fixed costs of offloading work with Level Zero:
+//  1. Empty-kernel launch to completion
+//  2. Host-side submission cost for a command list with N kernels
+//  3. Event signaled from the host -> device -> event observed by the host
+//  4. Round-trip of a 1-byte copy (host -> device -> host)
+
+#include <ze_api.h>
+#include "benchStats.hpp"
+#include "phaseTimer.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define WARMUP_ITERATIONS 10
+
+#define VALIDATECALL(myZeCall) \
+    if (myZeCall != ZE_RESULT_SUCCESS){ \
+        std::cout << "Error at "       \
+            << #myZeCall << ": "       \
+            << __FUNCTION__ << ": "    \
+            << __LINE__ << std::endl;  \
+        std::cout << "Exit with Error Code: " \
+            << "0x" << std::hex \
+            << myZeCall \
+            << std::dec << std::endl; \
+        std::terminate(); \
+    }
+
+void init(ze_driver_handle_t &driverHandle, ze_context_handle_t &context, ze_device_handle_t &device ) {
+    // Initialization
+    VALIDATECALL(zeInit(ZE_INIT_FLAG_GPU_ONLY));
+
+    // Get the driver
+    uint32_t driverCount = 1;
+    VALIDATECALL(zeDriverGet(&driverCount, &driverHandle));
+
+    // Create the context
+    ze_context_desc_t contextDescription = {};
+    contextDescription.stype = ZE_STRUCTURE_TYPE_CONTEXT_DESC;
+    VALIDATECALL(zeContextCreate(driverHandle, &contextDescription, &context));
+
+    // Get the device
+    uint32_t deviceCount = 1;
+    VALIDATECALL(zeDeviceGet(driverHandle, &deviceCount, &device));
+}
+
+void printBasicInfo(ze_device_handle_t device) {
+    // Print basic properties of the device
+    ze_device_properties_t deviceProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES};
+    VALIDATECALL(zeDeviceGetProperties(device, &deviceProperties));
+    std::cout << "Device   : " << deviceProperties.name << "\n" 
+              << "Type     : " << ((deviceProperties.type == ZE_DEVICE_TYPE_GPU) ? "GPU" : "FPGA") << "\n"
+              << "Vendor ID: " << std::hex << deviceProperties.vendorId << std::dec << "\n";
+}
+
+uint32_t createCommandQueue(ze_device_handle_t device, ze_context_handle_t context, ze_command_queue_handle_t &cmdQueue) {
+    // Create a command queue
+    uint32_t numQueueGroups = 0;
+    VALIDATECALL(zeDeviceGetCommandQueueGroupProperties(device, &numQueueGroups, nullptr));
+    if (numQueueGroups == 0) {
+        std::cout << "No queue groups found\n";
+        std::terminate();
+    }
+    std::vector<ze_command_queue_group_properties_t> queueProperties(numQueueGroups);
+    VALIDATECALL(zeDeviceGetCommandQueueGroupProperties(device, &numQueueGroups, queueProperties.data()));
+
+    ze_command_queue_desc_t cmdQueueDesc = {ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC};
+    for (uint32_t i = 0; i < numQueueGroups; i++) { 
+        if (queueProperties[i].flags & ZE_COMMAND_QUEUE_GROUP_PROPERTY_FLAG_COMPUTE) {
+            cmdQueueDesc.ordinal = i;
+        }
+    }
+
+    cmdQueueDesc.index = 0;
+    cmdQueueDesc.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
+    VALIDATECALL(zeCommandQueueCreate(context, device, &cmdQueueDesc, &cmdQueue));
+
+    return cmdQueueDesc.ordinal;
+}
+
+void createCommandList(ze_device_handle_t device, ze_context_handle_t context, ze_command_list_handle_t &cmdList, uint32_t ordinal) {
+    // Create a command list
+    ze_command_list_desc_t cmdListDesc = {ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC};
+    cmdListDesc.commandQueueGroupOrdinal = ordinal;    
+    VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &cmdList));
+}
+
+ze_kernel_handle_t createEmptyKernel(ze_context_handle_t context, ze_device_handle_t device, ze_module_handle_t &module) {
+    std::ifstream file("emptyKernel.spv", std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "SPIR-V binary file not found\n";
+        std::terminate();
+    }
+    file.seekg(0, file.end);
+    auto length = file.tellg();
+    file.seekg(0, file.beg);
+
+    std::unique_ptr<char[]> spirvInput(new char[length]);
+    file.read(spirvInput.get(), length);
+    file.close();
+
+    ze_module_desc_t moduleDesc = {ZE_STRUCTURE_TYPE_MODULE_DESC};
+    ze_module_build_log_handle_t buildLog;
+    moduleDesc.format = ZE_MODULE_FORMAT_IL_SPIRV;
+    moduleDesc.pInputModule = reinterpret_cast<const uint8_t *>(spirvInput.get());
+    moduleDesc.inputSize = length;
+    moduleDesc.pBuildFlags = "";
+
+    auto status = zeModuleCreate(context, device, &moduleDesc, &module, &buildLog);
+    if (status != ZE_RESULT_SUCCESS) {
+        // print log
+        size_t szLog = 0;
+        zeModuleBuildLogGetString(buildLog, &szLog, nullptr);
+
+        char* stringLog = (char*)malloc(szLog);
+        zeModuleBuildLogGetString(buildLog, &szLog, stringLog);
+        std::cout << "Build log: " << stringLog << std::endl;
+    }
+    VALIDATECALL(zeModuleBuildLogDestroy(buildLog));
+
+    ze_kernel_handle_t kernel;
+    ze_kernel_desc_t kernelDesc = {ZE_STRUCTURE_TYPE_KERNEL_DESC};
+    kernelDesc.pKernelName = "emptyKernel";
+    VALIDATECALL(zeKernelCreate(module, &kernelDesc, &kernel));
+    VALIDATECALL(zeKernelSetGroupSize(kernel, 1, 1, 1));
+    return kernel;
+}
+
+double elapsedNs(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
+}
+
+// 1. Submit a command list with a single empty kernel (1 work-group of 1 thread) 
+//    and wait for it. The command list is recorded once.
+void benchmarkEmptyKernel(ze_context_handle_t context, ze_device_handle_t device, ze_command_queue_handle_t cmdQueue, 
+                          uint32_t ordinal, ze_kernel_handle_t kernel, int iterations) {
+
+    ze_command_list_handle_t cmdList;
+    createCommandList(device, context, cmdList, ordinal);
+
+    ze_group_count_t dispatch = {1, 1, 1};
+    VALIDATECALL(zeCommandListAppendLaunchKernel(cmdList, kernel, &dispatch, nullptr, 0, nullptr));
+    VALIDATECALL(zeCommandListClose(cmdList));
+
+    std::vector<double> samples;
+    for (int i = 0; i < WARMUP_ITERATIONS + iterations; i++) {
+        auto begin = std::chrono::steady_clock::now();
+        VALIDATECALL(zeCommandQueueExecuteCommandLists(cmdQueue, 1, &cmdList, nullptr));
+        VALIDATECALL(zeCommandQueueSynchronize(cmdQueue, std::numeric_limits<uint64_t>::max()));
+        auto end = std::chrono::steady_clock::now();
+        if (i >= WARMUP_ITERATIONS) {
+            samples.push_back(elapsedNs(begin, end));
+        }
+    }
+    printStats("EMPTY-KERNEL", computeStats(samples));
+    VALIDATECALL(zeCommandListDestroy(cmdList));
+}
+
+// 2. Host cost of recording (append + close) and submitting a command list with N empty kernels.
+//    The submission time only accounts for the zeCommandQueueExecuteCommandLists call. 
+void benchmarkSubmission(ze_context_handle_t context, ze_device_handle_t device, ze_command_queue_handle_t cmdQueue, 
+                         uint32_t ordinal, ze_kernel_handle_t kernel, int iterations) {
+
+    std::vector<int> kernelsPerList = {1, 10, 100, 1000};
+    ze_group_count_t dispatch = {1, 1, 1};
+
+    for (auto numKernels : kernelsPerList) {
+        ze_command_list_handle_t cmdList;
+        createCommandList(device, context, cmdList, ordinal);
+
+        std::vector<double> recordSamples;
+        std::vector<double> submitSamples;
+        std::vector<double> completionSamples;
+        for (int i = 0; i < WARMUP_ITERATIONS + iterations; i++) {
+            auto beginRecord = std::chrono::steady_clock::now();
+            for (int k = 0; k < numKernels; k++) {
+                VALIDATECALL(zeCommandListAppendLaunchKernel(cmdList, kernel, &dispatch, nullptr, 0, nullptr));
+            }
+            VALIDATECALL(zeCommandListClose(cmdList));
+            auto beginSubmit = std::chrono::steady_clock::now();
+            VALIDATECALL(zeCommandQueueExecuteCommandLists(cmdQueue, 1, &cmdList, nullptr));
+            auto endSubmit = std::chrono::steady_clock::now();
+            VALIDATECALL(zeCommandQueueSynchronize(cmdQueue, std::numeric_limits<uint64_t>::max()));
+            auto end = std::chrono::steady_clock::now();
+            VALIDATECALL(zeCommandListReset(cmdList));
+            if (i >= WARMUP_ITERATIONS) {
+                recordSamples.push_back(elapsedNs(beginRecord, beginSubmit));
+                submitSamples.push_back(elapsedNs(beginSubmit, endSubmit));
+                completionSamples.push_back(elapsedNs(beginSubmit, end));
+            }
+        }
+        std::string suffix = "-" + std::to_string(numKernels);
+        printStats("RECORD" + suffix, computeStats(recordSamples));
+        printStats("SUBMIT" + suffix, computeStats(submitSamples));
+        printStats("SUBMIT-TO-COMPLETION" + suffix, computeStats(completionSamples));
+        VALIDATECALL(zeCommandListDestroy(cmdList));
+    }
+}
+
+// 3. The command list waits for an event signaled by the host and then signals a second event.
+//    Time from zeEventHostSignal until the host observes the second event (busy-polling).
+void benchmarkEventRoundTrip(ze_context_handle_t context, ze_device_handle_t device, ze_command_queue_handle_t cmdQueue, 
+                             uint32_t ordinal, int iterations) {
+
+    ze_event_pool_handle_t eventPool;
+    ze_event_pool_desc_t eventPoolDesc = {ZE_STRUCTURE_TYPE_EVENT_POOL_DESC};
+    eventPoolDesc.count = 2;
+    eventPoolDesc.flags = ZE_EVENT_POOL_FLAG_HOST_VISIBLE;
+    VALIDATECALL(zeEventPoolCreate(context, &eventPoolDesc, 1, &device, &eventPool));
+
+    ze_event_handle_t hostToDevice;
+    ze_event_handle_t deviceToHost;
+    ze_event_desc_t eventDesc = {ZE_STRUCTURE_TYPE_EVENT_DESC};
+    eventDesc.signal = ZE_EVENT_SCOPE_FLAG_HOST;
+    eventDesc.wait = ZE_EVENT_SCOPE_FLAG_HOST;
+    eventDesc.index = 0;
+    VALIDATECALL(zeEventCreate(eventPool, &eventDesc, &hostToDevice));
+    eventDesc.index = 1;
+    VALIDATECALL(zeEventCreate(eventPool, &eventDesc, &deviceToHost));
+
+    ze_command_list_handle_t cmdList;
+    createCommandList(device, context, cmdList, ordinal);
+    VALIDATECALL(zeCommandListAppendWaitOnEvents(cmdList, 1, &hostToDevice));
+    VALIDATECALL(zeCommandListAppendSignalEvent(cmdList, deviceToHost));
+    VALIDATECALL(zeCommandListClose(cmdList));
+
+    std::vector<double> samples;
+    for (int i = 0; i < WARMUP_ITERATIONS + iterations; i++) {
+        VALIDATECALL(zeEventHostReset(hostToDevice));
+        VALIDATECALL(zeEventHostReset(deviceToHost));
+        VALIDATECALL(zeCommandQueueExecuteCommandLists(cmdQueue, 1, &cmdList, nullptr));
+
+        auto begin = std::chrono::steady_clock::now();
+        VALIDATECALL(zeEventHostSignal(hostToDevice));
+        while (zeEventQueryStatus(deviceToHost) == ZE_RESULT_NOT_READY) {
+            // spin
+        }
+        auto end = std::chrono::steady_clock::now();
+        VALIDATECALL(zeCommandQueueSynchronize(cmdQueue, std::numeric_limits<uint64_t>::max()));
+        if (i >= WARMUP_ITERATIONS) {
+            samples.push_back(elapsedNs(begin, end));
+        }
+    }
+    printStats("EVENT-ROUND-TRIP", computeStats(samples));
+
+    VALIDATECALL(zeCommandListDestroy(cmdList));
+    VALIDATECALL(zeEventDestroy(hostToDevice));
+    VALIDATECALL(zeEventDestroy(deviceToHost));
+    VALIDATECALL(zeEventPoolDestroy(eventPool));
+}
+
+// 4. Copy 1 byte from host memory to device memory and back in the same command list.
+void benchmarkOneByteCopy(ze_context_handle_t context, ze_device_handle_t device, ze_command_queue_handle_t cmdQueue, 
+                          uint32_t ordinal, int iterations) {
+
+    ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
+    ze_host_mem_alloc_desc_t hostDesc = {ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC};
+    void *deviceBuffer = nullptr;
+    void *hostBuffer = nullptr;
+    VALIDATECALL(zeMemAllocDevice(context, &memAllocDesc, 1, 1, device, &deviceBuffer));
+    VALIDATECALL(zeMemAllocHost(context, &hostDesc, 1, 1, &hostBuffer));
+    memset(hostBuffer, 1, 1);
+
+    ze_command_list_handle_t cmdList;
+    createCommandList(device, context, cmdList, ordinal);
+    VALIDATECALL(zeCommandListAppendMemoryCopy(cmdList, deviceBuffer, hostBuffer, 1, nullptr, 0, nullptr));
+    VALIDATECALL(zeCommandListAppendBarrier(cmdList, nullptr, 0, nullptr));
+    VALIDATECALL(zeCommandListAppendMemoryCopy(cmdList, hostBuffer, deviceBuffer, 1, nullptr, 0, nullptr));
+    VALIDATECALL(zeCommandListClose(cmdList));
+
+    std::vector<double> samples;
+    for (int i = 0; i < WARMUP_ITERATIONS + iterations; i++) {
+        auto begin = std::chrono::steady_clock::now();
+        VALIDATECALL(zeCommandQueueExecuteCommandLists(cmdQueue, 1, &cmdList, nullptr));
+        VALIDATECALL(zeCommandQueueSynchronize(cmdQueue, std::numeric_limits<uint64_t>::max()));
+        auto end = std::chrono::steady_clock::now();
+        if (i >= WARMUP_ITERATIONS) {
+            samples.push_back(elapsedNs(begin, end));
+        }
+    }
+    printStats("COPY-1B-ROUND-TRIP", computeStats(samples));
+
+    VALIDATECALL(zeCommandListDestroy(cmdList));
+    VALIDATECALL(zeMemFree(context, deviceBuffer));
+    VALIDATECALL(zeMemFree(context, hostBuffer));
+}
+
+int main(int argc, char **argv) {
+
+    int iterations = 1000;
+    if (argc > 1) {
+        iterations = atoi(argv[1]);
+    }
+    std::cout << "#Iterations: " << iterations << std::endl;
+
+    PhaseTimer initTimer("init");
+    ze_driver_handle_t driverHandle;
+    ze_context_handle_t context;
+    ze_device_handle_t device;
+    init(driverHandle, context, device);
+    printBasicInfo(device);
+
+    ze_command_queue_handle_t cmdQueue;
+    uint32_t ordinal = createCommandQueue(device, context, cmdQueue);
+    initTimer.stop();
+
+    PhaseTimer moduleTimer("module");
+    ze_module_handle_t module;
+    ze_kernel_handle_t kernel = createEmptyKernel(context, device, module);
+    moduleTimer.stop();
+
+    // The empty kernel receives one (unused) argument
+    PhaseTimer allocTimer("alloc");
+    void *dummyBuffer = nullptr;
+    ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
+    VALIDATECALL(zeMemAllocDevice(context, &memAllocDesc, sizeof(int), sizeof(int), device, &dummyBuffer));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 0, sizeof(dummyBuffer), &dummyBuffer));
+    allocTimer.stop();
+
+    {
+        PHASE_TIMER("kernel");
+        benchmarkEmptyKernel(context, device, cmdQueue, ordinal, kernel, iterations);
+        benchmarkSubmission(context, device, cmdQueue, ordinal, kernel, iterations);
+        benchmarkEventRoundTrip(context, device, cmdQueue, ordinal, iterations);
+    }
+    {
+        PHASE_TIMER("transfer");
+        benchmarkOneByteCopy(context, device, cmdQueue, ordinal, iterations);
+    }
+
+    // Cleanup
+    PHASE_TIMER("cleanup");
+    VALIDATECALL(zeMemFree(context, dummyBuffer));
+    VALIDATECALL(zeKernelDestroy(kernel));
+    VALIDATECALL(zeModuleDestroy(module));
+    VALIDATECALL(zeCommandQueueDestroy(cmdQueue));
+    VALIDATECALL(zeContextDestroy(context));
+    return 0;
+}
@@ -0,0 +1,2 @@
+__kernel void emptyKernel(__global int* a) {
+}
@@ -0,0 +1,4 @@
+
+clang -cc1 -triple spir emptyKernel.cl -O2 -finclude-default-header -emit-llvm-bc -o emptyKernel.bc
+llvm-spirv emptyKernel.bc -o emptyKernel.spv
+
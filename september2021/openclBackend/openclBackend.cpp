@@ -0,0 +1,622 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// OpenCL host backend for the kernels of the Level Zero examples. The same OpenCL C sources are
+// built at runtime with clCreateProgramWithSource (no SPIR-V step) and launched with
+// clEnqueueNDRangeKernel, so the dispatch cost of both stacks can be compared for the same
+// launch pattern. It runs on any OpenCL platform, including CPU runtimes such as PoCL.
+//
+// Benchmarks:
+//  - empty: the dispatch latency benchmarks of dispatchLatency (empty kernel, N kernels per
+//    submission, 1-byte copy round-trip)
+//  - mxm, mxmInt, vadd: the kernels of timingGPUKernel and sharedMemoryEffect, with the buffer
+//    modes of levelZeroShared
+
+#define CL_TARGET_OPENCL_VERSION 200
+// clCreateCommandQueue, so OpenCL 1.2 platforms can run it too
+#define CL_USE_DEPRECATED_OPENCL_1_2_APIS
+#include <CL/cl.h>
+#include "benchStats.hpp"
+#include "phaseTimer.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#define WARMUP_ITERATIONS 10
+
+#define VALIDATECALL(myClCall) \
+    if (myClCall != CL_SUCCESS){ \
+        std::cout << "Error at "       \
+            << #myClCall << ": "       \
+            << __FUNCTION__ << ": "    \
+            << __LINE__ << std::endl;  \
+        std::cout << "Exit with Error Code: " \
+            << std::dec << myClCall \
+            << std::endl; \
+        std::terminate(); \
+    }
+
+// Kernel sources (relative to this directory)
+#define MXM_SOURCE "../timingGPUKernel/matrixMultiply.cl"
+#define MXM_INT_SOURCE "../../may2022/sharedMemoryEffect/matrixMultiply/mxm.cl"
+#define VADD_SOURCE "../../may2022/sharedMemoryEffect/vectorAddition.cl"
+#define EMPTY_SOURCE "../dispatchLatency/emptyKernel.cl"
+
+struct CLEnvironment {
+    cl_platform_id platform;
+    cl_device_id device;
+    cl_context context;
+    cl_command_queue queue;
+    bool svm;
+};
+
+std::string platformInfo(cl_platform_id platform, cl_platform_info param) {
+    size_t size = 0;
+    VALIDATECALL(clGetPlatformInfo(platform, param, 0, nullptr, &size));
+    std::string value(size, '\0');
+    VALIDATECALL(clGetPlatformInfo(platform, param, size, &value[0], nullptr));
+    return value.c_str();
+}
+
+std::string deviceInfo(cl_device_id device, cl_device_info param) {
+    size_t size = 0;
+    VALIDATECALL(clGetDeviceInfo(device, param, 0, nullptr, &size));
+    std::string value(size, '\0');
+    VALIDATECALL(clGetDeviceInfo(device, param, size, &value[0], nullptr));
+    return value.c_str();
+}
+
+int envIndex(const char *name) {
+    const char *env = std::getenv(name);
+    return (env != nullptr) ? std::atoi(env) : 0;
+}
+
+// Lists all platforms and devices, and selects OCL_PLATFORM/OCL_DEVICE (default 0/0). Any device
+// type is accepted, so CPU runtimes can be used when there is no GPU.
+void init(CLEnvironment &env) {
+    cl_uint numPlatforms = 0;
+    cl_int status = clGetPlatformIDs(0, nullptr, &numPlatforms);
+    if (status != CL_SUCCESS || numPlatforms == 0) {
+        std::cout << "No OpenCL platforms found (error " << status << ")" << std::endl;
+        std::exit(-1);
+    }
+    std::vector<cl_platform_id> platforms(numPlatforms);
+    VALIDATECALL(clGetPlatformIDs(numPlatforms, platforms.data(), nullptr));
+
+    int platformIndex = envIndex("OCL_PLATFORM");
+    int deviceIndex = envIndex("OCL_DEVICE");
+    bool found = false;
+    for (cl_uint p = 0; p < numPlatforms; p++) {
+        std::cout << "Platform " << p << ": " << platformInfo(platforms[p], CL_PLATFORM_NAME)
+                  << " (" << platformInfo(platforms[p], CL_PLATFORM_VERSION) << ")" << std::endl;
+        cl_uint numDevices = 0;
+        if (clGetDeviceIDs(platforms[p], CL_DEVICE_TYPE_ALL, 0, nullptr, &numDevices) != CL_SUCCESS) {
+            continue;
+        }
+        std::vector<cl_device_id> devices(numDevices);
+        VALIDATECALL(clGetDeviceIDs(platforms[p], CL_DEVICE_TYPE_ALL, numDevices, devices.data(), nullptr));
+        for (cl_uint d = 0; d < numDevices; d++) {
+            std::cout << "    Device " << d << ": " << deviceInfo(devices[d], CL_DEVICE_NAME) << std::endl;
+            if (static_cast<int>(p) == platformIndex && static_cast<int>(d) == deviceIndex) {
+                env.platform = platforms[p];
+                env.device = devices[d];
+                found = true;
+            }
+        }
+    }
+    if (!found) {
+        std::cout << "Device " << platformIndex << "/" << deviceIndex << " not found (OCL_PLATFORM/OCL_DEVICE)" << std::endl;
+        std::exit(-1);
+    }
+
+    cl_device_type type;
+    VALIDATECALL(clGetDeviceInfo(env.device, CL_DEVICE_TYPE, sizeof(type), &type, nullptr));
+    std::cout << "Device   : " << deviceInfo(env.device, CL_DEVICE_NAME) << "\n"
+              << "Type     : " << ((type & CL_DEVICE_TYPE_GPU) ? "GPU" : (type & CL_DEVICE_TYPE_CPU) ? "CPU" : "OTHER") << "\n"
+              << "Version  : " << deviceInfo(env.device, CL_DEVICE_VERSION) << "\n"
+              << "Driver   : " << deviceInfo(env.device, CL_DRIVER_VERSION) << std::endl;
+
+    // Coarse-grain SVM is mandatory in OpenCL 2.x, optional in 3.0
+    cl_device_svm_capabilities svmCapabilities = 0;
+    env.svm = clGetDeviceInfo(env.device, CL_DEVICE_SVM_CAPABILITIES, sizeof(svmCapabilities), &svmCapabilities, nullptr) == CL_SUCCESS
+              && (svmCapabilities & CL_DEVICE_SVM_COARSE_GRAIN_BUFFER);
+
+    cl_int result;
+    env.context = clCreateContext(nullptr, 1, &env.device, nullptr, nullptr, &result);
+    VALIDATECALL(result);
+    // In-order queue with profiling, the equivalent of a Level Zero queue + kernel timestamps
+    env.queue = clCreateCommandQueue(env.context, env.device, CL_QUEUE_PROFILING_ENABLE, &result);
+    VALIDATECALL(result);
+}
+
+// Build from source (the equivalent of zeModuleCreate from SPIR-V). The build time is printed,
+// because it is paid by every run.
+cl_program buildProgram(CLEnvironment &env, const char *fileName) {
+    std::ifstream file(fileName);
+    if (!file.is_open()) {
+        std::cout << "Kernel source not found: " << fileName << std::endl;
+        std::terminate();
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string source = buffer.str();
+    const char *sourcePtr = source.c_str();
+    size_t sourceLength = source.size();
+
+    auto begin = std::chrono::steady_clock::now();
+    cl_int result;
+    cl_program program = clCreateProgramWithSource(env.context, 1, &sourcePtr, &sourceLength, &result);
+    VALIDATECALL(result);
+    cl_int status = clBuildProgram(program, 1, &env.device, "", nullptr, nullptr);
+    auto end = std::chrono::steady_clock::now();
+    if (status != CL_SUCCESS) {
+        // print log
+        size_t szLog = 0;
+        clGetProgramBuildInfo(program, env.device, CL_PROGRAM_BUILD_LOG, 0, nullptr, &szLog);
+        std::string log(szLog, '\0');
+        clGetProgramBuildInfo(program, env.device, CL_PROGRAM_BUILD_LOG, szLog, &log[0], nullptr);
+        std::cout << "Build log: " << log << std::endl;
+    }
+    VALIDATECALL(status);
+    std::cout << "BUILD " << fileName << " = " << std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count() << " [ns]" << std::endl;
+    return program;
+}
+
+cl_kernel createKernel(cl_program program, const char *name) {
+    cl_int result;
+    cl_kernel kernel = clCreateKernel(program, name, &result);
+    VALIDATECALL(result);
+    return kernel;
+}
+
+double elapsedNs(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
+}
+
+// Profiling interval of an event, in ns
+cl_ulong eventTimestamp(cl_event event, cl_profiling_info info) {
+    cl_ulong timestamp = 0;
+    VALIDATECALL(clGetEventProfilingInfo(event, info, sizeof(timestamp), &timestamp, nullptr));
+    return timestamp;
+}
+
+double eventNs(cl_event event, cl_profiling_info from, cl_profiling_info to) {
+    return static_cast<double>(eventTimestamp(event, to) - eventTimestamp(event, from));
+}
+
+// 1. Enqueue one empty kernel (1 work-item) and wait for it (EMPTY-KERNEL in dispatchLatency)
+void benchmarkEmptyKernel(CLEnvironment &env, cl_kernel kernel, int iterations) {
+    size_t globalSize = 1;
+    std::vector<double> samples;
+    for (int i = 0; i < WARMUP_ITERATIONS + iterations; i++) {
+        auto begin = std::chrono::steady_clock::now();
+        VALIDATECALL(clEnqueueNDRangeKernel(env.queue, kernel, 1, nullptr, &globalSize, nullptr, 0, nullptr, nullptr));
+        VALIDATECALL(clFinish(env.queue));
+        auto end = std::chrono::steady_clock::now();
+        if (i >= WARMUP_ITERATIONS) {
+            samples.push_back(elapsedNs(begin, end));
+        }
+    }
+    printStats("EMPTY-KERNEL", computeStats(samples));
+}
+
+// 2. Host cost of enqueuing N empty kernels plus clFlush (in OpenCL there is no separate record
+//    step: this is the equivalent of RECORD + SUBMIT in dispatchLatency), and until completion.
+void benchmarkSubmission(CLEnvironment &env, cl_kernel kernel, int iterations) {
+    std::vector<int> kernelsPerSubmission = {1, 10, 100, 1000};
+    size_t globalSize = 1;
+    for (auto numKernels : kernelsPerSubmission) {
+        std::vector<double> enqueueSamples;
+        std::vector<double> completionSamples;
+        for (int i = 0; i < WARMUP_ITERATIONS + iterations; i++) {
+            auto begin = std::chrono::steady_clock::now();
+            for (int k = 0; k < numKernels; k++) {
+                VALIDATECALL(clEnqueueNDRangeKernel(env.queue, kernel, 1, nullptr, &globalSize, nullptr, 0, nullptr, nullptr));
+            }
+            VALIDATECALL(clFlush(env.queue));
+            auto endEnqueue = std::chrono::steady_clock::now();
+            VALIDATECALL(clFinish(env.queue));
+            auto end = std::chrono::steady_clock::now();
+            if (i >= WARMUP_ITERATIONS) {
+                enqueueSamples.push_back(elapsedNs(begin, endEnqueue));
+                completionSamples.push_back(elapsedNs(begin, end));
+            }
+        }
+        std::string suffix = "-" + std::to_string(numKernels);
+        printStats("ENQUEUE" + suffix, computeStats(enqueueSamples));
+        printStats("ENQUEUE-TO-COMPLETION" + suffix, computeStats(completionSamples));
+    }
+}
+
+// 3. Copy 1 byte from host memory to a device buffer and back (COPY-1B-ROUND-TRIP)
+void benchmarkOneByteCopy(CLEnvironment &env, int iterations) {
+    cl_int result;
+    cl_mem deviceBuffer = clCreateBuffer(env.context, CL_MEM_READ_WRITE, 1, nullptr, &result);
+    VALIDATECALL(result);
+    char hostValue = 1;
+    std::vector<double> samples;
+    for (int i = 0; i < WARMUP_ITERATIONS + iterations; i++) {
+        auto begin = std::chrono::steady_clock::now();
+        VALIDATECALL(clEnqueueWriteBuffer(env.queue, deviceBuffer, CL_FALSE, 0, 1, &hostValue, 0, nullptr, nullptr));
+        VALIDATECALL(clEnqueueReadBuffer(env.queue, deviceBuffer, CL_TRUE, 0, 1, &hostValue, 0, nullptr, nullptr));
+        auto end = std::chrono::steady_clock::now();
+        if (i >= WARMUP_ITERATIONS) {
+            samples.push_back(elapsedNs(begin, end));
+        }
+    }
+    printStats("COPY-1B-ROUND-TRIP", computeStats(samples));
+    VALIDATECALL(clReleaseMemObject(deviceBuffer));
+}
+
+int runDispatchLatency(CLEnvironment &env, int iterations) {
+    PhaseTimer moduleTimer("module");
+    cl_program program = buildProgram(env, EMPTY_SOURCE);
+    cl_kernel kernel = createKernel(program, "emptyKernel");
+    moduleTimer.stop();
+
+    // The empty kernel receives one (unused) argument
+    PhaseTimer allocTimer("alloc");
+    cl_int result;
+    cl_mem dummyBuffer = clCreateBuffer(env.context, CL_MEM_READ_WRITE, sizeof(int), nullptr, &result);
+    VALIDATECALL(result);
+    VALIDATECALL(clSetKernelArg(kernel, 0, sizeof(dummyBuffer), &dummyBuffer));
+    allocTimer.stop();
+
+    {
+        PHASE_TIMER("kernel");
+        benchmarkEmptyKernel(env, kernel, iterations);
+        benchmarkSubmission(env, kernel, iterations);
+    }
+    {
+        PHASE_TIMER("transfer");
+        benchmarkOneByteCopy(env, iterations);
+    }
+
+    PHASE_TIMER("cleanup");
+    VALIDATECALL(clReleaseMemObject(dummyBuffer));
+    VALIDATECALL(clReleaseKernel(kernel));
+    VALIDATECALL(clReleaseProgram(program));
+    return 0;
+}
+
+// Buffer modes, with the letters of levelZeroShared:
+//  d: device buffers, copies from/to heap memory (new)
+//  c: device buffers, copies from/to pinned host memory (CL_MEM_ALLOC_HOST_PTR, mapped)
+//  h: host buffers (CL_MEM_ALLOC_HOST_PTR) used directly by the kernel
+//  s: shared virtual memory (clSVMAlloc, coarse grain, map/unmap around host accesses)
+//  z: heap memory wrapped with CL_MEM_USE_HOST_PTR (zero-copy if the runtime allows it)
+class KernelBuffer {
+public:
+    KernelBuffer(CLEnvironment &env, char mode, size_t size) : env(env), mode(mode), size(size) {
+        cl_int result = CL_SUCCESS;
+        switch (mode) {
+        case 'd':
+            heap.resize(size);
+            hostView = heap.data();
+            buffer = clCreateBuffer(env.context, CL_MEM_READ_WRITE, size, nullptr, &result);
+            break;
+        case 'c':
+            staging = clCreateBuffer(env.context, CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR, size, nullptr, &result);
+            VALIDATECALL(result);
+            hostView = clEnqueueMapBuffer(env.queue, staging, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE, 0, size, 0, nullptr, nullptr, &result);
+            VALIDATECALL(result);
+            buffer = clCreateBuffer(env.context, CL_MEM_READ_WRITE, size, nullptr, &result);
+            break;
+        case 'h':
+            buffer = clCreateBuffer(env.context, CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR, size, nullptr, &result);
+            break;
+        case 's':
+            svm = clSVMAlloc(env.context, CL_MEM_READ_WRITE, size, 0);
+            if (svm == nullptr) {
+                std::cout << "clSVMAlloc failed" << std::endl;
+                std::terminate();
+            }
+            break;
+        case 'z':
+            // CL_MEM_USE_HOST_PTR is only zero-copy with aligned pointers (4 KB on most runtimes)
+            heap.resize(size + 4096);
+            hostView = heap.data() + (4096 - reinterpret_cast<uintptr_t>(heap.data()) % 4096) % 4096;
+            buffer = clCreateBuffer(env.context, CL_MEM_READ_WRITE | CL_MEM_USE_HOST_PTR, size, hostView, &result);
+            break;
+        }
+        VALIDATECALL(result);
+    }
+
+    ~KernelBuffer() {
+        if (staging != nullptr) {
+            clEnqueueUnmapMemObject(env.queue, staging, hostView, 0, nullptr, nullptr);
+            clFinish(env.queue);
+            clReleaseMemObject(staging);
+        }
+        if (buffer != nullptr) {
+            clReleaseMemObject(buffer);
+        }
+        if (svm != nullptr) {
+            clSVMFree(env.context, svm);
+        }
+    }
+
+    void setArg(cl_kernel kernel, cl_uint index) {
+        if (mode == 's') {
+            VALIDATECALL(clSetKernelArgSVMPointer(kernel, index, svm));
+        } else {
+            VALIDATECALL(clSetKernelArg(kernel, index, sizeof(buffer), &buffer));
+        }
+    }
+
+    // Host pointer to read or write the data outside of the timed loop (blocking)
+    void *map() {
+        cl_int result = CL_SUCCESS;
+        if (mode == 'h' || mode == 'z') {
+            mapped = clEnqueueMapBuffer(env.queue, buffer, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE, 0, size, 0, nullptr, nullptr, &result);
+            VALIDATECALL(result);
+            return mapped;
+        }
+        if (mode == 's') {
+            VALIDATECALL(clEnqueueSVMMap(env.queue, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE, svm, size, 0, nullptr, nullptr));
+            return svm;
+        }
+        return hostView;
+    }
+
+    void unmap() {
+        if (mode == 'h' || mode == 'z') {
+            VALIDATECALL(clEnqueueUnmapMemObject(env.queue, buffer, mapped, 0, nullptr, nullptr));
+        } else if (mode == 's') {
+            VALIDATECALL(clEnqueueSVMUnmap(env.queue, svm, 0, nullptr, nullptr));
+        }
+        VALIDATECALL(clFinish(env.queue));
+    }
+
+    // Host -> device before the kernel (only the copy modes)
+    void upload() {
+        if (mode == 'd' || mode == 'c') {
+            VALIDATECALL(clEnqueueWriteBuffer(env.queue, buffer, CL_FALSE, 0, size, hostView, 0, nullptr, nullptr));
+        }
+    }
+
+    // Device -> host after the kernel: a copy, or a map/unmap to make the result visible to the host
+    void download() {
+        if (mode == 'd' || mode == 'c') {
+            VALIDATECALL(clEnqueueReadBuffer(env.queue, buffer, CL_FALSE, 0, size, hostView, 0, nullptr, nullptr));
+        } else if (mode == 'h' || mode == 'z') {
+            cl_int result;
+            void *ptr = clEnqueueMapBuffer(env.queue, buffer, CL_FALSE, CL_MAP_READ, 0, size, 0, nullptr, nullptr, &result);
+            VALIDATECALL(result);
+            VALIDATECALL(clEnqueueUnmapMemObject(env.queue, buffer, ptr, 0, nullptr, nullptr));
+        } else if (mode == 's') {
+            VALIDATECALL(clEnqueueSVMMap(env.queue, CL_FALSE, CL_MAP_READ, svm, size, 0, nullptr, nullptr));
+            VALIDATECALL(clEnqueueSVMUnmap(env.queue, svm, 0, nullptr, nullptr));
+        }
+    }
+
+private:
+    CLEnvironment &env;
+    char mode;
+    size_t size;
+    std::vector<char> heap;
+    void *hostView = nullptr;
+    void *mapped = nullptr;
+    cl_mem buffer = nullptr;
+    cl_mem staging = nullptr;
+    void *svm = nullptr;
+};
+
+// Sequential references to validate results
+void matrixMultiply(const float *a, const float *b, float *c, int n) {
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            float sum = 0;
+            for (int k = 0; k < n; k++) {
+                sum += a[i * n + k] * b[k * n + j];
+            }
+            c[i * n + j] = sum;
+        }
+    }
+}
+
+void matrixMultiply(const int32_t *a, const int32_t *b, int32_t *c, int n) {
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            int sum = 0;
+            for (int k = 0; k < n; k++) {
+                sum += a[i * n + k] * b[k * n + j];
+            }
+            c[i * n + j] = sum;
+        }
+    }
+}
+
+// Launch pattern of levelZeroShared: per iteration, copy the inputs in, run the kernel, make the
+// output visible to the host, and wait.
+int runKernel(CLEnvironment &env, const std::string &benchmark, char mode, int n, int iterations) {
+    if (mode == 's' && !env.svm) {
+        std::cout << "The device does not support SVM (coarse-grain buffers)" << std::endl;
+        return -1;
+    }
+    bool isMxM = (benchmark != "vadd");
+    size_t elements = isMxM ? static_cast<size_t>(n) * n : n;
+    size_t allocSize = elements * sizeof(int32_t);
+    std::cout << "SIZE: " << n << " mode=" << mode << " (" << allocSize * 1e-9 << " GB per buffer)" << std::endl;
+
+    PhaseTimer moduleTimer("module");
+    const char *source = (benchmark == "mxm") ? MXM_SOURCE : (benchmark == "mxmInt") ? MXM_INT_SOURCE : VADD_SOURCE;
+    cl_program program = buildProgram(env, source);
+    cl_kernel kernel = createKernel(program, isMxM ? "mxm" : "vectorAddition");
+    moduleTimer.stop();
+
+    PhaseTimer allocTimer("alloc");
+    std::vector<std::unique_ptr<KernelBuffer>> inputs;
+    inputs.emplace_back(new KernelBuffer(env, mode, allocSize));
+    if (isMxM) {
+        inputs.emplace_back(new KernelBuffer(env, mode, allocSize));
+    }
+    KernelBuffer output(env, mode, allocSize);
+    allocTimer.stop();
+
+    // Copies of the inputs, for the validation
+    PhaseTimer hostInitTimer("host-init");
+    std::vector<std::vector<char>> inputData;
+    for (size_t in = 0; in < inputs.size(); in++) {
+        void *ptr = inputs[in]->map();
+        for (size_t i = 0; i < elements; i++) {
+            if (benchmark == "mxm") {
+                static_cast<float *>(ptr)[i] = static_cast<float>((i + in) % 7) * 0.25f;
+            } else {
+                static_cast<int32_t *>(ptr)[i] = static_cast<int32_t>((i + in) % 5);
+            }
+        }
+        inputData.emplace_back(static_cast<char *>(ptr), static_cast<char *>(ptr) + allocSize);
+        inputs[in]->unmap();
+    }
+    hostInitTimer.stop();
+
+    for (cl_uint in = 0; in < inputs.size(); in++) {
+        inputs[in]->setArg(kernel, in);
+    }
+    output.setArg(kernel, inputs.size());
+    if (isMxM) {
+        VALIDATECALL(clSetKernelArg(kernel, 3, sizeof(int), &n));
+    }
+    size_t globalSize[2] = {static_cast<size_t>(n), static_cast<size_t>(n)};
+    cl_uint dimensions = isMxM ? 2 : 1;
+
+    // KERNEL: profiling start -> end. READY-TO-START: from the moment the kernel can run (it
+    // is enqueued and a profiled marker after the uploads has completed) until it starts on the
+    // device, the dispatch overhead of the runtime. Measuring from QUEUED would include the
+    // input copies in modes d and c, since the kernel waits behind them in the in-order queue.
+    std::vector<double> endToEnd;
+    std::vector<double> kernelSamples;
+    std::vector<double> readyToStart;
+    PhaseTimer kernelTimer("kernel");
+    for (int i = 0; i < WARMUP_ITERATIONS + iterations; i++) {
+        auto begin = std::chrono::steady_clock::now();
+        for (auto &input : inputs) {
+            input->upload();
+        }
+        cl_event uploadedEvent;
+        VALIDATECALL(clEnqueueMarkerWithWaitList(env.queue, 0, nullptr, &uploadedEvent));
+        cl_event kernelEvent;
+        VALIDATECALL(clEnqueueNDRangeKernel(env.queue, kernel, dimensions, nullptr, globalSize, nullptr, 0, nullptr, &kernelEvent));
+        output.download();
+        VALIDATECALL(clFinish(env.queue));
+        auto end = std::chrono::steady_clock::now();
+        if (i >= WARMUP_ITERATIONS) {
+            endToEnd.push_back(elapsedNs(begin, end));
+            kernelSamples.push_back(eventNs(kernelEvent, CL_PROFILING_COMMAND_START, CL_PROFILING_COMMAND_END));
+            cl_ulong ready = std::max(eventTimestamp(uploadedEvent, CL_PROFILING_COMMAND_END),
+                                      eventTimestamp(kernelEvent, CL_PROFILING_COMMAND_QUEUED));
+            readyToStart.push_back(static_cast<double>(eventTimestamp(kernelEvent, CL_PROFILING_COMMAND_START) - ready));
+        }
+        VALIDATECALL(clReleaseEvent(uploadedEvent));
+        VALIDATECALL(clReleaseEvent(kernelEvent));
+    }
+    kernelTimer.stop();
+    printStats("END-TO-END", computeStats(endToEnd));
+    printStats("KERNEL", computeStats(kernelSamples));
+    printStats("READY-TO-START", computeStats(readyToStart));
+
+    bool valid = true;
+    {
+        PHASE_TIMER("validation");
+        void *result = output.map();
+        if (benchmark == "mxm") {
+            const float *a = reinterpret_cast<const float *>(inputData[0].data());
+            const float *b = reinterpret_cast<const float *>(inputData[1].data());
+            std::vector<float> reference(elements);
+            matrixMultiply(a, b, reference.data(), n);
+            // Values are positive: fp32 dot product bound relative to the result
+            for (size_t i = 0; i < elements && valid; i++) {
+                float value = static_cast<float *>(result)[i];
+                valid = std::abs(value - reference[i]) <= 2.0f * n * std::numeric_limits<float>::epsilon() * reference[i];
+            }
+        } else if (benchmark == "mxmInt") {
+            const int32_t *a = reinterpret_cast<const int32_t *>(inputData[0].data());
+            const int32_t *b = reinterpret_cast<const int32_t *>(inputData[1].data());
+            std::vector<int32_t> reference(elements);
+            matrixMultiply(a, b, reference.data(), n);
+            valid = memcmp(result, reference.data(), allocSize) == 0;
+        } else {
+            const int32_t *input = reinterpret_cast<const int32_t *>(inputData[0].data());
+            for (size_t i = 0; i < elements && valid; i++) {
+                valid = static_cast<int32_t *>(result)[i] == input[i] + 100;
+            }
+        }
+        output.unmap();
+    }
+    std::cout << "\nResults validation " << (valid ? "PASSED" : "FAILED") << "\n";
+
+    PHASE_TIMER("cleanup");
+    inputs.clear();
+    VALIDATECALL(clReleaseKernel(kernel));
+    VALIDATECALL(clReleaseProgram(program));
+    return valid ? 0 : -1;
+}
+
+int main(int argc, char **argv) {
+
+    // ./openclBackend empty [iterations]
+    // ./openclBackend <mxm|mxmInt|vadd> <buffers:d|c|h|s|z> <size> [iterations]
+    std::string benchmark = (argc > 1) ? argv[1] : "empty";
+    if (benchmark != "empty" && benchmark != "mxm" && benchmark != "mxmInt" && benchmark != "vadd") {
+        std::cout << "Usage: " << argv[0] << " empty [iterations]\n"
+                  << "       " << argv[0] << " <mxm|mxmInt|vadd> <buffers:d|c|h|s|z> <size> [iterations]" << std::endl;
+        return -1;
+    }
+
+    PhaseTimer initTimer("init");
+    CLEnvironment env;
+    init(env);
+    initTimer.stop();
+
+    int status;
+    if (benchmark == "empty") {
+        int iterations = (argc > 2) ? atoi(argv[2]) : 1000;
+        std::cout << "#Iterations: " << iterations << std::endl;
+        status = runDispatchLatency(env, iterations);
+    } else {
+        char mode = (argc > 2) ? argv[2][0] : 'd';
+        int n = (argc > 3) ? atoi(argv[3]) : 512;
+        int iterations = (argc > 4) ? atoi(argv[4]) : 10;
+        if (std::string("dchsz").find(mode) == std::string::npos) {
+            std::cout << "Unknown buffer mode: " << mode << std::endl;
+            return -1;
+        }
+        status = runKernel(env, benchmark, mode, n, iterations);
+    }
+
+    VALIDATECALL(clReleaseCommandQueue(env.queue));
+    VALIDATECALL(clReleaseContext(env.context));
+    return status;
+}
@@ -0,0 +1,3 @@
+
+clang -cc1 -triple spir spmvCSR.cl -O2 -finclude-default-header -emit-llvm-bc -o spmvCSR.bc
+llvm-spirv spmvCSR.bc -o spmvCSR.spv
@@ -0,0 +1,48 @@
+// Sparse matrix-vector multiplication y = A x, with A in CSR format:
+//  rowPtr[rows + 1]: start of each row in colIdx/values
+//  colIdx[nnz], values[nnz]: column and value of each non-zero
+
+// Scalar-row: one work-item per row. Good for very short rows; for longer rows consecutive
+// work-items read distant parts of colIdx/values (uncoalesced).
+__kernel void spmvScalar(__global const int *rowPtr, __global const int *colIdx, __global const float *values,
+                         __global const float *x, __global float *y, const int rows) {
+	int row = get_global_id(0);
+	if (row >= rows) {
+		return;
+	}
+	float sum = 0.0f;
+	for (int i = rowPtr[row]; i < rowPtr[row + 1]; i++) {
+		sum += values[i] * x[colIdx[i]];
+	}
+	y[row] = sum;
+}
+
+// Vector-row: one work-group per row. The work-items stride through the non-zeros of the row
+// (consecutive work-items read consecutive elements), then the partial sums are reduced in
+// local memory. The work-group size must be VECTOR_SIZE.
+#define VECTOR_SIZE 32
+
+__kernel __attribute__((reqd_work_group_size(VECTOR_SIZE, 1, 1)))
+void spmvVector(__global const int *rowPtr, __global const int *colIdx, __global const float *values,
+                __global const float *x, __global float *y, const int rows) {
+	__local float partial[VECTOR_SIZE];
+	int row = get_group_id(0);
+	int lane = get_local_id(0);
+
+	float sum = 0.0f;
+	for (int i = rowPtr[row] + lane; i < rowPtr[row + 1]; i += VECTOR_SIZE) {
+		sum += values[i] * x[colIdx[i]];
+	}
+	partial[lane] = sum;
+	barrier(CLK_LOCAL_MEM_FENCE);
+
+	for (int offset = VECTOR_SIZE / 2; offset > 0; offset /= 2) {
+		if (lane < offset) {
+			partial[lane] += partial[lane + offset];
+		}
+		barrier(CLK_LOCAL_MEM_FENCE);
+	}
+	if (lane == 0) {
+		y[row] = partial[0];
+	}
+}
@@ -0,0 +1,570 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Sparse matrix-vector multiplication (y = A x) with A in CSR format. Dense kernels waste
+// most of the bandwidth on zeros for very sparse matrices; CSR only stores the non-zeros.
+//  - SCALAR: one work-item per row
+//  - VECTOR: one work-group (32 work-items) per row, with a reduction in local memory
+// Inputs are random matrices with a given density (sparsity sweep), or Matrix Market files.
+// Reports the effective bandwidth (minimum traffic: values, column indices, row pointers,
+// x and y read/written once) and GFLOP/s (2 x nnz), validated against a host reference.
+
+#include <ze_api.h>
+#include "benchStats.hpp"
+#include "cpuBackend.hpp"
+#include "phaseTimer.hpp"
+#include "zeTimestamps.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Work-group size of the vector-row kernel (VECTOR_SIZE in spmvCSR.cl)
+#define VECTOR_SIZE 32
+
+#define VALIDATECALL(myZeCall) \
+    if (myZeCall != ZE_RESULT_SUCCESS){ \
+        std::cout << "Error at "       \
+            << #myZeCall << ": "       \
+            << __FUNCTION__ << ": "    \
+            << __LINE__ << std::endl;  \
+        std::cout << "Exit with Error Code: " \
+            << "0x" << std::hex \
+            << myZeCall \
+            << std::dec << std::endl; \
+        std::terminate(); \
+    }
+
+struct CSRMatrix {
+    int rows;
+    int cols;
+    std::vector<int> rowPtr;
+    std::vector<int> colIdx;
+    std::vector<float> values;
+
+    size_t nnz() const { return values.size(); }
+};
+
+struct Coordinate {
+    int row;
+    int col;
+    float value;
+};
+
+// Build the CSR arrays from unsorted coordinates (duplicates are kept, as in Matrix Market)
+CSRMatrix buildCSR(int rows, int cols, std::vector<Coordinate> &entries) {
+    std::sort(entries.begin(), entries.end(), [](const Coordinate &a, const Coordinate &b) {
+        return (a.row != b.row) ? a.row < b.row : a.col < b.col;
+    });
+    CSRMatrix matrix;
+    matrix.rows = rows;
+    matrix.cols = cols;
+    matrix.rowPtr.assign(rows + 1, 0);
+    matrix.colIdx.resize(entries.size());
+    matrix.values.resize(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        matrix.rowPtr[entries[i].row + 1]++;
+        matrix.colIdx[i] = entries[i].col;
+        matrix.values[i] = entries[i].value;
+    }
+    for (int row = 0; row < rows; row++) {
+        matrix.rowPtr[row + 1] += matrix.rowPtr[row];
+    }
+    return matrix;
+}
+
+// Random matrix: the number of non-zeros of each row follows a binomial distribution
+// (cols, density), with uniformly distributed columns and values in [-1, 1]
+CSRMatrix randomCSR(int rows, int cols, double density, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::binomial_distribution<int> rowLength(cols, density);
+    std::uniform_int_distribution<int> column(0, cols - 1);
+    std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+
+    CSRMatrix matrix;
+    matrix.rows = rows;
+    matrix.cols = cols;
+    matrix.rowPtr.assign(rows + 1, 0);
+    std::vector<int> columns;
+    for (int row = 0; row < rows; row++) {
+        columns.clear();
+        int length = rowLength(generator);
+        for (int i = 0; i < length; i++) {
+            columns.push_back(column(generator));
+        }
+        std::sort(columns.begin(), columns.end());
+        columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+        for (auto col : columns) {
+            matrix.colIdx.push_back(col);
+            matrix.values.push_back(value(generator));
+        }
+        matrix.rowPtr[row + 1] = matrix.colIdx.size();
+    }
+    return matrix;
+}
+
+// Matrix Market reader for "matrix coordinate" files with real, integer or pattern values
+// and general, symmetric or skew-symmetric storage. Indices are 1-based in the file.
+// Malformed files (indices outside the matrix, more or fewer entries than declared) are rejected.
+bool readMatrixMarket(const std::string &fileName, CSRMatrix &matrix) {
+    std::ifstream file(fileName);
+    if (!file.is_open()) {
+        std::cout << "File not found: " << fileName << std::endl;
+        return false;
+    }
+    std::string line;
+    std::getline(file, line);
+    std::istringstream banner(line);
+    std::string header, object, format, field, symmetry;
+    banner >> header >> object >> format >> field >> symmetry;
+    std::transform(object.begin(), object.end(), object.begin(), ::tolower);
+    std::transform(format.begin(), format.end(), format.begin(), ::tolower);
+    std::transform(field.begin(), field.end(), field.begin(), ::tolower);
+    std::transform(symmetry.begin(), symmetry.end(), symmetry.begin(), ::tolower);
+    if (header != "%%MatrixMarket" || object != "matrix" || format != "coordinate" || field == "complex") {
+        std::cout << "Unsupported Matrix Market file (only real/integer/pattern coordinate matrices): " << line << std::endl;
+        return false;
+    }
+    bool pattern = (field == "pattern");
+    bool symmetric = (symmetry == "symmetric");
+    bool skewSymmetric = (symmetry == "skew-symmetric");
+
+    // Skip comments
+    while (std::getline(file, line) && (line.empty() || line[0] == '%')) {
+    }
+    int rows = 0;
+    int cols = 0;
+    size_t entriesInFile = 0;
+    std::istringstream sizes(line);
+    if (!(sizes >> rows >> cols >> entriesInFile) || rows <= 0 || cols <= 0 ||
+        entriesInFile > static_cast<size_t>(rows) * static_cast<size_t>(cols)) {
+        std::cout << "Invalid size line in Matrix Market file: " << line << std::endl;
+        return false;
+    }
+    if ((symmetric || skewSymmetric) && rows != cols) {
+        std::cout << "Symmetric Matrix Market file with a non-square size: " << line << std::endl;
+        return false;
+    }
+
+    std::vector<Coordinate> entries;
+    entries.reserve(symmetric || skewSymmetric ? 2 * entriesInFile : entriesInFile);
+    for (size_t i = 0; i < entriesInFile; i++) {
+        int row;
+        int col;
+        double value = 1.0;
+        file >> row >> col;
+        if (!pattern) {
+            file >> value;
+        }
+        if (!file) {
+            std::cout << "Unexpected end of file after " << i << " entries" << std::endl;
+            return false;
+        }
+        if (row < 1 || row > rows || col < 1 || col > cols) {
+            std::cout << "Entry " << (i + 1) << " (" << row << ", " << col << ") is outside the "
+                      << rows << " x " << cols << " matrix" << std::endl;
+            return false;
+        }
+        entries.push_back({row - 1, col - 1, static_cast<float>(value)});
+        if ((symmetric || skewSymmetric) && row != col) {
+            entries.push_back({col - 1, row - 1, static_cast<float>(skewSymmetric ? -value : value)});
+        }
+    }
+    if (!(file >> std::ws).eof()) {
+        std::cout << "More entries than the " << entriesInFile << " declared in the size line" << std::endl;
+        return false;
+    }
+    matrix = buildCSR(rows, cols, entries);
+    return true;
+}
+
+// Host reference. rowBound[row] = sum |a_ij * x_j|, used for the validation tolerance.
+void cpuSpMV(const CSRMatrix &matrix, const float *x, float *y, float *rowBound) {
+    parallelFor(0, matrix.rows, [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; row++) {
+            float sum = 0.0f;
+            float bound = 0.0f;
+            for (int i = matrix.rowPtr[row]; i < matrix.rowPtr[row + 1]; i++) {
+                float product = matrix.values[i] * x[matrix.colIdx[i]];
+                sum += product;
+                bound += std::abs(product);
+            }
+            y[row] = sum;
+            rowBound[row] = bound;
+        }
+    });
+}
+
+// The kernels add the products in a different order: |y - ref| <= rowLength * eps * sum |a_ij * x_j|
+bool validateSpMV(const CSRMatrix &matrix, const float *y, const float *reference, const float *rowBound) {
+    const float eps = std::numeric_limits<float>::epsilon();
+    for (int row = 0; row < matrix.rows; row++) {
+        int length = matrix.rowPtr[row + 1] - matrix.rowPtr[row];
+        if (std::abs(y[row] - reference[row]) > length * eps * rowBound[row] + std::numeric_limits<float>::min()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Minimum traffic of one SpMV: values + column indices + row pointers + x + y
+double spmvBytes(const CSRMatrix &matrix) {
+    return matrix.nnz() * (sizeof(float) + sizeof(int)) + (matrix.rows + 1) * sizeof(int)
+           + matrix.cols * sizeof(float) + matrix.rows * sizeof(float);
+}
+
+void printSpMVResult(const std::string &label, const CSRMatrix &matrix, const std::string &input,
+                     const std::vector<double> &samples, const std::string &validation) {
+    BenchStats stats = computeStats(samples);
+    printStats(label + " " + input, stats);
+    double density = static_cast<double>(matrix.nnz()) / (static_cast<double>(matrix.rows) * matrix.cols);
+    std::cout << label << " " << input
+              << " rows=" << matrix.rows << " cols=" << matrix.cols << " nnz=" << matrix.nnz()
+              << " sparsity=" << 100.0 * (1.0 - density) << "%"
+              << " GB/s=" << spmvBytes(matrix) / stats.median
+              << " GFLOP/s=" << (2.0 * matrix.nnz()) / stats.median
+              << " validation=" << validation << std::endl;
+}
+
+void init(ze_driver_handle_t &driverHandle, ze_context_handle_t &context, ze_device_handle_t &device ) {
+    // Initialization
+    VALIDATECALL(initLevelZero());
+
+    // Get the driver
+    uint32_t driverCount = 1;
+    VALIDATECALL(zeDriverGet(&driverCount, &driverHandle));
+
+    // Create the context
+    ze_context_desc_t contextDescription = {};
+    contextDescription.stype = ZE_STRUCTURE_TYPE_CONTEXT_DESC;
+    VALIDATECALL(zeContextCreate(driverHandle, &contextDescription, &context));
+
+    // Get the device
+    uint32_t deviceCount = 1;
+    VALIDATECALL(zeDeviceGet(driverHandle, &deviceCount, &device));
+}
+
+uint32_t createCommandQueue(ze_device_handle_t device, ze_context_handle_t context, ze_command_queue_handle_t &cmdQueue) {
+    // Create a command queue
+    uint32_t numQueueGroups = 0;
+    VALIDATECALL(zeDeviceGetCommandQueueGroupProperties(device, &numQueueGroups, nullptr));
+    if (numQueueGroups == 0) {
+        std::cout << "No queue groups found\n";
+        std::terminate();
+    }
+    std::vector<ze_command_queue_group_properties_t> queueProperties(numQueueGroups);
+    VALIDATECALL(zeDeviceGetCommandQueueGroupProperties(device, &numQueueGroups, queueProperties.data()));
+
+    ze_command_queue_desc_t cmdQueueDesc = {ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC};
+    for (uint32_t i = 0; i < numQueueGroups; i++) {
+        if (queueProperties[i].flags & ZE_COMMAND_QUEUE_GROUP_PROPERTY_FLAG_COMPUTE) {
+            cmdQueueDesc.ordinal = i;
+        }
+    }
+
+    cmdQueueDesc.index = 0;
+    cmdQueueDesc.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
+    VALIDATECALL(zeCommandQueueCreate(context, device, &cmdQueueDesc, &cmdQueue));
+
+    return cmdQueueDesc.ordinal;
+}
+
+ze_module_handle_t createModule(ze_context_handle_t context, ze_device_handle_t device, const char *fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "SPIR-V binary file not found\n";
+        std::terminate();
+    }
+    file.seekg(0, file.end);
+    auto length = file.tellg();
+    file.seekg(0, file.beg);
+
+    std::unique_ptr<char[]> spirvInput(new char[length]);
+    file.read(spirvInput.get(), length);
+    file.close();
+
+    ze_module_desc_t moduleDesc = {ZE_STRUCTURE_TYPE_MODULE_DESC};
+    ze_module_build_log_handle_t buildLog;
+    moduleDesc.format = ZE_MODULE_FORMAT_IL_SPIRV;
+    moduleDesc.pInputModule = reinterpret_cast<const uint8_t *>(spirvInput.get());
+    moduleDesc.inputSize = length;
+    moduleDesc.pBuildFlags = "";
+
+    ze_module_handle_t module;
+    auto status = zeModuleCreate(context, device, &moduleDesc, &module, &buildLog);
+    if (status != ZE_RESULT_SUCCESS) {
+        // print log
+        size_t szLog = 0;
+        zeModuleBuildLogGetString(buildLog, &szLog, nullptr);
+
+        char* stringLog = (char*)malloc(szLog);
+        zeModuleBuildLogGetString(buildLog, &szLog, stringLog);
+        std::cout << "Build log: " << stringLog << std::endl;
+    }
+    VALIDATECALL(zeModuleBuildLogDestroy(buildLog));
+    VALIDATECALL(status);
+    return module;
+}
+
+// Device buffers of one CSR matrix and the x/y vectors
+struct DeviceCSR {
+    void *rowPtr;
+    void *colIdx;
+    void *values;
+    void *x;
+    void *y;
+};
+
+struct SpMVContext {
+    ze_context_handle_t context;
+    ze_device_handle_t device;
+    ze_device_properties_t deviceProperties;
+    DeviceTimer timer;
+    ze_command_queue_handle_t cmdQueue;
+    ze_command_list_handle_t cmdList;
+    ze_event_pool_handle_t eventPool;
+    ze_event_handle_t kernelTsEvent;
+    ze_kernel_handle_t scalarKernel;
+    ze_kernel_handle_t vectorKernel;
+};
+
+void executeAndWait(SpMVContext &spmv) {
+    VALIDATECALL(zeCommandListClose(spmv.cmdList));
+    VALIDATECALL(zeCommandQueueExecuteCommandLists(spmv.cmdQueue, 1, &spmv.cmdList, nullptr));
+    VALIDATECALL(zeCommandQueueSynchronize(spmv.cmdQueue, std::numeric_limits<uint64_t>::max()));
+    VALIDATECALL(zeCommandListReset(spmv.cmdList));
+}
+
+void *allocAndCopy(SpMVContext &spmv, const void *src, size_t bytes) {
+    ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
+    void *buffer = nullptr;
+    // Empty matrices still need a valid buffer
+    VALIDATECALL(zeMemAllocDevice(spmv.context, &memAllocDesc, std::max<size_t>(bytes, 4), 64, spmv.device, &buffer));
+    if (src != nullptr && bytes > 0) {
+        VALIDATECALL(zeCommandListAppendMemoryCopy(spmv.cmdList, buffer, src, bytes, nullptr, 0, nullptr));
+    }
+    return buffer;
+}
+
+// Time one kernel (launched repetitions + 1 times, the first one is discarded) and copy y back
+std::vector<double> timeSpMVKernel(SpMVContext &spmv, ze_kernel_handle_t kernel, DeviceCSR &buffers,
+                                   int rows, const ze_group_count_t &dispatch, int repetitions, float *y) {
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 0, sizeof(buffers.rowPtr), &buffers.rowPtr));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 1, sizeof(buffers.colIdx), &buffers.colIdx));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 2, sizeof(buffers.values), &buffers.values));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 3, sizeof(buffers.x), &buffers.x));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 4, sizeof(buffers.y), &buffers.y));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 5, sizeof(rows), &rows));
+
+    std::vector<double> samples;
+    for (int r = 0; r <= repetitions; r++) {
+        VALIDATECALL(zeEventHostReset(spmv.kernelTsEvent));
+        VALIDATECALL(zeCommandListAppendLaunchKernel(spmv.cmdList, kernel, &dispatch, spmv.kernelTsEvent, 0, nullptr));
+        executeAndWait(spmv);
+        ze_kernel_timestamp_result_t timestamp;
+        VALIDATECALL(zeEventQueryKernelTimestamp(spmv.kernelTsEvent, &timestamp));
+        if (r > 0) {
+            samples.push_back(kernelTimestampNs(spmv.timer, timestamp));
+        }
+    }
+    VALIDATECALL(zeCommandListAppendMemoryCopy(spmv.cmdList, y, buffers.y, rows * sizeof(float), nullptr, 0, nullptr));
+    executeAndWait(spmv);
+    return samples;
+}
+
+void runSpMV(SpMVContext &spmv, const CSRMatrix &matrix, const std::string &input, int repetitions) {
+    std::vector<float> x(matrix.cols);
+    for (int i = 0; i < matrix.cols; i++) {
+        x[i] = static_cast<float>(i % 11) * 0.1f - 0.5f;
+    }
+    std::vector<float> reference(matrix.rows);
+    std::vector<float> rowBound(matrix.rows);
+    std::vector<float> y(matrix.rows);
+
+    // Host reference (also timed, as a CPU baseline)
+    std::vector<double> cpuSamples;
+    for (int r = 0; r < repetitions; r++) {
+        auto begin = std::chrono::steady_clock::now();
+        cpuSpMV(matrix, x.data(), reference.data(), rowBound.data());
+        auto end = std::chrono::steady_clock::now();
+        cpuSamples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count());
+    }
+    printSpMVResult("SPMV-CPU", matrix, input, cpuSamples, "REFERENCE");
+
+    PhaseTimer transferTimer("transfer");
+    DeviceCSR buffers;
+    buffers.rowPtr = allocAndCopy(spmv, matrix.rowPtr.data(), matrix.rowPtr.size() * sizeof(int));
+    buffers.colIdx = allocAndCopy(spmv, matrix.colIdx.data(), matrix.colIdx.size() * sizeof(int));
+    buffers.values = allocAndCopy(spmv, matrix.values.data(), matrix.values.size() * sizeof(float));
+    buffers.x = allocAndCopy(spmv, x.data(), x.size() * sizeof(float));
+    buffers.y = allocAndCopy(spmv, nullptr, matrix.rows * sizeof(float));
+    executeAndWait(spmv);
+    transferTimer.stop();
+
+    PhaseTimer kernelTimer("kernel");
+    // SCALAR: one work-item per row (the kernel checks the bounds of the last group)
+    uint32_t groupSizeX = 256;
+    ze_group_count_t scalarDispatch = {(matrix.rows + groupSizeX - 1) / groupSizeX, 1, 1};
+    VALIDATECALL(zeKernelSetGroupSize(spmv.scalarKernel, groupSizeX, 1, 1));
+    std::vector<double> scalarSamples = timeSpMVKernel(spmv, spmv.scalarKernel, buffers, matrix.rows, scalarDispatch, repetitions, y.data());
+    bool scalarValid = validateSpMV(matrix, y.data(), reference.data(), rowBound.data());
+    printSpMVResult("SPMV-SCALAR", matrix, input, scalarSamples, scalarValid ? "PASSED" : "FAILED");
+
+    // VECTOR: one work-group per row
+    ze_group_count_t vectorDispatch = {static_cast<uint32_t>(matrix.rows), 1, 1};
+    VALIDATECALL(zeKernelSetGroupSize(spmv.vectorKernel, VECTOR_SIZE, 1, 1));
+    std::vector<double> vectorSamples = timeSpMVKernel(spmv, spmv.vectorKernel, buffers, matrix.rows, vectorDispatch, repetitions, y.data());
+    bool vectorValid = validateSpMV(matrix, y.data(), reference.data(), rowBound.data());
+    printSpMVResult("SPMV-VECTOR", matrix, input, vectorSamples, vectorValid ? "PASSED" : "FAILED");
+    kernelTimer.stop();
+
+    VALIDATECALL(zeMemFree(spmv.context, buffers.rowPtr));
+    VALIDATECALL(zeMemFree(spmv.context, buffers.colIdx));
+    VALIDATECALL(zeMemFree(spmv.context, buffers.values));
+    VALIDATECALL(zeMemFree(spmv.context, buffers.x));
+    VALIDATECALL(zeMemFree(spmv.context, buffers.y));
+}
+
+// Inputs of the benchmark: Matrix Market files if given, otherwise random n x n matrices
+// from 95% to 99.99% zeros
+std::vector<std::pair<std::string, CSRMatrix>> loadInputs(int n, const std::vector<std::string> &files) {
+    PHASE_TIMER("host-init");
+    std::vector<std::pair<std::string, CSRMatrix>> inputs;
+    if (!files.empty()) {
+        for (auto &fileName : files) {
+            CSRMatrix matrix;
+            if (readMatrixMarket(fileName, matrix)) {
+                inputs.push_back({fileName, matrix});
+            }
+        }
+        return inputs;
+    }
+    const std::vector<double> densities = {0.05, 0.01, 0.001, 0.0001};
+    for (auto density : densities) {
+        std::ostringstream name;
+        name << "random-" << n << "-density=" << density;
+        inputs.push_back({name.str(), randomCSR(n, n, density, 11)});
+    }
+    return inputs;
+}
+
+// No Level Zero GPU available (or CPU_BACKEND=1): host version only
+int runCpuBackend(const std::vector<std::pair<std::string, CSRMatrix>> &inputs, int repetitions) {
+    std::cout << "Device   : CPU backend (" << cpuBackendThreads() << " threads)\n"
+              << "Type     : CPU" << std::endl;
+    PHASE_TIMER("kernel");
+    for (auto &input : inputs) {
+        const CSRMatrix &matrix = input.second;
+        std::vector<float> x(matrix.cols, 1.0f);
+        std::vector<float> y(matrix.rows);
+        std::vector<float> rowBound(matrix.rows);
+        std::vector<double> samples;
+        for (int r = 0; r < repetitions; r++) {
+            auto begin = std::chrono::steady_clock::now();
+            cpuSpMV(matrix, x.data(), y.data(), rowBound.data());
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count());
+        }
+        printSpMVResult("SPMV-CPU", matrix, input.first, samples, "REFERENCE");
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+
+    // ./spmvCSR [n] [repetitions] [file.mtx ...]
+    int n = 16384;
+    int repetitions = 20;
+    if (argc > 1) {
+        n = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        repetitions = atoi(argv[2]);
+    }
+    std::vector<std::string> files(argv + std::min(argc, 3), argv + argc);
+
+    std::vector<std::pair<std::string, CSRMatrix>> inputs = loadInputs(n, files);
+    if (useCpuBackend()) {
+        return runCpuBackend(inputs, repetitions);
+    }
+
+    PhaseTimer initTimer("init");
+    ze_driver_handle_t driverHandle;
+    SpMVContext spmv;
+    init(driverHandle, spmv.context, spmv.device);
+    spmv.deviceProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES_1_2};
+    VALIDATECALL(zeDeviceGetProperties(spmv.device, &spmv.deviceProperties));
+    spmv.timer = deviceTimer(driverHandle, spmv.device);
+    std::cout << "Device   : " << spmv.deviceProperties.name << std::endl;
+
+    uint32_t ordinal = createCommandQueue(spmv.device, spmv.context, spmv.cmdQueue);
+    ze_command_list_desc_t cmdListDesc = {ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC};
+    cmdListDesc.commandQueueGroupOrdinal = ordinal;
+    VALIDATECALL(zeCommandListCreate(spmv.context, spmv.device, &cmdListDesc, &spmv.cmdList));
+
+    ze_event_pool_desc_t eventPoolDesc = {ZE_STRUCTURE_TYPE_EVENT_POOL_DESC};
+    eventPoolDesc.count = 1;
+    eventPoolDesc.flags = ZE_EVENT_POOL_FLAG_KERNEL_TIMESTAMP;
+    VALIDATECALL(zeEventPoolCreate(spmv.context, &eventPoolDesc, 1, &spmv.device, &spmv.eventPool));
+    ze_event_desc_t eventDesc = {ZE_STRUCTURE_TYPE_EVENT_DESC};
+    eventDesc.index = 0;
+    eventDesc.signal = ZE_EVENT_SCOPE_FLAG_HOST;
+    eventDesc.wait = ZE_EVENT_SCOPE_FLAG_HOST;
+    VALIDATECALL(zeEventCreate(spmv.eventPool, &eventDesc, &spmv.kernelTsEvent));
+    initTimer.stop();
+
+    PhaseTimer moduleTimer("module");
+    ze_module_handle_t module = createModule(spmv.context, spmv.device, "spmvCSR.spv");
+    ze_kernel_desc_t kernelDesc = {ZE_STRUCTURE_TYPE_KERNEL_DESC};
+    kernelDesc.pKernelName = "spmvScalar";
+    VALIDATECALL(zeKernelCreate(module, &kernelDesc, &spmv.scalarKernel));
+    kernelDesc.pKernelName = "spmvVector";
+    VALIDATECALL(zeKernelCreate(module, &kernelDesc, &spmv.vectorKernel));
+    moduleTimer.stop();
+
+    for (auto &input : inputs) {
+        runSpMV(spmv, input.second, input.first, repetitions);
+    }
+
+    // Cleanup
+    PHASE_TIMER("cleanup");
+    VALIDATECALL(zeKernelDestroy(spmv.scalarKernel));
+    VALIDATECALL(zeKernelDestroy(spmv.vectorKernel));
+    VALIDATECALL(zeModuleDestroy(module));
+    VALIDATECALL(zeEventDestroy(spmv.kernelTsEvent));
+    VALIDATECALL(zeEventPoolDestroy(spmv.eventPool));
+    VALIDATECALL(zeCommandListDestroy(spmv.cmdList));
+    VALIDATECALL(zeCommandQueueDestroy(spmv.cmdQueue));
+    VALIDATECALL(zeContextDestroy(spmv.context));
+    return 0;
+}
@@ -26,6 +26,8 @@
 from os.path import exists
 from subprocess import Popen, PIPE
 import sqlite3
+import datetime
+import socket
 import re
 import argparse
 
@@ -42,22 +44,52 @@ class BenchmarkDBHandler:
             CREATE TABLE COPY_PERFORMANCE
                 (SIZE INT NOT NULL, 
                  NAME TEXT NOT NULL, 
-                 TIME INT NOT NULL);
+                 TIME INT NOT NULL,
+                 RUN_ID INT);
             ''')
+        self.createRunMetadataTable()
         print("Table created successfully")
         self.conn.close()
    
+    def createRunMetadataTable(self):
+        self.conn.execute('''
+            CREATE TABLE IF NOT EXISTS RUN_METADATA
+                (RUN_ID INTEGER PRIMARY KEY AUTOINCREMENT,
+                 DATE TEXT NOT NULL,
+                 DEVICE TEXT,
+                 DRIVER TEXT,
+                 COMMIT_ID TEXT,
+                 HOST TEXT);
+            ''')
+
     def openDB(self):
         self.conn = sqlite3.connect(dbName)
+        # Databases created before the run metadata: rows without RUN_ID are not part of any run
+        self.createRunMetadataTable()
+        columns = [row[1] for row in self.conn.execute("PRAGMA table_info(COPY_PERFORMANCE)")]
+        if ("RUN_ID" not in columns):
+            self.conn.execute("ALTER TABLE COPY_PERFORMANCE ADD COLUMN RUN_ID INT")
+        self.conn.commit()
         return self.conn
 
+    def createRun(self, device, driver, commitId):
+        cursor = self.conn.execute("INSERT INTO RUN_METADATA(DATE, DEVICE, DRIVER, COMMIT_ID, HOST) VALUES(?, ?, ?, ?, ?)",
+            (datetime.datetime.now().isoformat(timespec='seconds'), device, driver, commitId, socket.gethostname()))
+        self.conn.commit()
+        return cursor.lastrowid
+
+    def queryRuns(self):
+        cursor = self.conn.execute("SELECT r.run_id, r.date, r.device, r.driver, r.commit_id, r.host, Count(p.time) \
+            FROM RUN_METADATA r LEFT JOIN COPY_PERFORMANCE p ON p.run_id = r.run_id GROUP BY r.run_id ORDER BY r.run_id")
+        print("RUN_ID DATE DEVICE DRIVER COMMIT HOST ROWS")
+        for row in cursor:
+            print(row[0], row[1], "'" + str(row[2]) + "'", row[3], row[4], row[5], row[6])
+
     def closeDB(self):
         self.conn.close()
 
-    def insertRowInDataBase(self, size, name, timer):
-        name = "'" + name + "'"
-        self.conn.execute("INSERT INTO COPY_PERFORMANCE(SIZE, NAME, TIME) \
-            VALUES(" + str(size) + "," + str(name) + "," + str(timer) + ")")
+    def insertRowInDataBase(self, size, name, timer, runId):
+        self.conn.execute("INSERT INTO COPY_PERFORMANCE(SIZE, NAME, TIME, RUN_ID) VALUES(?, ?, ?, ?)", (size, name, timer, runId))
         self.conn.commit()
 
     def queryDB(self):
@@ -83,6 +115,26 @@ class CommandBenchmark:
 
     def __init__(self, dbHandler):
         self.dbHandler = dbHandler
+        self.runId = None
+
+    def gitCommit(self):
+        try:
+            p = Popen(["git", "rev-parse", "--short", "HEAD"], stdout=PIPE, stderr=PIPE, encoding='utf8')
+            out, err = p.communicate()
+            return out.strip() if p.returncode == 0 else None
+        except OSError:
+            return None
+
+    # The run is registered with the device and driver printed by the first execution
+    def registerRun(self, out):
+        if (self.runId != None):
+            return
+        device = re.search(r"Device   : (.*)", out)
+        driver = re.search(r"Driver   : (\d+)", out)
+        self.runId = self.dbHandler.createRun(device.group(1).strip() if device else None, 
+                                              driver.group(1) if driver else None, 
+                                              self.gitCommit())
+        print("Run ID: " + str(self.runId))
 
     def runCommand(self, command, size):
         p = Popen([command, str(size)], stdin=PIPE, stdout=PIPE, stderr=PIPE, encoding='utf8')
@@ -106,20 +158,21 @@ class CommandBenchmark:
             out, err, returncode = self.runCommand(command, size)
             while (returncode != 0):
                 out, err, returncode = self.runCommand(command, size)     
+            self.registerRun(out)
 
             m = re.findall(r"SHARED: (\d+)", out)
             
             if (m != None):
                 for match in m:
                     timer = int(match)
-                    self.dbHandler.insertRowInDataBase(size, 'Shared->Shared', timer)       
+                    self.dbHandler.insertRowInDataBase(size, 'Shared->Shared', timer, self.runId)       
 
             m = re.findall(r"Heap->Device: (\d+)", out)
             
             if (m != None):
                 for match in m:
                     timer = int(match)
-                    self.dbHandler.insertRowInDataBase(size, 'Heap->Device', timer)
+                    self.dbHandler.insertRowInDataBase(size, 'Heap->Device', timer, self.runId)
 
 
             m = re.findall(r"Device->Heap: (\d+)", out)
@@ -127,7 +180,7 @@ class CommandBenchmark:
             if (m != None):
                 for match in m:
                     timer = int(match)
-                    self.dbHandler.insertRowInDataBase(size, 'Device->Heap', timer)
+                    self.dbHandler.insertRowInDataBase(size, 'Device->Heap', timer, self.runId)
 
 
             m = re.findall(r"DEVICE->DEVICE: (\d+)", out)
@@ -135,7 +188,7 @@ class CommandBenchmark:
             if (m != None):
                 for match in m:
                     timer = int(match)
-                    self.dbHandler.insertRowInDataBase(size, 'Device->Device', timer)
+                    self.dbHandler.insertRowInDataBase(size, 'Device->Device', timer, self.runId)
 
 
             m = re.findall(r"HOST->DEVICE: (\d+)", out)
@@ -143,7 +196,7 @@ class CommandBenchmark:
             if (m != None):
                 for match in m:
                     timer = int(match)
-                    self.dbHandler.insertRowInDataBase(size, 'Host->Device', timer)        
+                    self.dbHandler.insertRowInDataBase(size, 'Host->Device', timer, self.runId)        
 
 
             m = re.findall(r"DEVICE->HOST: (\d+)", out)
@@ -151,7 +204,7 @@ class CommandBenchmark:
             if (m != None):
                 for match in m:
                     timer = int(match)
-                    self.dbHandler.insertRowInDataBase(size, 'Device->Host', timer)
+                    self.dbHandler.insertRowInDataBase(size, 'Device->Host', timer, self.runId)
 
 
     def runAll(self):
@@ -175,6 +228,7 @@ def parseArguments():
     parser.add_argument('--version', action="store_true", dest="version", default=False, help="Print version")
     parser.add_argument("--query", "-q", action="store_true", dest="queryDataBase", default=False, help="Query Data Base")
     parser.add_argument("--performance", "-p", action="store_true", dest="queryPerformance", default=False, help="Query Data Base - Performance Metrics")
+    parser.add_argument("--runs", action="store_true", dest="queryRuns", default=False, help="List the runs (device, driver, commit, date)")
     parser.add_argument("--run", "-r", action="store_true", dest="runBenchmarks", default=False, help="Run Benchmarks and store results in the DB")
     args = parser.parse_args()
     return args
@@ -198,6 +252,12 @@ if __name__ == "__main__":
         benchmarks = CommandBenchmark(dbHandler)
         benchmarks.runAll()
 
+    elif (args.queryRuns):
+        dbHandler = BenchmarkDBHandler(dbName)
+        dbHandler.openDB()
+        dbHandler.queryRuns()
+        dbHandler.closeDB()
+
     elif (args.version):
         print("0.1")
 
@@ -26,6 +26,12 @@
 //      https://github.com/intel/compute-runtime/blob/master/level_zero/core/test/black_box_tests/zello_timestamp.cpp
 
 #include <ze_api.h>
+#include "benchStats.hpp"
+#include "cpuBackend.hpp"
+#include "hugePages.hpp"
+#include "phaseTimer.hpp"
+#include "parallelInit.hpp"
+#include "zeTimestamps.hpp"
 
 #include <chrono>
 #include <cstring>
@@ -52,8 +58,9 @@
 
 
 void init(ze_driver_handle_t &driverHandle, ze_context_handle_t &context, ze_device_handle_t &device ) {
+    PHASE_TIMER("init");
     // Initialization
-    VALIDATECALL(zeInit(ZE_INIT_FLAG_GPU_ONLY));
+    VALIDATECALL(initLevelZero());
 
     // Get the driver
     uint32_t driverCount = 0;
@@ -73,17 +80,21 @@ void init(ze_driver_handle_t &driverHandle, ze_context_handle_t &context, ze_dev
     VALIDATECALL(zeDeviceGet(driverHandle, &deviceCount, &device));
 }
 
-void printBasicInfo(ze_device_handle_t device) {
+void printBasicInfo(ze_driver_handle_t driverHandle, ze_device_handle_t device) {
     // Print basic properties of the device
     ze_device_properties_t deviceProperties = {};
     VALIDATECALL(zeDeviceGetProperties(device, &deviceProperties));
+    ze_driver_properties_t driverProperties = {ZE_STRUCTURE_TYPE_DRIVER_PROPERTIES};
+    VALIDATECALL(zeDriverGetProperties(driverHandle, &driverProperties));
     std::cout << "Device   : " << deviceProperties.name << "\n" 
               << "Type     : " << ((deviceProperties.type == ZE_DEVICE_TYPE_GPU) ? "GPU" : "FPGA") << "\n"
-              << "Vendor ID: " << std::hex << deviceProperties.vendorId << std::dec << "\n";
+              << "Vendor ID: " << std::hex << deviceProperties.vendorId << std::dec << "\n"
+              << "Driver   : " << driverProperties.driverVersion << "\n";
 
 }
 
 uint32_t createCommandQueue(ze_device_handle_t device, ze_context_handle_t context, ze_command_queue_handle_t &cmdQueue) {
+    PHASE_TIMER("init");
     // Create a command queue
     uint32_t numQueueGroups = 0;
     VALIDATECALL(zeDeviceGetCommandQueueGroupProperties(device, &numQueueGroups, nullptr));
@@ -112,12 +123,24 @@ uint32_t createCommandQueue(ze_device_handle_t device, ze_context_handle_t conte
 }
 
 void createCommandList(ze_device_handle_t device, ze_context_handle_t context, ze_command_list_handle_t &cmdList, uint32_t ordinal) {
+    PHASE_TIMER("init");
     // Create a command list
     ze_command_list_desc_t cmdListDesc = {};
     cmdListDesc.commandQueueGroupOrdinal = ordinal;    
     VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &cmdList));
 }
 
+// Median bandwidth of the copies in both directions
+struct CopyBandwidth {
+    double inGBs;
+    double outGBs;
+};
+
+double medianBandwidth(size_t bytes, const std::vector<double> &durationsNs) {
+    BenchStats stats = computeStats(durationsNs);
+    return (stats.median > 0) ? bytes / stats.median : 0;
+}
+
 int profileWithSharedMemoryCopies(int inputBytes) {
 
     ze_driver_handle_t driverHandle;
@@ -126,7 +149,7 @@ int profileWithSharedMemoryCopies(int inputBytes) {
 
     init(driverHandle, context, device);
 
-    printBasicInfo(device);
+    printBasicInfo(driverHandle, device);
    
     ze_command_queue_handle_t cmdQueue;
     uint32_t ordinal = createCommandQueue(device, context, cmdQueue);
@@ -135,6 +158,8 @@ int profileWithSharedMemoryCopies(int inputBytes) {
     ze_command_list_handle_t cmdList;
     createCommandList(device, context, cmdList, ordinal);
 
+    PhaseTimer allocTimer("alloc");
+
     size_t allocSize = inputBytes;
     ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
     memAllocDesc.flags = ZE_DEVICE_MEM_ALLOC_FLAG_BIAS_UNCACHED;
@@ -156,10 +181,16 @@ int profileWithSharedMemoryCopies(int inputBytes) {
     VALIDATECALL(zeMemAllocDevice(context, &memAllocDesc, allocSizeTimer, 1, device, &timeStampStartOut));
     VALIDATECALL(zeMemAllocDevice(context, &memAllocDesc, allocSizeTimer, 1, device, &timeStampStopOut));
 
+    allocTimer.stop();
+
     // memory initialization
-    memset(sharedA, 2.5, allocSize);
-    memset(dstResult, 0.0, allocSize);
+    PhaseTimer hostInitTimer("host-init");
+    parallelMemset(sharedA, 2.5, allocSize, firstTouchNode(device));
+    parallelMemset(dstResult, 0.0, allocSize, firstTouchNode(device));
+
+    hostInitTimer.stop();
 
+    PhaseTimer transferTimer("transfer");
     for (int i = 0; i < MAX_ITERATIONS; i++) {
 
         VALIDATECALL(zeCommandListAppendWriteGlobalTimestamp(cmdList, (uint64_t *)timeStampStartOut, nullptr, 0, nullptr));
@@ -182,16 +213,17 @@ int profileWithSharedMemoryCopies(int inputBytes) {
         auto elapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
         //std::cout << "C++ Timer = " << elapsedTime << " [ns]" << std::endl;
 
-        ze_device_properties_t devProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES};  
-        VALIDATECALL(zeDeviceGetProperties(device, &devProperties));
+        DeviceTimer timer = deviceTimer(driverHandle, device);
 
-        uint64_t copyOutDuration = timeStopOut - timeStartOut;
-        uint64_t timerResolution = devProperties.timerResolution;
-        std::cout << "SHARED: " << copyOutDuration * timerResolution << " ns\n";
+        double copyOutDuration = globalTimestampNs(timer, timeStartOut, timeStopOut);
+        std::cout << "SHARED: " << static_cast<uint64_t>(copyOutDuration) << " ns\n";
 
     }
 
+    transferTimer.stop();
+
     // Cleanup
+    PHASE_TIMER("cleanup");
     VALIDATECALL(zeMemFree(context, dstResult));
     VALIDATECALL(zeMemFree(context, timeStampStartOut));
     VALIDATECALL(zeMemFree(context, timeStampStopOut));
@@ -202,7 +234,9 @@ int profileWithSharedMemoryCopies(int inputBytes) {
     return 0;
 }
 
-int profilerDedicatedMemoryCopies(int inputBytes) {
+// Copies between C++ heap buffers and device memory. The heap buffers can be backed by huge pages
+// (see common/hugePages.hpp) to compare against the normal 4KB pages.
+int profilerDedicatedMemoryCopies(int inputBytes, HostPageMode pageMode = HostPageMode::NORMAL, CopyBandwidth *bandwidth = nullptr) {
 
     ze_driver_handle_t driverHandle;
     ze_context_handle_t context;
@@ -210,7 +244,7 @@ int profilerDedicatedMemoryCopies(int inputBytes) {
 
     init(driverHandle, context, device);
 
-    printBasicInfo(device);
+    printBasicInfo(driverHandle, device);
    
     ze_command_queue_handle_t cmdQueue;
     uint32_t ordinal = createCommandQueue(device, context, cmdQueue);
@@ -219,6 +253,8 @@ int profilerDedicatedMemoryCopies(int inputBytes) {
     ze_command_list_handle_t cmdList;
     createCommandList(device, context, cmdList, ordinal);
 
+    PhaseTimer allocTimer("alloc");
+
     size_t allocSize = inputBytes;
 
     ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
@@ -247,14 +283,40 @@ int profilerDedicatedMemoryCopies(int inputBytes) {
     VALIDATECALL(zeMemAllocDevice(context, &memAllocDesc, allocSizeTimer, 1, device, &timeStampStartOut));
     VALIDATECALL(zeMemAllocDevice(context, &memAllocDesc, allocSizeTimer, 1, device, &timeStampStopOut));
     
+    allocTimer.stop();
+
     int elements = inputBytes / 4;
-    float *heapBuffer = new float[elements];
-    for (int i = 0; i < elements; i++) {
-        heapBuffer[i] = 10.0;
+    PhaseTimer hostInitTimer("host-init");
+    HostPages heapPages = allocHostPages(elements * sizeof(float), pageMode);
+    HostPages heapPages2 = allocHostPages(elements * sizeof(float), pageMode);
+    if (heapPages.ptr == nullptr || heapPages2.ptr == nullptr) {
+        std::cout << "Error: host buffers could not be allocated" << std::endl;
+        std::terminate();
+    }
+    float *heapBuffer = static_cast<float *>(heapPages.ptr);
+    parallelFill(heapBuffer, elements, 10.0f, firstTouchNode(device));
+
+    // The destination of the Device->Heap copy is only pre-faulted with huge pages, so the page
+    // size is in place before the copy. With 4KB pages it is left untouched, as in the original
+    // benchmark, to keep the Device->Heap numbers comparable with the existing databases.
+    float *heapBuffer2 = static_cast<float *>(heapPages2.ptr);
+    if (pageMode != HostPageMode::NORMAL) {
+        parallelFill(heapBuffer2, elements, 0.0f, firstTouchNode(device));
     }
 
-    float *heapBuffer2 = new float[elements];
+    // The normal path keeps the original keys, so runBenchmarks.py only stores 4KB-page results
+    std::string heapLabel = "Heap";
+    if (pageMode != HostPageMode::NORMAL) {
+        heapLabel = "Heap(" + hostPageModeName(heapPages.mode) + ")";
+        std::cout << "Heap pages: " << hostPageModeName(heapPages.mode) 
+                  << " (" << hugePageBackedBytes(heapBuffer) << " bytes backed by huge pages)" << std::endl;
+    }
+    std::vector<double> copyInTimes;
+    std::vector<double> copyOutTimes;
 
+    hostInitTimer.stop();
+
+    PhaseTimer transferTimer("transfer");
     for (int i = 0; i < MAX_ITERATIONS; i++) {
 
         // Copy from HEAP -> Device Allocated Memory
@@ -288,20 +350,34 @@ int profilerDedicatedMemoryCopies(int inputBytes) {
         auto elapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
         //std::cout << "C++ Timer = " << elapsedTime << " [ns]" << std::endl;
 
-        ze_device_properties_t devProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES};
-        VALIDATECALL(zeDeviceGetProperties(device, &devProperties));
+        DeviceTimer timer = deviceTimer(driverHandle, device);
 
-        uint64_t copyInDuration = timeStopIn - timeStartIn;
-        uint64_t copyOutDuration = timeStopOut - timeStartOut;
-        uint64_t timerResolution = devProperties.timerResolution;
+        double copyInDuration = globalTimestampNs(timer, timeStartIn, timeStopIn);
+        double copyOutDuration = globalTimestampNs(timer, timeStartOut, timeStopOut);
         std::cout << "-------------: \n"
               << std::fixed
-              << "Heap->Device: " << copyInDuration * timerResolution << " ns\n"
-              << "Device->Heap: " << copyOutDuration * timerResolution << " ns\n";
+              << heapLabel << "->Device: " << static_cast<uint64_t>(copyInDuration) << " ns\n"
+              << "Device->" << heapLabel << ": " << static_cast<uint64_t>(copyOutDuration) << " ns\n";
+        copyInTimes.push_back(copyInDuration);
+        copyOutTimes.push_back(copyOutDuration);
+
+    }
+
+    transferTimer.stop();
 
+    double inGBs = medianBandwidth(allocSize, copyInTimes);
+    double outGBs = medianBandwidth(allocSize, copyOutTimes);
+    std::cout << "BANDWIDTH " << heapLabel << "->Device: " << inGBs << " GB/s\n"
+              << "BANDWIDTH Device->" << heapLabel << ": " << outGBs << " GB/s\n";
+    if (bandwidth != nullptr) {
+        bandwidth->inGBs = inGBs;
+        bandwidth->outGBs = outGBs;
     }
 
     // Cleanup
+    PHASE_TIMER("cleanup");
+    freeHostPages(heapPages);
+    freeHostPages(heapPages2);
     VALIDATECALL(zeMemFree(context, deviceBuffer));
     VALIDATECALL(zeMemFree(context, timeStampStartIn));
     VALIDATECALL(zeMemFree(context, timeStampStopIn));
@@ -321,7 +397,7 @@ int profileDeviceToDeviceCopy(int inputBytes) {
 
     init(driverHandle, context, device);
 
-    printBasicInfo(device);
+    printBasicInfo(driverHandle, device);
    
     ze_command_queue_handle_t cmdQueue;
     uint32_t ordinal = createCommandQueue(device, context, cmdQueue);
@@ -330,6 +406,8 @@ int profileDeviceToDeviceCopy(int inputBytes) {
     ze_command_list_handle_t cmdList;
     createCommandList(device, context, cmdList, ordinal);
 
+    PhaseTimer allocTimer("alloc");
+
     size_t allocSize = inputBytes;
 
     ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
@@ -361,14 +439,18 @@ int profileDeviceToDeviceCopy(int inputBytes) {
     VALIDATECALL(zeMemAllocDevice(context, &memAllocDesc, allocSizeTimer, 1, device, &timeStampStopIn));
 
     
+    allocTimer.stop();
+
     int elements = inputBytes / 4;
+    PhaseTimer hostInitTimer("host-init");
     float *heapBuffer = new float[elements];
-    for (int i = 0; i < elements; i++) {
-        heapBuffer[i] = 10.0;
-    }
+    parallelFill(heapBuffer, elements, 10.0f, firstTouchNode(device));
 
     float *heapBuffer2 = new float[elements];
 
+    hostInitTimer.stop();
+
+    PhaseTimer transferTimer("transfer");
     for (int i = 0; i < MAX_ITERATIONS; i++) {
 
         VALIDATECALL(zeCommandListAppendMemoryCopy(cmdList, deviceBufferA, heapBuffer, allocSize, nullptr, 0, nullptr));
@@ -394,15 +476,16 @@ int profileDeviceToDeviceCopy(int inputBytes) {
         auto elapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
         //std::cout << "C++ Timer = " << elapsedTime << " [ns]" << std::endl;
 
-        ze_device_properties_t devProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES};
-        VALIDATECALL(zeDeviceGetProperties(device, &devProperties));
+        DeviceTimer timer = deviceTimer(driverHandle, device);
 
-        uint64_t copyInDuration = timeStopIn - timeStartIn;
-        uint64_t timerResolution = devProperties.timerResolution;
-        std::cout << "DEVICE->DEVICE: " << copyInDuration * timerResolution << " ns\n";
+        double copyInDuration = globalTimestampNs(timer, timeStartIn, timeStopIn);
+        std::cout << "DEVICE->DEVICE: " << static_cast<uint64_t>(copyInDuration) << " ns\n";
     }
 
+    transferTimer.stop();
+
     // Cleanup
+    PHASE_TIMER("cleanup");
     VALIDATECALL(zeMemFree(context, deviceBufferA));
     VALIDATECALL(zeMemFree(context, deviceBufferB));
     VALIDATECALL(zeMemFree(context, timeStampStartIn));
@@ -414,7 +497,7 @@ int profileDeviceToDeviceCopy(int inputBytes) {
 }
 
 
-int profileHostMemoryToDeviceCopy(int inputBytes) {
+int profileHostMemoryToDeviceCopy(int inputBytes, CopyBandwidth *bandwidth = nullptr) {
 
     ze_driver_handle_t driverHandle;
     ze_context_handle_t context;
@@ -422,7 +505,7 @@ int profileHostMemoryToDeviceCopy(int inputBytes) {
 
     init(driverHandle, context, device);
 
-    printBasicInfo(device);
+    printBasicInfo(driverHandle, device);
    
     ze_command_queue_handle_t cmdQueue;
     uint32_t ordinal = createCommandQueue(device, context, cmdQueue);
@@ -431,6 +514,8 @@ int profileHostMemoryToDeviceCopy(int inputBytes) {
     ze_command_list_handle_t cmdList;
     createCommandList(device, context, cmdList, ordinal);
 
+    PhaseTimer allocTimer("alloc");
+
     size_t allocSize = inputBytes;
 
     ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
@@ -468,14 +553,20 @@ int profileHostMemoryToDeviceCopy(int inputBytes) {
     
 
     
+    allocTimer.stop();
+
     int elements = inputBytes / 4;
+    PhaseTimer hostInitTimer("host-init");
     float *heapBuffer = new float[elements];
-    for (int i = 0; i < elements; i++) {
-        heapBuffer[i] = 10.0;
-    }
+    parallelFill(heapBuffer, elements, 10.0f, firstTouchNode(device));
 
     float *heapBuffer2 = new float[elements];
 
+    hostInitTimer.stop();
+
+    std::vector<double> copyInTimes;
+    std::vector<double> copyOutTimes;
+    PhaseTimer transferTimer("transfer");
     for (int i = 0; i < MAX_ITERATIONS; i++) {
 
         VALIDATECALL(zeCommandListAppendWriteGlobalTimestamp(cmdList, (uint64_t *)timeStampStartIn, nullptr, 0, nullptr));
@@ -509,19 +600,31 @@ int profileHostMemoryToDeviceCopy(int inputBytes) {
         auto elapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
         //std::cout << "C++ Timer = " << elapsedTime << " [ns]" << std::endl;
 
-        ze_device_properties_t devProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES};
-        VALIDATECALL(zeDeviceGetProperties(device, &devProperties));
+        DeviceTimer timer = deviceTimer(driverHandle, device);
 
-        uint64_t copyInDuration = timeStopIn - timeStartIn;
-        uint64_t copyOutDuration = timeStopOut - timeStartOut;
-        uint64_t timerResolution = devProperties.timerResolution;
+        double copyInDuration = globalTimestampNs(timer, timeStartIn, timeStopIn);
+        double copyOutDuration = globalTimestampNs(timer, timeStartOut, timeStopOut);
         std::cout << "-------------: \n"
               << std::fixed
-              << "HOST->DEVICE: " << copyInDuration * timerResolution << " ns\n"
-              << "DEVICE->HOST: " << copyOutDuration * timerResolution << " ns\n";
+              << "HOST->DEVICE: " << static_cast<uint64_t>(copyInDuration) << " ns\n"
+              << "DEVICE->HOST: " << static_cast<uint64_t>(copyOutDuration) << " ns\n";
+        copyInTimes.push_back(copyInDuration);
+        copyOutTimes.push_back(copyOutDuration);
+    }
+
+    transferTimer.stop();
+
+    double inGBs = medianBandwidth(allocSize, copyInTimes);
+    double outGBs = medianBandwidth(allocSize, copyOutTimes);
+    std::cout << "BANDWIDTH HOST->DEVICE: " << inGBs << " GB/s\n"
+              << "BANDWIDTH DEVICE->HOST: " << outGBs << " GB/s\n";
+    if (bandwidth != nullptr) {
+        bandwidth->inGBs = inGBs;
+        bandwidth->outGBs = outGBs;
     }
 
     // Cleanup
+    PHASE_TIMER("cleanup");
     VALIDATECALL(zeMemFree(context, deviceBuffer));
     VALIDATECALL(zeMemFree(context, hostBuffer));
     VALIDATECALL(zeMemFree(context, timeStampStartIn));
@@ -534,7 +637,50 @@ int profileHostMemoryToDeviceCopy(int inputBytes) {
     return 0;
 }
 
+// CPU backend for the copy benchmarks. The "device" buffers are regular host buffers, and
+// copies are done with multiple threads. It reports the same keys as the Level Zero versions.
+int profileCpuBackendCopies(int inputBytes) {
 
+    std::cout << "Device   : CPU backend (" << cpuBackendThreads() << " threads)\n"
+              << "Type     : CPU" << std::endl;
+
+    PhaseTimer allocTimer("alloc");
+    size_t allocSize = inputBytes;
+    std::vector<char> bufferA(allocSize, 10);
+    std::vector<char> bufferB(allocSize, 0);
+    std::vector<char> bufferC(allocSize, 0);
+    allocTimer.stop();
+
+    auto timeCopy = [](void *dst, const void *src, size_t bytes) {
+        auto begin = std::chrono::steady_clock::now();
+        cpuMemoryCopy(dst, src, bytes);
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
+    };
+
+    PHASE_TIMER("transfer");
+    for (int i = 0; i < MAX_ITERATIONS; i++) {
+        std::cout << "SHARED: " << timeCopy(bufferB.data(), bufferA.data(), allocSize) << " ns\n";
+    }
+    for (int i = 0; i < MAX_ITERATIONS; i++) {
+        auto copyIn = timeCopy(bufferB.data(), bufferA.data(), allocSize);
+        auto copyOut = timeCopy(bufferC.data(), bufferB.data(), allocSize);
+        std::cout << "-------------: \n"
+              << "Heap->Device: " << copyIn << " ns\n"
+              << "Device->Heap: " << copyOut << " ns\n";
+    }
+    for (int i = 0; i < MAX_ITERATIONS; i++) {
+        std::cout << "DEVICE->DEVICE: " << timeCopy(bufferC.data(), bufferB.data(), allocSize) << " ns\n";
+    }
+    for (int i = 0; i < MAX_ITERATIONS; i++) {
+        auto copyIn = timeCopy(bufferB.data(), bufferA.data(), allocSize);
+        auto copyOut = timeCopy(bufferA.data(), bufferB.data(), allocSize);
+        std::cout << "-------------: \n"
+              << "HOST->DEVICE: " << copyIn << " ns\n"
+              << "DEVICE->HOST: " << copyOut << " ns\n";
+    }
+    return 0;
+}
 
 int main(int argc, char**argv) {
 
@@ -545,13 +691,47 @@ int main(int argc, char**argv) {
 
     std::cout << "#bytes: " << inputBytes << std::endl;
 
+    if (useCpuBackend()) {
+        // No Level Zero GPU available (or CPU_BACKEND=1)
+        return profileCpuBackendCopies(inputBytes);
+    }
+
+    // HUGE_PAGES=thp|2M|1G runs the heap copies a second time with huge-page backed buffers
+    HostPageMode pageMode = hostPageModeFromEnv();
+    if (argc > 2) {
+        pageMode = hostPageModeFromString(argv[2]);
+    }
+
     profileWithSharedMemoryCopies(inputBytes);
 
-    profilerDedicatedMemoryCopies(inputBytes);
+    CopyBandwidth heapBandwidth = {};
+    profilerDedicatedMemoryCopies(inputBytes, HostPageMode::NORMAL, &heapBandwidth);
+
+    CopyBandwidth hugeBandwidth = {};
+    if (pageMode != HostPageMode::NORMAL) {
+        profilerDedicatedMemoryCopies(inputBytes, pageMode, &hugeBandwidth);
+    }
 
     profileDeviceToDeviceCopy(inputBytes);
 
-    profileHostMemoryToDeviceCopy(inputBytes);
+    CopyBandwidth hostBandwidth = {};
+    profileHostMemoryToDeviceCopy(inputBytes, &hostBandwidth);
+
+    if (pageMode != HostPageMode::NORMAL) {
+        // Fraction of the gap between pageable 4KB heap memory and zeMemAllocHost closed by huge pages
+        auto gapClosed = [](double normal, double huge, double host) {
+            return (host != normal) ? 100.0 * (huge - normal) / (host - normal) : 0.0;
+        };
+        std::string name = hostPageModeName(pageMode);
+        std::cout << "HUGEPAGES-" << name << " Heap->Device: " << hugeBandwidth.inGBs << " GB/s"
+                  << " (4K: " << heapBandwidth.inGBs << " GB/s, zeMemAllocHost: " << hostBandwidth.inGBs << " GB/s)"
+                  << " speedup=" << (heapBandwidth.inGBs > 0 ? hugeBandwidth.inGBs / heapBandwidth.inGBs : 0)
+                  << " gap-closed=" << gapClosed(heapBandwidth.inGBs, hugeBandwidth.inGBs, hostBandwidth.inGBs) << "%\n";
+        std::cout << "HUGEPAGES-" << name << " Device->Heap: " << hugeBandwidth.outGBs << " GB/s"
+                  << " (4K: " << heapBandwidth.outGBs << " GB/s, zeMemAllocHost: " << hostBandwidth.outGBs << " GB/s)"
+                  << " speedup=" << (heapBandwidth.outGBs > 0 ? hugeBandwidth.outGBs / heapBandwidth.outGBs : 0)
+                  << " gap-closed=" << gapClosed(heapBandwidth.outGBs, hugeBandwidth.outGBs, hostBandwidth.outGBs) << "%\n";
+    }
 
     return 0;
 }
@@ -2,3 +2,20 @@
 clang -cc1 -triple spir matrixMultiply.cl -O2 -finclude-default-header -emit-llvm-bc -o matrixMultiply.bc
 llvm-spirv matrixMultiply.bc -o matrixMultiply.spv
 
+clang -cc1 -triple spir matrixMultiplySpec.cl -O2 -finclude-default-header -emit-llvm-bc -o matrixMultiplySpec.bc
+llvm-spirv matrixMultiplySpec.bc -o matrixMultiplySpec.spv
+
+clang -cc1 -triple spir matrixMultiplyFP16.cl -O2 -finclude-default-header -emit-llvm-bc -o matrixMultiplyFP16.bc
+llvm-spirv matrixMultiplyFP16.bc -o matrixMultiplyFP16.spv
+
+clang -cc1 -triple spir matrixMultiplyBF16.cl -O2 -finclude-default-header -emit-llvm-bc -o matrixMultiplyBF16.bc
+llvm-spirv matrixMultiplyBF16.bc -o matrixMultiplyBF16.spv
+
+clang -cc1 -triple spir matrixMultiplyInt8.cl -O2 -finclude-default-header -emit-llvm-bc -o matrixMultiplyInt8.bc
+llvm-spirv matrixMultiplyInt8.bc -o matrixMultiplyInt8.spv
+
+clang -cc1 -triple spir matrixMultiplyDP4A.cl -O2 -finclude-default-header -cl-std=CL3.0 -cl-ext=+cl_khr_integer_dot_product,+__opencl_c_integer_dot_product_input_4x8bit -emit-llvm-bc -o matrixMultiplyDP4A.bc
+llvm-spirv --spirv-ext=+SPV_KHR_integer_dot_product matrixMultiplyDP4A.bc -o matrixMultiplyDP4A.spv
+
+clang -cc1 -triple spir matrixMultiplyPackedB.cl -O2 -finclude-default-header -emit-llvm-bc -o matrixMultiplyPackedB.bc
+llvm-spirv matrixMultiplyPackedB.bc -o matrixMultiplyPackedB.spv
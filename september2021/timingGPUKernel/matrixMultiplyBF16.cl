@@ -0,0 +1,17 @@
+// bf16 inputs (stored as ushort, the upper 16 bits of a float), fp32 accumulation and output.
+// The conversion is a shift, so it does not need any device extension.
+inline float bf16ToFloat(ushort value) {
+	return as_float(((uint) value) << 16);
+}
+
+__kernel void mxmBF16(__global const ushort *a, __global const ushort *b, __global float *result, const int n) {
+	uint idx = get_global_id(0);
+	uint jdx = get_global_id(1);
+
+	float sum = 0.0f;
+	for (int k = 0; k < n; k++) {
+		sum = fma(bf16ToFloat(a[idx * n + k]), bf16ToFloat(b[k * n + jdx]), sum);
+	}
+
+	result[idx * n + jdx] = sum;
+}
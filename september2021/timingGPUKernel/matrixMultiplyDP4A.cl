@@ -0,0 +1,17 @@
+// int8 inputs, int32 accumulation, using the packed 4x8-bit dot product (dp4a) of 
+// cl_khr_integer_dot_product. Only built on devices with ZE_DEVICE_MODULE_FLAG_DP4A.
+// A is row major (4 consecutive k per char4). B is packed in groups of 4 consecutive k for 
+// each column: bPacked[(k / 4) * n + j] = (b[k][j], b[k+1][j], b[k+2][j], b[k+3][j]).
+// n must be a multiple of 4.
+__kernel void mxmDP4A(__global const char4 *a, __global const char4 *bPacked, __global int *result, const int n) {
+	uint idx = get_global_id(0);
+	uint jdx = get_global_id(1);
+
+	int kGroups = n / 4;
+	int sum = 0;
+	for (int kk = 0; kk < kGroups; kk++) {
+		sum += dot(a[idx * kGroups + kk], bPacked[kk * n + jdx]);
+	}
+
+	result[idx * n + jdx] = sum;
+}
@@ -0,0 +1,14 @@
+#pragma OPENCL EXTENSION cl_khr_fp16 : enable
+
+// fp16 inputs, fp32 accumulation and output. Only built on devices with ZE_DEVICE_MODULE_FLAG_FP16.
+__kernel void mxmFP16(__global const half *a, __global const half *b, __global float *result, const int n) {
+	uint idx = get_global_id(0);
+	uint jdx = get_global_id(1);
+
+	float sum = 0.0f;
+	for (int k = 0; k < n; k++) {
+		sum = fma((float) a[idx * n + k], (float) b[k * n + jdx], sum);
+	}
+
+	result[idx * n + jdx] = sum;
+}
@@ -0,0 +1,12 @@
+// int8 inputs, int32 accumulation and output. Reference kernel without dot-product instructions.
+__kernel void mxmInt8(__global const char *a, __global const char *b, __global int *result, const int n) {
+	uint idx = get_global_id(0);
+	uint jdx = get_global_id(1);
+
+	int sum = 0;
+	for (int k = 0; k < n; k++) {
+		sum += a[idx * n + k] * b[k * n + jdx];
+	}
+
+	result[idx * n + jdx] = sum;
+}
@@ -0,0 +1,52 @@
+// Matrix multiplication with B rearranged once on the host, so the inner loop does not
+// read B with stride n.
+
+// B transposed: bT[j * n + k] = b[k * n + j]. One work-group of DOT_LANES work-items computes
+// one element of C: the lanes split the dot product, so for each step adjacent work-items read
+// adjacent elements of the row of A and of the row of bT (coalesced), and the partial sums are
+// reduced in local memory. The group size must be (DOT_LANES, 1, 1) and n a multiple of it.
+#define DOT_LANES 16
+__kernel void mxmTransposedB(__global float* a, __global float* bT, __global float *result, const int n) {
+	uint lane = get_local_id(0);
+	uint jdx = get_group_id(0);
+	uint idx = get_group_id(1);
+
+	__local float partial[DOT_LANES];
+	float sum = 0.0;
+	for (int k = lane; k < n; k += DOT_LANES) {
+		sum += a[idx * n + k] * bT[jdx * n + k];
+	}
+	partial[lane] = sum;
+	barrier(CLK_LOCAL_MEM_FENCE);
+
+	for (uint stride = DOT_LANES / 2; stride > 0; stride /= 2) {
+		if (lane < stride) {
+			partial[lane] += partial[lane + stride];
+		}
+		barrier(CLK_LOCAL_MEM_FENCE);
+	}
+
+	if (lane == 0) {
+		result[idx * n + jdx] = partial[0];
+	}
+}
+
+// B packed in panels of PACK_WIDTH columns (CPU_PACK_WIDTH in cpuBackend.hpp):
+// packed[(j / PACK_WIDTH) * n * PACK_WIDTH + k * PACK_WIDTH + j % PACK_WIDTH].
+// Consecutive work-items (dimension 0) compute consecutive columns, so for each k they read
+// consecutive elements of the panel (coalesced) and the same element of A (broadcast), and
+// each panel is read sequentially.
+#define PACK_WIDTH 16
+
+__kernel void mxmPackedB(__global float* a, __global float* packed, __global float *result, const int n) {
+	uint jdx = get_global_id(0);
+	uint idx = get_global_id(1);
+
+	__global float *panel = packed + (jdx / PACK_WIDTH) * n * PACK_WIDTH + (jdx % PACK_WIDTH);
+	float sum = 0.0;
+	for (int k = 0; k < n; k++) {
+		sum += a[idx * n + k] * panel[k * PACK_WIDTH];
+	}
+
+	result[idx * n + jdx] = sum;
+}
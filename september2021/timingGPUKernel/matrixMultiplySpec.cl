@@ -0,0 +1,28 @@
+// Matrix multiplication specialized at module build time. N and TILE_K are SPIR-V
+// specialization constants (set with ze_module_constants_t in zeModuleCreate), so the
+// compiler sees them as constants and can unroll/strength-reduce the k loop.
+// N must be a multiple of TILE_K.
+
+#define SPEC_ID_N       0
+#define SPEC_ID_TILE_K  1
+
+// Translated by llvm-spirv into OpSpecConstant <id> with the given default value
+int __attribute__((overloadable)) __spirv_SpecConstant(int id, int defaultValue);
+
+__kernel void mxmSpec(__global float* a, __global float* b, __global float *result) {
+	const int n = __spirv_SpecConstant(SPEC_ID_N, 512);
+	const int tileK = __spirv_SpecConstant(SPEC_ID_TILE_K, 8);
+
+	uint idx = get_global_id(0);
+	uint jdx = get_global_id(1);
+
+	float sum = 0.0;
+	for (int kk = 0; kk < n; kk += tileK) {
+		#pragma unroll
+		for (int k = kk; k < kk + tileK; k++) {
+			sum += a[idx * n + k] * b[k * n + jdx];
+		}
+	}
+
+	result[idx * n + jdx] = sum;
+}
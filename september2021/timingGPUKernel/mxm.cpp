@@ -27,65 +27,1891 @@
 //      https://github.com/intel/compute-runtime/blob/master/level_zero/core/test/black_box_tests/zello_timestamp.cpp
 
 #include <ze_api.h>
+#include "benchStats.hpp"
+#include "phaseTimer.hpp"
+#include "cpuBackend.hpp"
+#include "halfPrecision.hpp"
+#include "parallelInit.hpp"
+#include "zeAsync.hpp"
+#include "zeTimestamps.hpp"
+#include "zeWait.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#define VALIDATION 0
+
+#define VALIDATECALL(myZeCall) \
+    if (myZeCall != ZE_RESULT_SUCCESS){ \
+        std::cout << "Error at "       \
+            << #myZeCall << ": "       \
+            << __FUNCTION__ << ": "    \
+            << __LINE__ << std::endl;  \
+        std::cout << "Exit with Error Code: " \
+            << "0x" << std::hex \
+            << myZeCall \
+            << std::dec << std::endl; \
+        std::terminate(); \
+    }
+
+// Sequential Matrix Multiplication to validate results
+void matrixMultply(float *a, float *b, float *c, int n) {
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            int sum = 0;
+            for (int k = 0; k < n; k++) {
+                sum += a[i * n + k] * b[k * n + j];
+            }
+            c[i * n + j] = sum;
+        }
+    }
+}
+
+// Same loop as matrixMultply, but accumulating in float like matrixMultplyTransposed, so the 
+// two host baselines only differ in the layout of B
+void matrixMultplyRowMajor(float *a, float *b, float *c, int n) {
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            float sum = 0;
+            for (int k = 0; k < n; k++) {
+                sum += a[i * n + k] * b[k * n + j];
+            }
+            c[i * n + j] = sum;
+        }
+    }
+}
+
+// Sequential version with B transposed (bT[j * n + k] = b[k * n + j]): the inner loop reads 
+// two contiguous rows instead of a column of B
+void matrixMultplyTransposed(float *a, float *bT, float *c, int n) {
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            float sum = 0;
+            for (int k = 0; k < n; k++) {
+                sum += a[i * n + k] * bT[j * n + k];
+            }
+            c[i * n + j] = sum;
+        }
+    }
+}
+
+// Reference for the validation: the sequential version, or Strassen-Winograd for large
+// power-of-two sizes, where the O(n^3) reference takes longer than the whole benchmark
+// (see useStrassenReference in cpuBackend.hpp). Returns the absolute error bound of the
+// reference: 0 for the sequential version.
+double referenceMultiply(float *a, float *b, float *c, int n) {
+    if (useStrassenReference(n)) {
+        cpuMatrixMultiplyStrassen(a, b, c, n);
+        return strassenErrorBound(a, b, n);
+    }
+    matrixMultply(a, b, c, n);
+    return 0;
+}
+
+void createEventPoolAndEvents(ze_context_handle_t &context,
+                              ze_device_handle_t &device,
+                              ze_event_pool_handle_t &eventPool,
+                              ze_event_pool_flag_t poolFlag,
+                              uint32_t poolSize,
+                              ze_event_handle_t *events) {
+
+    ze_event_pool_desc_t eventPoolDesc = {ZE_STRUCTURE_TYPE_EVENT_POOL_DESC};
+    ze_event_desc_t eventDesc = {ZE_STRUCTURE_TYPE_EVENT_DESC};
+
+    eventPoolDesc.count = poolSize;
+    eventPoolDesc.flags = poolFlag;
+
+    VALIDATECALL(zeEventPoolCreate(context, &eventPoolDesc, 1, &device, &eventPool));
+
+    for (uint32_t i = 0; i < poolSize; i++) {
+        eventDesc.index = 0;
+        eventDesc.signal = ZE_EVENT_SCOPE_FLAG_HOST;
+        eventDesc.wait = ZE_EVENT_SCOPE_FLAG_HOST;
+        VALIDATECALL(zeEventCreate(eventPool, &eventDesc, events + i));
+    }
+
+}
+
+uint32_t findComputeOrdinal(ze_device_handle_t device) {
+    uint32_t numQueueGroups = 0;
+    VALIDATECALL(zeDeviceGetCommandQueueGroupProperties(device, &numQueueGroups, nullptr));
+    if (numQueueGroups == 0) {
+        std::cout << "No queue groups found\n";
+        std::terminate();
+    }
+    std::vector<ze_command_queue_group_properties_t> queueProperties(numQueueGroups);
+    VALIDATECALL(zeDeviceGetCommandQueueGroupProperties(device, &numQueueGroups, queueProperties.data()));
+
+    uint32_t ordinal = 0;
+    for (uint32_t i = 0; i < numQueueGroups; i++) { 
+        if (queueProperties[i].flags & ZE_COMMAND_QUEUE_GROUP_PROPERTY_FLAG_COMPUTE) {
+            ordinal = i;
+        }
+    }
+    return ordinal;
+}
+
+std::vector<char> readSPIRVFile(const char *fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "SPIR-V binary file not found: " << fileName << "\n";
+        std::terminate();
+    }
+    file.seekg(0, file.end);
+    auto length = file.tellg();
+    file.seekg(0, file.beg);
+    std::vector<char> spirv(length);
+    file.read(spirv.data(), length);
+    file.close();
+    return spirv;
+}
+
+ze_module_handle_t buildModule(ze_context_handle_t context, ze_device_handle_t device, const std::vector<char> &spirv, const char *buildFlags, 
+                               const ze_module_constants_t *constants = nullptr) {
+    PHASE_TIMER("module");
+    ze_module_handle_t module = nullptr;
+    ze_module_desc_t moduleDesc = {ZE_STRUCTURE_TYPE_MODULE_DESC};
+    ze_module_build_log_handle_t buildLog;
+    moduleDesc.format = ZE_MODULE_FORMAT_IL_SPIRV;
+    moduleDesc.pInputModule = reinterpret_cast<const uint8_t *>(spirv.data());
+    moduleDesc.inputSize = spirv.size();
+    moduleDesc.pBuildFlags = buildFlags;
+    moduleDesc.pConstants = constants;
+
+    auto status = zeModuleCreate(context, device, &moduleDesc, &module, &buildLog);
+    if (status != ZE_RESULT_SUCCESS) {
+        // print log
+        size_t szLog = 0;
+        zeModuleBuildLogGetString(buildLog, &szLog, nullptr);
+
+        std::vector<char> stringLog(szLog);
+        zeModuleBuildLogGetString(buildLog, &szLog, stringLog.data());
+        std::cout << "Build log: " << stringLog.data() << std::endl;
+    }
+    VALIDATECALL(zeModuleBuildLogDestroy(buildLog));
+    VALIDATECALL(status);
+    return module;
+}
+
+// Returns the sub-devices (tiles) of every root device. Root devices without
+// sub-devices are returned as they are.
+std::vector<ze_device_handle_t> getAllComputeDevices(ze_driver_handle_t driverHandle) {
+    uint32_t deviceCount = 0;
+    VALIDATECALL(zeDeviceGet(driverHandle, &deviceCount, nullptr));
+    std::vector<ze_device_handle_t> rootDevices(deviceCount);
+    VALIDATECALL(zeDeviceGet(driverHandle, &deviceCount, rootDevices.data()));
+
+    std::vector<ze_device_handle_t> devices;
+    for (auto rootDevice : rootDevices) {
+        uint32_t subDeviceCount = 0;
+        VALIDATECALL(zeDeviceGetSubDevices(rootDevice, &subDeviceCount, nullptr));
+        if (subDeviceCount == 0) {
+            devices.push_back(rootDevice);
+            continue;
+        }
+        std::vector<ze_device_handle_t> subDevices(subDeviceCount);
+        VALIDATECALL(zeDeviceGetSubDevices(rootDevice, &subDeviceCount, subDevices.data()));
+        devices.insert(devices.end(), subDevices.begin(), subDevices.end());
+    }
+    return devices;
+}
+
+// Split n rows into bands proportional to the given weights. Each band (except the last one)
+// is a multiple of the granularity, so the suggested group sizes divide the band evenly.
+// With minimumShare, every device gets at least one granularity of rows (if n is large
+// enough), so every device is measured even when its weight rounds down to 0 rows.
+std::vector<uint32_t> partitionRows(uint32_t n, const std::vector<double> &weights, uint32_t granularity, bool minimumShare = false) {
+    double totalWeight = 0;
+    for (auto w : weights) {
+        totalWeight += w;
+    }
+    uint32_t minRows = (minimumShare && n >= granularity * weights.size()) ? granularity : 0;
+    uint32_t sharedRows = n - minRows * static_cast<uint32_t>(weights.size());
+    std::vector<uint32_t> rows(weights.size(), 0);
+    uint32_t assigned = 0;
+    for (size_t i = 0; i + 1 < weights.size(); i++) {
+        uint32_t band = minRows + static_cast<uint32_t>((sharedRows * weights[i] / totalWeight) / granularity) * granularity;
+        band = std::min(band, n - assigned - minRows * static_cast<uint32_t>(weights.size() - 1 - i));
+        rows[i] = band;
+        assigned += band;
+    }
+    rows.back() = n - assigned;
+    return rows;
+}
+
+// Per-device state for the row-partitioned matrix multiplication
+struct DevicePartition {
+    ze_device_handle_t device;
+    ze_device_properties_t properties;
+    DeviceTimer timer;
+    uint32_t numEUs;
+    ze_command_queue_handle_t cmdQueue;
+    ze_command_list_handle_t cmdList;
+    ze_module_handle_t module;
+    ze_kernel_handle_t kernel;
+    ze_event_pool_handle_t eventPool;
+    ze_event_handle_t kernelTsEvent;
+    void *timestampBuffer;
+    uint32_t rowStart;
+    uint32_t rows;
+    double kernelTimeNs;
+};
+
+// Run one multiplication with the C rows split across the partitions as given in rowsPerDevice.
+// A, B and C live in host memory; each device gets its own copy of B and its band of A and C.
+// Returns the elapsed wall-clock time from the first submission until the last device finishes.
+int64_t runPartitionedMxM(ze_context_handle_t context, std::vector<DevicePartition> &partitions, 
+                          const std::vector<uint32_t> &rowsPerDevice, 
+                          float *hostA, float *hostB, float *hostC, uint32_t n) {
+
+    ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
+    memAllocDesc.ordinal = 0;
+
+    std::vector<void *> deviceBuffers;
+    uint32_t rowStart = 0;
+    for (size_t d = 0; d < partitions.size(); d++) {
+        DevicePartition &partition = partitions[d];
+        partition.rowStart = rowStart;
+        partition.rows = rowsPerDevice[d];
+        partition.kernelTimeNs = 0;
+        rowStart += partition.rows;
+        if (partition.rows == 0) {
+            continue;
+        }
+
+        size_t bandSize = static_cast<size_t>(partition.rows) * n * sizeof(float);
+        size_t fullSize = static_cast<size_t>(n) * n * sizeof(float);
+        void *bufferA = nullptr;
+        void *bufferB = nullptr;
+        void *bufferC = nullptr;
+        VALIDATECALL(zeMemAllocDevice(context, &memAllocDesc, bandSize, 64, partition.device, &bufferA));
+        VALIDATECALL(zeMemAllocDevice(context, &memAllocDesc, fullSize, 64, partition.device, &bufferB));
+        VALIDATECALL(zeMemAllocDevice(context, &memAllocDesc, bandSize, 64, partition.device, &bufferC));
+        deviceBuffers.push_back(bufferA);
+        deviceBuffers.push_back(bufferB);
+        deviceBuffers.push_back(bufferC);
+
+        uint32_t groupSizeX = 32u;
+        uint32_t groupSizeY = 32u;
+        uint32_t groupSizeZ = 1u;
+        VALIDATECALL(zeKernelSuggestGroupSize(partition.kernel, partition.rows, n, 1U, &groupSizeX, &groupSizeY, &groupSizeZ));
+        VALIDATECALL(zeKernelSetGroupSize(partition.kernel, groupSizeX, groupSizeY, groupSizeZ));
+
+        VALIDATECALL(zeKernelSetArgumentValue(partition.kernel, 0, sizeof(bufferA), &bufferA));
+        VALIDATECALL(zeKernelSetArgumentValue(partition.kernel, 1, sizeof(bufferB), &bufferB));
+        VALIDATECALL(zeKernelSetArgumentValue(partition.kernel, 2, sizeof(bufferC), &bufferC));
+        VALIDATECALL(zeKernelSetArgumentValue(partition.kernel, 3, sizeof(int), &n));
+
+        ze_group_count_t dispatch;
+        dispatch.groupCountX = partition.rows / groupSizeX;
+        dispatch.groupCountY = n / groupSizeY;
+        dispatch.groupCountZ = 1;
+
+        ze_command_list_handle_t cmdList = partition.cmdList;
+        VALIDATECALL(zeCommandListReset(cmdList));
+        VALIDATECALL(zeEventHostReset(partition.kernelTsEvent));
+        VALIDATECALL(zeCommandListAppendMemoryCopy(cmdList, bufferA, hostA + static_cast<size_t>(partition.rowStart) * n, bandSize, nullptr, 0, nullptr));
+        VALIDATECALL(zeCommandListAppendMemoryCopy(cmdList, bufferB, hostB, fullSize, nullptr, 0, nullptr));
+        VALIDATECALL(zeCommandListAppendBarrier(cmdList, nullptr, 0u, nullptr));
+        VALIDATECALL(zeCommandListAppendLaunchKernel(cmdList, partition.kernel, &dispatch, partition.kernelTsEvent, 0, nullptr));
+        VALIDATECALL(zeCommandListAppendBarrier(cmdList, nullptr, 0u, nullptr));
+        VALIDATECALL(zeCommandListAppendMemoryCopy(cmdList, hostC + static_cast<size_t>(partition.rowStart) * n, bufferC, bandSize, nullptr, 0, nullptr));
+        VALIDATECALL(zeCommandListAppendQueryKernelTimestamps(cmdList, 1u, &partition.kernelTsEvent, partition.timestampBuffer, nullptr, nullptr, 0u, nullptr));
+        VALIDATECALL(zeCommandListClose(cmdList));
+    }
+
+    // Submit to all devices first, then wait for all of them
+    auto begin = std::chrono::steady_clock::now();
+    for (auto &partition : partitions) {
+        if (partition.rows > 0) {
+            VALIDATECALL(zeCommandQueueExecuteCommandLists(partition.cmdQueue, 1, &partition.cmdList, nullptr));
+        }
+    }
+    for (auto &partition : partitions) {
+        if (partition.rows > 0) {
+            VALIDATECALL(zeCommandQueueSynchronize(partition.cmdQueue, std::numeric_limits<uint64_t>::max()));
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    for (auto &partition : partitions) {
+        if (partition.rows > 0) {
+            ze_kernel_timestamp_result_t *kernelTsResults = reinterpret_cast<ze_kernel_timestamp_result_t *>(partition.timestampBuffer);
+            partition.kernelTimeNs = kernelTimestampNs(partition.timer, *kernelTsResults);
+        }
+    }
+
+    for (auto buffer : deviceBuffers) {
+        VALIDATECALL(zeMemFree(context, buffer));
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
+}
+
+void printPartitionReport(const std::vector<DevicePartition> &partitions, uint32_t n, int64_t elapsedNs) {
+    double sumDeviceGflops = 0;
+    double slowestKernelNs = 0;
+    for (size_t d = 0; d < partitions.size(); d++) {
+        const DevicePartition &partition = partitions[d];
+        double flops = 2.0 * partition.rows * n * n;
+        double gflops = (partition.kernelTimeNs > 0) ? flops / partition.kernelTimeNs : 0;
+        sumDeviceGflops += gflops;
+        slowestKernelNs = std::max(slowestKernelNs, partition.kernelTimeNs);
+        std::cout << "DEVICE-" << d << " [" << partition.properties.name << "]"
+                  << " ROWS = " << partition.rows
+                  << " KERNEL = " << static_cast<uint64_t>(partition.kernelTimeNs) << " [ns]"
+                  << " GFLOPS = " << gflops << std::endl;
+    }
+    double totalFlops = 2.0 * n * n * static_cast<double>(n);
+    double aggregateKernelGflops = totalFlops / slowestKernelNs;
+    double aggregateGflops = totalFlops / elapsedNs;
+    std::cout << "AGGREGATE-KERNEL-GFLOPS = " << aggregateKernelGflops << std::endl;
+    std::cout << "AGGREGATE-GFLOPS = " << aggregateGflops << " (including transfers)" << std::endl;
+    std::cout << "SCALING-EFFICIENCY = " << (aggregateKernelGflops / sumDeviceGflops) * 100 << " %" << std::endl;
+}
+
+// Row-partitioned matrix multiplication across all devices and sub-devices of the first driver.
+// The rows of C are split in bands weighted by the number of EUs of each device. With 
+// measuredWeights, a first run is used to measure the throughput of each device and the 
+// bands are rebalanced using the measured GFLOP/s.
+int runMultiDevice(uint32_t n, bool measuredWeights) {
+
+    VALIDATECALL(initLevelZero());
+
+    uint32_t driverCount = 0;
+    VALIDATECALL(zeDriverGet(&driverCount, nullptr));
+
+    ze_driver_handle_t driverHandle;
+    driverCount = 1;
+    VALIDATECALL(zeDriverGet(&driverCount, &driverHandle));
+
+    ze_context_desc_t contextDescription = {};
+    contextDescription.stype = ZE_STRUCTURE_TYPE_CONTEXT_DESC;
+    ze_context_handle_t context;
+    VALIDATECALL(zeContextCreate(driverHandle, &contextDescription, &context));
+
+    std::vector<ze_device_handle_t> devices = getAllComputeDevices(driverHandle);
+    std::cout << "#Devices (including sub-devices): " << devices.size() << std::endl;
+
+    std::vector<char> spirv = readSPIRVFile("matrixMultiply.spv");
+
+    ze_host_mem_alloc_desc_t hostDesc = {ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC};
+    std::vector<DevicePartition> partitions(devices.size());
+    std::vector<double> weights(devices.size());
+    for (size_t d = 0; d < devices.size(); d++) {
+        DevicePartition &partition = partitions[d];
+        partition.device = devices[d];
+        partition.properties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES_1_2};
+        VALIDATECALL(zeDeviceGetProperties(partition.device, &partition.properties));
+        partition.timer = deviceTimer(driverHandle, partition.device);
+        partition.numEUs = partition.properties.numSlices * partition.properties.numSubslicesPerSlice * partition.properties.numEUsPerSubslice;
+        weights[d] = std::max(partition.numEUs, 1u);
+        std::cout << "Device " << d << " : " << partition.properties.name << " -- #EUs: " << partition.numEUs << std::endl;
+
+        ze_command_queue_desc_t cmdQueueDesc = {ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC};
+        cmdQueueDesc.ordinal = findComputeOrdinal(partition.device);
+        cmdQueueDesc.index = 0;
+        cmdQueueDesc.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
+        VALIDATECALL(zeCommandQueueCreate(context, partition.device, &cmdQueueDesc, &partition.cmdQueue));
+
+        ze_command_list_desc_t cmdListDesc = {ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC};
+        cmdListDesc.commandQueueGroupOrdinal = cmdQueueDesc.ordinal;
+        VALIDATECALL(zeCommandListCreate(context, partition.device, &cmdListDesc, &partition.cmdList));
+
+        partition.module = buildModule(context, partition.device, spirv, "");
+        ze_kernel_desc_t kernelDesc = {ZE_STRUCTURE_TYPE_KERNEL_DESC};
+        kernelDesc.pKernelName = "mxm";
+        VALIDATECALL(zeKernelCreate(partition.module, &kernelDesc, &partition.kernel));
+
+        createEventPoolAndEvents(context, partition.device, partition.eventPool, ZE_EVENT_POOL_FLAG_KERNEL_TIMESTAMP, 1, &partition.kernelTsEvent);
+
+        VALIDATECALL(zeMemAllocHost(context, &hostDesc, sizeof(ze_kernel_timestamp_result_t), 1, &partition.timestampBuffer));
+        memset(partition.timestampBuffer, 0, sizeof(ze_kernel_timestamp_result_t));
+    }
+
+    size_t allocSize = static_cast<size_t>(n) * n * sizeof(float);
+    void *hostA = nullptr;
+    void *hostB = nullptr;
+    void *hostC = nullptr;
+    VALIDATECALL(zeMemAllocHost(context, &hostDesc, allocSize, 64, &hostA));
+    VALIDATECALL(zeMemAllocHost(context, &hostDesc, allocSize, 64, &hostB));
+    VALIDATECALL(zeMemAllocHost(context, &hostDesc, allocSize, 64, &hostC));
+    float *floatA = static_cast<float *>(hostA);
+    float *floatB = static_cast<float *>(hostB);
+    float *floatC = static_cast<float *>(hostC);
+    for (size_t i = 0; i < static_cast<size_t>(n) * n; i++) {
+        floatA[i] = 2.5f;
+        floatB[i] = 3.2f;
+        floatC[i] = 0.0f;
+    }
+
+    const uint32_t granularity = 32;
+    std::vector<uint32_t> rowsPerDevice = partitionRows(n, weights, granularity, measuredWeights);
+    int64_t elapsedNs = runPartitionedMxM(context, partitions, rowsPerDevice, floatA, floatB, floatC, n);
+
+    if (measuredWeights) {
+        std::cout << "Weights by #EUs: " << std::endl;
+        printPartitionReport(partitions, n, elapsedNs);
+        // Rows/ns of each device. A device without a measurement (n too small to give every
+        // device a band) keeps its EU-based share, at the mean throughput per EU of the others.
+        double measuredThroughput = 0;
+        double measuredEUs = 0;
+        for (size_t d = 0; d < partitions.size(); d++) {
+            if (partitions[d].rows > 0 && partitions[d].kernelTimeNs > 0) {
+                weights[d] = partitions[d].rows / partitions[d].kernelTimeNs;
+                measuredThroughput += weights[d];
+                measuredEUs += std::max(partitions[d].numEUs, 1u);
+            } else {
+                weights[d] = -1;
+            }
+        }
+        for (size_t d = 0; d < partitions.size(); d++) {
+            if (weights[d] < 0) {
+                weights[d] = std::max(partitions[d].numEUs, 1u) * (measuredEUs > 0 ? measuredThroughput / measuredEUs : 1.0);
+            }
+        }
+        rowsPerDevice = partitionRows(n, weights, granularity);
+        elapsedNs = runPartitionedMxM(context, partitions, rowsPerDevice, floatA, floatB, floatC, n);
+        std::cout << "Weights by measured throughput: " << std::endl;
+    }
+    printPartitionReport(partitions, n, elapsedNs);
+
+    if (VALIDATION) {
+        bool outputValidationSuccessful = true;
+        float *resultSeq = (float *)malloc(allocSize);
+        double tolerance = std::max(0.1, referenceMultiply(floatA, floatB, resultSeq, n));
+        for (size_t i = 0; i < static_cast<size_t>(n) * n; i++) {
+            if (std::abs(resultSeq[i] - floatC[i]) > tolerance) {
+                outputValidationSuccessful = false;
+                break;
+            }
+        }
+        free(resultSeq);
+        std::cout << "\nMatrix Multiply validation " << (outputValidationSuccessful ? "PASSED" : "FAILED") << "\n";
+    }
+
+    // Cleanup
+    VALIDATECALL(zeMemFree(context, hostA));
+    VALIDATECALL(zeMemFree(context, hostB));
+    VALIDATECALL(zeMemFree(context, hostC));
+    for (auto &partition : partitions) {
+        VALIDATECALL(zeMemFree(context, partition.timestampBuffer));
+        VALIDATECALL(zeEventDestroy(partition.kernelTsEvent));
+        VALIDATECALL(zeEventPoolDestroy(partition.eventPool));
+        VALIDATECALL(zeKernelDestroy(partition.kernel));
+        VALIDATECALL(zeModuleDestroy(partition.module));
+        VALIDATECALL(zeCommandListDestroy(partition.cmdList));
+        VALIDATECALL(zeCommandQueueDestroy(partition.cmdQueue));
+    }
+    VALIDATECALL(zeContextDestroy(context));
+    return 0;
+}
+
+void initIterationInput(float *a, uint32_t n, int iteration) {
+    for (size_t i = 0; i < static_cast<size_t>(n) * n; i++) {
+        a[i] = static_cast<float>((i + iteration) % 4);
+    }
+}
+
+bool matchesReference(const float *c, const float *resultSeq, double tolerance, uint32_t n) {
+    for (size_t i = 0; i < static_cast<size_t>(n) * n; i++) {
+        if (std::abs(resultSeq[i] - c[i]) > tolerance) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool validateIteration(float *a, float *b, float *c, float *resultSeq, uint32_t n) {
+    PHASE_TIMER("validation");
+    double tolerance = std::max(0.01, referenceMultiply(a, b, resultSeq, n));
+    return matchesReference(c, resultSeq, tolerance, n);
+}
+
+// Run a number of iterations, each one with a different input matrix A. The host prepares the 
+// input and computes the sequential reference to validate each iteration. 
+// In serial mode, the host waits for each iteration before validating it. In async mode, 
+// iteration i is submitted and the host validates iteration i-1 while the device executes it.
+// Two command lists (one per slot) with their own A and C buffers are used for double buffering.
+int64_t runIterations(ZeAsyncQueue &asyncQueue, ze_command_list_handle_t *cmdLists, 
+                      float **bufferA, float *bufferB, float **bufferC, 
+                      uint32_t n, int iterations, bool overlap, bool &outputValidationSuccessful) {
+
+    float *resultSeq = (float *)malloc(static_cast<size_t>(n) * n * sizeof(float));
+    outputValidationSuccessful = true;
+    ZeFuture futures[2];
+
+    auto begin = std::chrono::steady_clock::now();
+    if (!overlap) {
+        for (int i = 0; i < iterations; i++) {
+            int slot = i % 2;
+            initIterationInput(bufferA[slot], n, i);
+            asyncQueue.submit(cmdLists[slot]).wait();
+            outputValidationSuccessful &= validateIteration(bufferA[slot], bufferB, bufferC[slot], resultSeq, n);
+        }
+    } else {
+        for (int i = 0; i <= iterations; i++) {
+            if (i < iterations) {
+                // The slot was last used by iteration i-2, which has been already validated
+                int slot = i % 2;
+                initIterationInput(bufferA[slot], n, i);
+                futures[slot] = asyncQueue.submit(cmdLists[slot]);
+            }
+            if (i > 0) {
+                // Validate the previous iteration while the current one runs on the device
+                int previous = (i - 1) % 2;
+                futures[previous].wait();
+                outputValidationSuccessful &= validateIteration(bufferA[previous], bufferB, bufferC[previous], resultSeq, n);
+            }
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    free(resultSeq);
+    return std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
+}
+
+// Compare blocking submission against asynchronous submission (futures backed by fences)
+// that overlaps the host validation with the execution of the next iteration.
+int runAsync(uint32_t n, int iterations) {
+
+    VALIDATECALL(initLevelZero());
+
+    uint32_t driverCount = 1;
+    ze_driver_handle_t driverHandle;
+    VALIDATECALL(zeDriverGet(&driverCount, &driverHandle));
+
+    ze_context_desc_t contextDescription = {};
+    contextDescription.stype = ZE_STRUCTURE_TYPE_CONTEXT_DESC;
+    ze_context_handle_t context;
+    VALIDATECALL(zeContextCreate(driverHandle, &contextDescription, &context));
+
+    uint32_t deviceCount = 1;
+    ze_device_handle_t device;
+    VALIDATECALL(zeDeviceGet(driverHandle, &deviceCount, &device));
+
+    ze_command_queue_desc_t cmdQueueDesc = {ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC};
+    cmdQueueDesc.ordinal = findComputeOrdinal(device);
+    cmdQueueDesc.index = 0;
+    cmdQueueDesc.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
+    ze_command_queue_handle_t cmdQueue;
+    VALIDATECALL(zeCommandQueueCreate(context, device, &cmdQueueDesc, &cmdQueue));
+
+    std::vector<char> spirv = readSPIRVFile("matrixMultiply.spv");
+    ze_module_handle_t module = buildModule(context, device, spirv, "");
+    ze_kernel_desc_t kernelDesc = {ZE_STRUCTURE_TYPE_KERNEL_DESC};
+    kernelDesc.pKernelName = "mxm";
+    ze_kernel_handle_t kernel;
+    VALIDATECALL(zeKernelCreate(module, &kernelDesc, &kernel));
+
+    size_t allocSize = static_cast<size_t>(n) * n * sizeof(float);
+    ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
+    ze_host_mem_alloc_desc_t hostDesc = {ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC};
+    void *sharedA[2] = {nullptr, nullptr};
+    void *sharedC[2] = {nullptr, nullptr};
+    void *sharedB = nullptr;
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 64, device, &sharedB));
+    float *floatB = static_cast<float *>(sharedB);
+    for (size_t i = 0; i < static_cast<size_t>(n) * n; i++) {
+        floatB[i] = static_cast<float>(i % 3);
+    }
+
+    uint32_t groupSizeX = 32u;
+    uint32_t groupSizeY = 32u;
+    uint32_t groupSizeZ = 1u;
+    VALIDATECALL(zeKernelSuggestGroupSize(kernel, n, n, 1U, &groupSizeX, &groupSizeY, &groupSizeZ));
+    VALIDATECALL(zeKernelSetGroupSize(kernel, groupSizeX, groupSizeY, groupSizeZ));
+    ze_group_count_t dispatch;
+    dispatch.groupCountX = n / groupSizeX;
+    dispatch.groupCountY = n / groupSizeY;
+    dispatch.groupCountZ = 1;
+
+    // One command list per slot. Arguments are captured when the kernel is appended,
+    // so the lists are recorded once and re-submitted every iteration.
+    ze_command_list_handle_t cmdLists[2];
+    ze_command_list_desc_t cmdListDesc = {ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC};
+    cmdListDesc.commandQueueGroupOrdinal = cmdQueueDesc.ordinal;
+    for (int slot = 0; slot < 2; slot++) {
+        VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 64, device, &sharedA[slot]));
+        VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 64, device, &sharedC[slot]));
+        VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &cmdLists[slot]));
+        VALIDATECALL(zeKernelSetArgumentValue(kernel, 0, sizeof(void *), &sharedA[slot]));
+        VALIDATECALL(zeKernelSetArgumentValue(kernel, 1, sizeof(void *), &sharedB));
+        VALIDATECALL(zeKernelSetArgumentValue(kernel, 2, sizeof(void *), &sharedC[slot]));
+        VALIDATECALL(zeKernelSetArgumentValue(kernel, 3, sizeof(int), &n));
+        VALIDATECALL(zeCommandListAppendLaunchKernel(cmdLists[slot], kernel, &dispatch, nullptr, 0, nullptr));
+        VALIDATECALL(zeCommandListClose(cmdLists[slot]));
+    }
+
+    float *bufferA[2] = {static_cast<float *>(sharedA[0]), static_cast<float *>(sharedA[1])};
+    float *bufferC[2] = {static_cast<float *>(sharedC[0]), static_cast<float *>(sharedC[1])};
+
+    bool serialValidation = false;
+    bool asyncValidation = false;
+    int64_t serialTime;
+    int64_t asyncTime;
+    {
+        ZeAsyncQueue asyncQueue(cmdQueue, 2);
+        serialTime = runIterations(asyncQueue, cmdLists, bufferA, floatB, bufferC, n, iterations, false, serialValidation);
+        asyncTime = runIterations(asyncQueue, cmdLists, bufferA, floatB, bufferC, n, iterations, true, asyncValidation);
+    }
+
+    std::cout << "#Iterations = " << iterations << std::endl;
+    std::cout << "SERIAL-TOTAL = " << serialTime << " [ns]" << std::endl;
+    std::cout << "ASYNC-TOTAL = " << asyncTime << " [ns]" << std::endl;
+    std::cout << "Overlap Speedup = " << (static_cast<double>(serialTime) / asyncTime) << "x" << std::endl;
+    std::cout << "\nMatrix Multiply validation " << ((serialValidation && asyncValidation) ? "PASSED" : "FAILED") << "\n";
+
+    // Cleanup
+    for (int slot = 0; slot < 2; slot++) {
+        VALIDATECALL(zeMemFree(context, sharedA[slot]));
+        VALIDATECALL(zeMemFree(context, sharedC[slot]));
+        VALIDATECALL(zeCommandListDestroy(cmdLists[slot]));
+    }
+    VALIDATECALL(zeMemFree(context, sharedB));
+    VALIDATECALL(zeKernelDestroy(kernel));
+    VALIDATECALL(zeModuleDestroy(module));
+    VALIDATECALL(zeCommandQueueDestroy(cmdQueue));
+    VALIDATECALL(zeContextDestroy(context));
+    return 0;
+}
+
+// Measure the latency from submission to host observation of a single dispatch, for
+// each completion-wait strategy. Intended for small sizes, where the wait path is a
+// significant part of the observed time.
+int runWaitStrategies(uint32_t n, const std::string &strategyName, int iterations) {
+
+    std::vector<WaitStrategy> strategies;
+    if (strategyName == "all") {
+        strategies = allWaitStrategies();
+    } else {
+        WaitStrategy strategy;
+        if (!parseWaitStrategy(strategyName, strategy)) {
+            std::cout << "Unknown wait strategy: " << strategyName << " (queue|fence|spin|hybrid|sync|all)\n";
+            return -1;
+        }
+        strategies.push_back(strategy);
+    }
+
+    VALIDATECALL(initLevelZero());
+
+    uint32_t driverCount = 1;
+    ze_driver_handle_t driverHandle;
+    VALIDATECALL(zeDriverGet(&driverCount, &driverHandle));
+
+    ze_context_desc_t contextDescription = {};
+    contextDescription.stype = ZE_STRUCTURE_TYPE_CONTEXT_DESC;
+    ze_context_handle_t context;
+    VALIDATECALL(zeContextCreate(driverHandle, &contextDescription, &context));
+
+    uint32_t deviceCount = 1;
+    ze_device_handle_t device;
+    VALIDATECALL(zeDeviceGet(driverHandle, &deviceCount, &device));
+
+    std::vector<char> spirv = readSPIRVFile("matrixMultiply.spv");
+    ze_module_handle_t module = buildModule(context, device, spirv, "");
+    ze_kernel_desc_t kernelDesc = {ZE_STRUCTURE_TYPE_KERNEL_DESC};
+    kernelDesc.pKernelName = "mxm";
+    ze_kernel_handle_t kernel;
+    VALIDATECALL(zeKernelCreate(module, &kernelDesc, &kernel));
+
+    size_t allocSize = static_cast<size_t>(n) * n * sizeof(float);
+    ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
+    ze_host_mem_alloc_desc_t hostDesc = {ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC};
+    void *sharedA = nullptr;
+    void *sharedB = nullptr;
+    void *sharedC = nullptr;
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 64, device, &sharedA));
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 64, device, &sharedB));
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 64, device, &sharedC));
+    parallelMemset(sharedA, 0, allocSize, firstTouchNode(device));
+    parallelMemset(sharedB, 0, allocSize, firstTouchNode(device));
+
+    uint32_t groupSizeX = 32u;
+    uint32_t groupSizeY = 32u;
+    uint32_t groupSizeZ = 1u;
+    VALIDATECALL(zeKernelSuggestGroupSize(kernel, n, n, 1U, &groupSizeX, &groupSizeY, &groupSizeZ));
+    VALIDATECALL(zeKernelSetGroupSize(kernel, groupSizeX, groupSizeY, groupSizeZ));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 0, sizeof(sharedA), &sharedA));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 1, sizeof(sharedB), &sharedB));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 2, sizeof(sharedC), &sharedC));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 3, sizeof(int), &n));
+    ze_group_count_t dispatch;
+    dispatch.groupCountX = n / groupSizeX;
+    dispatch.groupCountY = n / groupSizeY;
+    dispatch.groupCountZ = 1;
+
+    uint32_t ordinal = findComputeOrdinal(device);
+    const int warmup = 10;
+    for (auto strategy : strategies) {
+        ze_command_queue_desc_t cmdQueueDesc = {ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC};
+        cmdQueueDesc.ordinal = ordinal;
+        cmdQueueDesc.index = 0;
+        cmdQueueDesc.mode = queueModeFor(strategy);
+        ze_command_queue_handle_t cmdQueue;
+        VALIDATECALL(zeCommandQueueCreate(context, device, &cmdQueueDesc, &cmdQueue));
+
+        ze_command_list_handle_t cmdList;
+        ze_command_list_desc_t cmdListDesc = {ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC};
+        cmdListDesc.commandQueueGroupOrdinal = ordinal;
+        VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &cmdList));
+
+        std::vector<double> latencies;
+        {
+            ZeCompletionWaiter waiter(strategy, context, device, cmdQueue);
+            VALIDATECALL(zeCommandListAppendLaunchKernel(cmdList, kernel, &dispatch, waiter.completionEvent(), 0, nullptr));
+            VALIDATECALL(zeCommandListClose(cmdList));
+
+            for (int i = 0; i < warmup + iterations; i++) {
+                auto begin = std::chrono::steady_clock::now();
+                waiter.submitAndWait(cmdList);
+                auto end = std::chrono::steady_clock::now();
+                if (i >= warmup) {
+                    latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count());
+                }
+            }
+        }
+        printStats(std::string("WAIT-") + waitStrategyName(strategy), computeStats(latencies));
+
+        VALIDATECALL(zeCommandListDestroy(cmdList));
+        VALIDATECALL(zeCommandQueueDestroy(cmdQueue));
+    }
+
+    // Cleanup
+    VALIDATECALL(zeMemFree(context, sharedA));
+    VALIDATECALL(zeMemFree(context, sharedB));
+    VALIDATECALL(zeMemFree(context, sharedC));
+    VALIDATECALL(zeKernelDestroy(kernel));
+    VALIDATECALL(zeModuleDestroy(module));
+    VALIDATECALL(zeContextDestroy(context));
+    return 0;
+}
+
+// Launch the (already recorded and closed) command list repetitions + 1 times and return the
+// kernel time of each launch, measured with the kernel timestamp event. The first launch is
+// discarded (warm-up).
+std::vector<double> timeKernelLaunches(ze_command_queue_handle_t cmdQueue, ze_command_list_handle_t cmdList, 
+                                       ze_event_handle_t kernelTsEvent, const DeviceTimer &timer, int repetitions) {
+    std::vector<double> kernelTimes;
+    for (int r = 0; r <= repetitions; r++) {
+        VALIDATECALL(zeEventHostReset(kernelTsEvent));
+        VALIDATECALL(zeCommandQueueExecuteCommandLists(cmdQueue, 1, &cmdList, nullptr));
+        VALIDATECALL(zeCommandQueueSynchronize(cmdQueue, std::numeric_limits<uint64_t>::max()));
+        ze_kernel_timestamp_result_t kernelTs;
+        VALIDATECALL(zeEventQueryKernelTimestamp(kernelTsEvent, &kernelTs));
+        if (r > 0) {
+            kernelTimes.push_back(kernelTimestampNs(timer, kernelTs));
+        }
+    }
+    return kernelTimes;
+}
+
+// Build options evaluated by the build-time benchmark: optimizations on (default) or off
+// (-ze-opt-disable) x -cl-fast-relaxed-math x -cl-mad-enable. The Level Zero build flags have
+// no intermediate optimization levels. The empty string is the default used by the rest of
+// the examples.
+std::vector<std::string> buildFlagCombinations() {
+    const std::vector<std::string> optLevels = {"", "-ze-opt-disable"};
+    const std::vector<std::string> relaxedMath = {"", "-cl-fast-relaxed-math"};
+    const std::vector<std::string> madEnable = {"", "-cl-mad-enable"};
+    std::vector<std::string> combinations;
+    for (auto &opt : optLevels) {
+        for (auto &relaxed : relaxedMath) {
+            for (auto &mad : madEnable) {
+                std::string flags = opt;
+                for (auto &flag : {relaxed, mad}) {
+                    if (!flag.empty()) {
+                        flags += (flags.empty() ? "" : " ") + flag;
+                    }
+                }
+                combinations.push_back(flags);
+            }
+        }
+    }
+    return combinations;
+}
+
+// Time zeModuleCreate for each SPIR-V file under each combination of build flags. For the
+// mxm kernel (matrixMultiply.spv), it also reports the kernel time obtained with each set of
+// flags, so the JIT cost can be compared with the kernel speed-up. Extra SPIR-V files are
+// only built (their kernel signatures are unknown).
+// The persistent compiler cache of the driver is disabled before zeInit, otherwise every build
+// after the first one measures a cache lookup. Set NEO_CACHE_PERSISTENT=1 to keep it: the first
+// build (BUILD-FIRST) is then the cold one and the rest are warm.
+int runBuildBenchmark(uint32_t n, int repetitions, const std::vector<std::string> &extraFiles) {
+
+    setenv("NEO_CACHE_PERSISTENT", "0", 0);
+    VALIDATECALL(initLevelZero());
+
+    uint32_t driverCount = 1;
+    ze_driver_handle_t driverHandle;
+    VALIDATECALL(zeDriverGet(&driverCount, &driverHandle));
+
+    ze_context_desc_t contextDescription = {};
+    contextDescription.stype = ZE_STRUCTURE_TYPE_CONTEXT_DESC;
+    ze_context_handle_t context;
+    VALIDATECALL(zeContextCreate(driverHandle, &contextDescription, &context));
+
+    uint32_t deviceCount = 1;
+    ze_device_handle_t device;
+    VALIDATECALL(zeDeviceGet(driverHandle, &deviceCount, &device));
+
+    ze_device_properties_t deviceProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES_1_2};
+    VALIDATECALL(zeDeviceGetProperties(device, &deviceProperties));
+    DeviceTimer timer = deviceTimer(driverHandle, device);
+    std::cout << "Device   : " << deviceProperties.name << std::endl;
+    std::cout << "Compiler cache: NEO_CACHE_PERSISTENT=" << getenv("NEO_CACHE_PERSISTENT") << std::endl;
+
+    uint32_t ordinal = findComputeOrdinal(device);
+    ze_command_queue_desc_t cmdQueueDesc = {ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC};
+    cmdQueueDesc.ordinal = ordinal;
+    cmdQueueDesc.index = 0;
+    cmdQueueDesc.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
+    ze_command_queue_handle_t cmdQueue;
+    VALIDATECALL(zeCommandQueueCreate(context, device, &cmdQueueDesc, &cmdQueue));
+
+    ze_command_list_handle_t cmdList;
+    ze_command_list_desc_t cmdListDesc = {ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC};
+    cmdListDesc.commandQueueGroupOrdinal = ordinal;
+    VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &cmdList));
+
+    size_t allocSize = static_cast<size_t>(n) * n * sizeof(float);
+    ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
+    ze_host_mem_alloc_desc_t hostDesc = {ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC};
+    void *sharedA = nullptr;
+    void *sharedB = nullptr;
+    void *sharedC = nullptr;
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 64, device, &sharedA));
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 64, device, &sharedB));
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 64, device, &sharedC));
+    initIterationInput(static_cast<float *>(sharedA), n, 0);
+    initIterationInput(static_cast<float *>(sharedB), n, 1);
+
+    ze_event_pool_handle_t eventPool;
+    ze_event_handle_t kernelTsEvent;
+    createEventPoolAndEvents(context, device, eventPool, ZE_EVENT_POOL_FLAG_KERNEL_TIMESTAMP, 1, &kernelTsEvent);
+
+    std::vector<std::string> files = {"matrixMultiply.spv"};
+    files.insert(files.end(), extraFiles.begin(), extraFiles.end());
+    std::vector<std::string> flagCombinations = buildFlagCombinations();
+
+    for (auto &fileName : files) {
+        std::vector<char> spirv = readSPIRVFile(fileName.c_str());
+        bool runKernel = (fileName == "matrixMultiply.spv");
+        double baselineBuildNs = 0;
+        double baselineKernelNs = 0;
+
+        for (auto &flags : flagCombinations) {
+            std::string label = fileName + " (" + std::to_string(spirv.size()) + " bytes) flags=\"" + flags + "\"";
+
+            // Build time. Every repetition creates a new module from the SPIR-V.
+            std::vector<double> buildTimes;
+            ze_module_handle_t module = nullptr;
+            for (int r = 0; r < repetitions; r++) {
+                if (module != nullptr) {
+                    VALIDATECALL(zeModuleDestroy(module));
+                }
+                auto begin = std::chrono::steady_clock::now();
+                module = buildModule(context, device, spirv, flags.c_str());
+                auto end = std::chrono::steady_clock::now();
+                buildTimes.push_back(std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count());
+            }
+            BenchStats buildStats = computeStats(buildTimes);
+            std::cout << "BUILD-FIRST " << label << " = " << buildTimes.front() << " [ns]" << std::endl;
+            printStats("BUILD " + label, buildStats);
+
+            if (runKernel) {
+                ze_kernel_desc_t kernelDesc = {ZE_STRUCTURE_TYPE_KERNEL_DESC};
+                kernelDesc.pKernelName = "mxm";
+                ze_kernel_handle_t kernel;
+                VALIDATECALL(zeKernelCreate(module, &kernelDesc, &kernel));
+
+                uint32_t groupSizeX = 32u;
+                uint32_t groupSizeY = 32u;
+                uint32_t groupSizeZ = 1u;
+                VALIDATECALL(zeKernelSuggestGroupSize(kernel, n, n, 1U, &groupSizeX, &groupSizeY, &groupSizeZ));
+                VALIDATECALL(zeKernelSetGroupSize(kernel, groupSizeX, groupSizeY, groupSizeZ));
+                VALIDATECALL(zeKernelSetArgumentValue(kernel, 0, sizeof(sharedA), &sharedA));
+                VALIDATECALL(zeKernelSetArgumentValue(kernel, 1, sizeof(sharedB), &sharedB));
+                VALIDATECALL(zeKernelSetArgumentValue(kernel, 2, sizeof(sharedC), &sharedC));
+                VALIDATECALL(zeKernelSetArgumentValue(kernel, 3, sizeof(int), &n));
+                ze_group_count_t dispatch;
+                dispatch.groupCountX = n / groupSizeX;
+                dispatch.groupCountY = n / groupSizeY;
+                dispatch.groupCountZ = 1;
+
+                VALIDATECALL(zeCommandListReset(cmdList));
+                VALIDATECALL(zeCommandListAppendLaunchKernel(cmdList, kernel, &dispatch, kernelTsEvent, 0, nullptr));
+                VALIDATECALL(zeCommandListClose(cmdList));
+
+                BenchStats kernelStats = computeStats(timeKernelLaunches(cmdQueue, cmdList, kernelTsEvent, timer, repetitions));
+                printStats("KERNEL " + label, kernelStats);
+
+                // Number of launches needed to pay back the extra build time with respect to
+                // the default flags
+                if (flags.empty()) {
+                    baselineBuildNs = buildStats.median;
+                    baselineKernelNs = kernelStats.median;
+                } else {
+                    double extraBuild = buildStats.median - baselineBuildNs;
+                    double savedPerLaunch = baselineKernelNs - kernelStats.median;
+                    std::cout << "TRADEOFF flags=\"" << flags << "\": build " << (extraBuild >= 0 ? "+" : "") << extraBuild 
+                              << " [ns], kernel " << (savedPerLaunch > 0 ? "-" : "+") << std::abs(savedPerLaunch) << " [ns]";
+                    if (extraBuild > 0 && savedPerLaunch > 0) {
+                        std::cout << ", break-even after " << std::ceil(extraBuild / savedPerLaunch) << " launches";
+                    } else if (extraBuild <= 0 && savedPerLaunch >= 0) {
+                        std::cout << ", better than default";
+                    } else if (extraBuild >= 0 && savedPerLaunch <= 0) {
+                        std::cout << ", worse than default";
+                    } else {
+                        std::cout << ", faster build but slower kernel";
+                    }
+                    std::cout << std::endl;
+                }
+
+                VALIDATECALL(zeKernelDestroy(kernel));
+            }
+            VALIDATECALL(zeModuleDestroy(module));
+        }
+    }
+
+    // Cleanup
+    VALIDATECALL(zeEventDestroy(kernelTsEvent));
+    VALIDATECALL(zeEventPoolDestroy(eventPool));
+    VALIDATECALL(zeMemFree(context, sharedA));
+    VALIDATECALL(zeMemFree(context, sharedB));
+    VALIDATECALL(zeMemFree(context, sharedC));
+    VALIDATECALL(zeCommandListDestroy(cmdList));
+    VALIDATECALL(zeCommandQueueDestroy(cmdQueue));
+    VALIDATECALL(zeContextDestroy(context));
+    return 0;
+}
+
+// Specialization constant IDs used in matrixMultiplySpec.cl
+#define SPEC_ID_N       0
+#define SPEC_ID_TILE_K  1
+
+// Modules of matrixMultiplySpec.spv built for a given (N, TILE_K). Each set of constants
+// is compiled once; later requests for the same shape reuse the module.
+class SpecializedModuleCache {
+public:
+    SpecializedModuleCache(ze_context_handle_t context, ze_device_handle_t device, const std::vector<char> &spirv) 
+        : context(context), device(device), spirv(spirv), misses(0), hits(0), buildTimeNs(0) {}
+
+    ~SpecializedModuleCache() {
+        for (auto &entry : modules) {
+            zeModuleDestroy(entry.second);
+        }
+    }
+
+    ze_module_handle_t get(uint32_t n, uint32_t tileK) {
+        auto key = std::make_pair(n, tileK);
+        auto it = modules.find(key);
+        if (it != modules.end()) {
+            hits++;
+            return it->second;
+        }
+
+        uint32_t constantIds[] = {SPEC_ID_N, SPEC_ID_TILE_K};
+        const void *constantValues[] = {&n, &tileK};
+        ze_module_constants_t constants = {};
+        constants.numConstants = 2;
+        constants.pConstantIds = constantIds;
+        constants.pConstantValues = constantValues;
+
+        auto begin = std::chrono::steady_clock::now();
+        ze_module_handle_t module = buildModule(context, device, spirv, "", &constants);
+        auto end = std::chrono::steady_clock::now();
+        buildTimeNs += std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
+        misses++;
+        modules[key] = module;
+        return module;
+    }
+
+    uint64_t getMisses() const { return misses; }
+    uint64_t getHits() const { return hits; }
+    int64_t getBuildTimeNs() const { return buildTimeNs; }
+
+private:
+    ze_context_handle_t context;
+    ze_device_handle_t device;
+    std::vector<char> spirv;
+    std::map<std::pair<uint32_t, uint32_t>, ze_module_handle_t> modules;
+    uint64_t misses;
+    uint64_t hits;
+    int64_t buildTimeNs;
+};
+
+// Record the launch of a mxm kernel (generic or specialized) in the command list
+void recordMxMLaunch(ze_command_list_handle_t cmdList, ze_kernel_handle_t kernel, ze_event_handle_t kernelTsEvent,
+                     void *bufferA, void *bufferB, void *bufferC, uint32_t n, bool passSize) {
+    uint32_t groupSizeX = 32u;
+    uint32_t groupSizeY = 32u;
+    uint32_t groupSizeZ = 1u;
+    VALIDATECALL(zeKernelSuggestGroupSize(kernel, n, n, 1U, &groupSizeX, &groupSizeY, &groupSizeZ));
+    VALIDATECALL(zeKernelSetGroupSize(kernel, groupSizeX, groupSizeY, groupSizeZ));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 0, sizeof(bufferA), &bufferA));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 1, sizeof(bufferB), &bufferB));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 2, sizeof(bufferC), &bufferC));
+    if (passSize) {
+        VALIDATECALL(zeKernelSetArgumentValue(kernel, 3, sizeof(int), &n));
+    }
+    ze_group_count_t dispatch;
+    dispatch.groupCountX = n / groupSizeX;
+    dispatch.groupCountY = n / groupSizeY;
+    dispatch.groupCountZ = 1;
+
+    VALIDATECALL(zeCommandListReset(cmdList));
+    VALIDATECALL(zeCommandListAppendLaunchKernel(cmdList, kernel, &dispatch, kernelTsEvent, 0, nullptr));
+    VALIDATECALL(zeCommandListClose(cmdList));
+}
+
+// mxmTransposedB: one work-group of TRANSPOSED_DOT_LANES work-items (DOT_LANES in
+// matrixMultiplyPackedB.cl) per element of C
+constexpr uint32_t TRANSPOSED_DOT_LANES = 16;
+
+void recordTransposedLaunch(ze_command_list_handle_t cmdList, ze_kernel_handle_t kernel, ze_event_handle_t kernelTsEvent,
+                            void *bufferA, void *bufferBT, void *bufferC, uint32_t n) {
+    VALIDATECALL(zeKernelSetGroupSize(kernel, TRANSPOSED_DOT_LANES, 1, 1));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 0, sizeof(bufferA), &bufferA));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 1, sizeof(bufferBT), &bufferBT));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 2, sizeof(bufferC), &bufferC));
+    VALIDATECALL(zeKernelSetArgumentValue(kernel, 3, sizeof(int), &n));
+    ze_group_count_t dispatch;
+    dispatch.groupCountX = n;
+    dispatch.groupCountY = n;
+    dispatch.groupCountZ = 1;
+
+    VALIDATECALL(zeCommandListReset(cmdList));
+    VALIDATECALL(zeCommandListAppendLaunchKernel(cmdList, kernel, &dispatch, kernelTsEvent, 0, nullptr));
+    VALIDATECALL(zeCommandListClose(cmdList));
+}
+
+// Compare the generic mxm kernel (n passed as an argument) against the kernel specialized
+// with N and TILE_K as specialization constants, for each of the given sizes.
+int runSpecialized(const std::vector<uint32_t> &sizes, uint32_t tileK, int repetitions) {
+
+    VALIDATECALL(initLevelZero());
+
+    uint32_t driverCount = 1;
+    ze_driver_handle_t driverHandle;
+    VALIDATECALL(zeDriverGet(&driverCount, &driverHandle));
+
+    ze_context_desc_t contextDescription = {};
+    contextDescription.stype = ZE_STRUCTURE_TYPE_CONTEXT_DESC;
+    ze_context_handle_t context;
+    VALIDATECALL(zeContextCreate(driverHandle, &contextDescription, &context));
+
+    uint32_t deviceCount = 1;
+    ze_device_handle_t device;
+    VALIDATECALL(zeDeviceGet(driverHandle, &deviceCount, &device));
+
+    ze_device_properties_t deviceProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES_1_2};
+    VALIDATECALL(zeDeviceGetProperties(device, &deviceProperties));
+    DeviceTimer timer = deviceTimer(driverHandle, device);
+    std::cout << "Device   : " << deviceProperties.name << std::endl;
+
+    uint32_t ordinal = findComputeOrdinal(device);
+    ze_command_queue_desc_t cmdQueueDesc = {ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC};
+    cmdQueueDesc.ordinal = ordinal;
+    cmdQueueDesc.index = 0;
+    cmdQueueDesc.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
+    ze_command_queue_handle_t cmdQueue;
+    VALIDATECALL(zeCommandQueueCreate(context, device, &cmdQueueDesc, &cmdQueue));
+
+    ze_command_list_handle_t cmdList;
+    ze_command_list_desc_t cmdListDesc = {ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC};
+    cmdListDesc.commandQueueGroupOrdinal = ordinal;
+    VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &cmdList));
+
+    ze_event_pool_handle_t eventPool;
+    ze_event_handle_t kernelTsEvent;
+    createEventPoolAndEvents(context, device, eventPool, ZE_EVENT_POOL_FLAG_KERNEL_TIMESTAMP, 1, &kernelTsEvent);
+
+    ze_module_handle_t genericModule = buildModule(context, device, readSPIRVFile("matrixMultiply.spv"), "");
+    ze_kernel_desc_t kernelDesc = {ZE_STRUCTURE_TYPE_KERNEL_DESC};
+    kernelDesc.pKernelName = "mxm";
+    ze_kernel_handle_t genericKernel;
+    VALIDATECALL(zeKernelCreate(genericModule, &kernelDesc, &genericKernel));
+
+    bool outputValidationSuccessful = true;
+    {
+        SpecializedModuleCache cache(context, device, readSPIRVFile("matrixMultiplySpec.spv"));
+
+        for (auto n : sizes) {
+            if (n % tileK != 0) {
+                std::cout << "Size " << n << " is not a multiple of TILE_K=" << tileK << ". Skipped\n";
+                continue;
+            }
+            size_t allocSize = static_cast<size_t>(n) * n * sizeof(float);
+            ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
+            ze_host_mem_alloc_desc_t hostDesc = {ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC};
+            void *sharedA = nullptr;
+            void *sharedB = nullptr;
+            void *sharedC = nullptr;
+            VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 64, device, &sharedA));
+            VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 64, device, &sharedB));
+            VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 64, device, &sharedC));
+            initIterationInput(static_cast<float *>(sharedA), n, 0);
+            initIterationInput(static_cast<float *>(sharedB), n, 1);
+
+            // Generic kernel. Its output is validated too, so the speedup is not measured
+            // against a broken baseline.
+            recordMxMLaunch(cmdList, genericKernel, kernelTsEvent, sharedA, sharedB, sharedC, n, true);
+            BenchStats genericStats = computeStats(timeKernelLaunches(cmdQueue, cmdList, kernelTsEvent, timer, repetitions));
+            float *resultSeq = (float *)malloc(allocSize);
+            double tolerance;
+            bool genericValid;
+            {
+                PHASE_TIMER("validation");
+                tolerance = std::max(0.01, referenceMultiply(static_cast<float *>(sharedA), static_cast<float *>(sharedB), resultSeq, n));
+                genericValid = matchesReference(static_cast<float *>(sharedC), resultSeq, tolerance, n);
+            }
+
+            // Specialized kernel. Only the first request for this shape builds a module;
+            // repeated sizes are served from the cache.
+            int64_t buildTimeBefore = cache.getBuildTimeNs();
+            ze_module_handle_t specModule = cache.get(n, tileK);
+            int64_t buildTimeNs = cache.getBuildTimeNs() - buildTimeBefore;
+            ze_kernel_desc_t specKernelDesc = {ZE_STRUCTURE_TYPE_KERNEL_DESC};
+            specKernelDesc.pKernelName = "mxmSpec";
+            ze_kernel_handle_t specKernel;
+            VALIDATECALL(zeKernelCreate(specModule, &specKernelDesc, &specKernel));
+            memset(sharedC, 0, allocSize);
+            recordMxMLaunch(cmdList, specKernel, kernelTsEvent, sharedA, sharedB, sharedC, n, false);
+            BenchStats specStats = computeStats(timeKernelLaunches(cmdQueue, cmdList, kernelTsEvent, timer, repetitions));
+
+            std::string shape = "N=" + std::to_string(n) + " TILE_K=" + std::to_string(tileK);
+            printStats("GENERIC-KERNEL " + shape, genericStats);
+            printStats("SPEC-KERNEL " + shape, specStats);
+            std::cout << "SPEC-BUILD " << shape << " = " << buildTimeNs << " [ns]" << std::endl;
+            bool specValid;
+            {
+                PHASE_TIMER("validation");
+                specValid = matchesReference(static_cast<float *>(sharedC), resultSeq, tolerance, n);
+            }
+            free(resultSeq);
+            std::cout << "SPEC-SPEEDUP " << shape << " = " << (genericStats.median / specStats.median) << "x"
+                      << (genericValid && specValid ? "" : " (invalid: a kernel failed the validation)") << std::endl;
+            std::cout << "VALIDATION-GENERIC " << shape << " " << (genericValid ? "PASSED" : "FAILED") << std::endl;
+            std::cout << "VALIDATION-SPEC " << shape << " " << (specValid ? "PASSED" : "FAILED") << std::endl;
+            outputValidationSuccessful &= genericValid && specValid;
+
+            VALIDATECALL(zeKernelDestroy(specKernel));
+            VALIDATECALL(zeMemFree(context, sharedA));
+            VALIDATECALL(zeMemFree(context, sharedB));
+            VALIDATECALL(zeMemFree(context, sharedC));
+        }
+        std::cout << "SPEC-CACHE: builds=" << cache.getMisses() << " hits=" << cache.getHits() 
+                  << " total-build=" << cache.getBuildTimeNs() << " [ns]" << std::endl;
+    }
+
+    std::cout << "\nMatrix Multiply validation " << (outputValidationSuccessful ? "PASSED" : "FAILED") << "\n";
+
+    // Cleanup
+    VALIDATECALL(zeKernelDestroy(genericKernel));
+    VALIDATECALL(zeModuleDestroy(genericModule));
+    VALIDATECALL(zeEventDestroy(kernelTsEvent));
+    VALIDATECALL(zeEventPoolDestroy(eventPool));
+    VALIDATECALL(zeCommandListDestroy(cmdList));
+    VALIDATECALL(zeCommandQueueDestroy(cmdQueue));
+    VALIDATECALL(zeContextDestroy(context));
+    return 0;
+}
+
+// Tolerance check for results computed with fp32 accumulation. The bound is the error of a dot
+// product of length n accumulated in fp32: |c - ref| <= n * eps * sum_k |a_ik| * |b_kj|,
+// where absBound holds sum_k |a_ik| * |b_kj|.
+bool validateWithTolerance(const float *c, const float *reference, const float *absBound, size_t count, uint32_t n) {
+    PHASE_TIMER("validation");
+    const float eps = std::numeric_limits<float>::epsilon();
+    for (size_t i = 0; i < count; i++) {
+        if (std::abs(c[i] - reference[i]) > n * eps * absBound[i] + std::numeric_limits<float>::min()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Largest error relative to the magnitude of the products (sum_k |a_ik| * |b_kj|)
+double maxRelativeError(const float *c, const float *reference, const float *absBound, size_t count) {
+    double maxError = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (absBound[i] > 0) {
+            maxError = std::max(maxError, std::abs(static_cast<double>(c[i]) - reference[i]) / absBound[i]);
+        }
+    }
+    return maxError;
+}
+
+// fp32 vs fp16 vs bf16 inputs, all of them with fp32 accumulation and output. The fp16 kernel
+// is only built when the device reports ZE_DEVICE_MODULE_FLAG_FP16. Each result is validated
+// against a CPU reference computed from the same rounded inputs, and the accuracy loss is
+// reported against the fp32 result.
+int runHalfPrecision(uint32_t n, int repetitions) {
+
+    VALIDATECALL(initLevelZero());
+
+    uint32_t driverCount = 1;
+    ze_driver_handle_t driverHandle;
+    VALIDATECALL(zeDriverGet(&driverCount, &driverHandle));
 
-#include <chrono>
-#include <cstring>
-#include <fstream>
-#include <iostream>
-#include <limits>
-#include <memory>
-#include <vector>
+    ze_context_desc_t contextDescription = {};
+    contextDescription.stype = ZE_STRUCTURE_TYPE_CONTEXT_DESC;
+    ze_context_handle_t context;
+    VALIDATECALL(zeContextCreate(driverHandle, &contextDescription, &context));
 
-#define VALIDATION 0
+    uint32_t deviceCount = 1;
+    ze_device_handle_t device;
+    VALIDATECALL(zeDeviceGet(driverHandle, &deviceCount, &device));
 
-#define VALIDATECALL(myZeCall) \
-    if (myZeCall != ZE_RESULT_SUCCESS){ \
-        std::cout << "Error at "       \
-            << #myZeCall << ": "       \
-            << __FUNCTION__ << ": "    \
-            << __LINE__ << std::endl;  \
-        std::cout << "Exit with Error Code: " \
-            << "0x" << std::hex \
-            << myZeCall \
-            << std::dec << std::endl; \
-        std::terminate(); \
+    ze_device_properties_t deviceProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES_1_2};
+    VALIDATECALL(zeDeviceGetProperties(device, &deviceProperties));
+    DeviceTimer timer = deviceTimer(driverHandle, device);
+    std::cout << "Device   : " << deviceProperties.name << std::endl;
+
+    ze_device_module_properties_t moduleProperties = {ZE_STRUCTURE_TYPE_DEVICE_MODULE_PROPERTIES};
+    VALIDATECALL(zeDeviceGetModuleProperties(device, &moduleProperties));
+    bool fp16Supported = (moduleProperties.flags & ZE_DEVICE_MODULE_FLAG_FP16) != 0;
+    std::cout << "FP16     : " << (fp16Supported ? "supported" : "not supported") << std::endl;
+
+    uint32_t ordinal = findComputeOrdinal(device);
+    ze_command_queue_desc_t cmdQueueDesc = {ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC};
+    cmdQueueDesc.ordinal = ordinal;
+    cmdQueueDesc.index = 0;
+    cmdQueueDesc.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
+    ze_command_queue_handle_t cmdQueue;
+    VALIDATECALL(zeCommandQueueCreate(context, device, &cmdQueueDesc, &cmdQueue));
+
+    ze_command_list_handle_t cmdList;
+    ze_command_list_desc_t cmdListDesc = {ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC};
+    cmdListDesc.commandQueueGroupOrdinal = ordinal;
+    VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &cmdList));
+
+    ze_event_pool_handle_t eventPool;
+    ze_event_handle_t kernelTsEvent;
+    createEventPoolAndEvents(context, device, eventPool, ZE_EVENT_POOL_FLAG_KERNEL_TIMESTAMP, 1, &kernelTsEvent);
+
+    // Random inputs in [-1, 1], so the rounding to 16 bits is visible in the results
+    PhaseTimer hostInitTimer("host-init");
+    size_t elements = static_cast<size_t>(n) * n;
+    std::vector<float> a(elements);
+    std::vector<float> b(elements);
+    std::mt19937 generator(31);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    for (size_t i = 0; i < elements; i++) {
+        a[i] = distribution(generator);
+        b[i] = distribution(generator);
     }
 
-// Sequential Matrix Multiplication to validate results
-void matrixMultply(float *a, float *b, float *c, int n) {
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            int sum = 0;
-            for (int k = 0; k < n; k++) {
-                sum += a[i * n + k] * b[k * n + j];
+    // sum_k |a_ik| * |b_kj|, used for the error bounds
+    std::vector<float> absA(elements);
+    std::vector<float> absB(elements);
+    std::vector<float> absBound(elements);
+    for (size_t i = 0; i < elements; i++) {
+        absA[i] = std::abs(a[i]);
+        absB[i] = std::abs(b[i]);
+    }
+    cpuMatrixMultiply(absA.data(), absB.data(), absBound.data(), n);
+
+    std::vector<uint16_t> halfA(elements);
+    std::vector<uint16_t> halfB(elements);
+    std::vector<uint16_t> bf16A(elements);
+    std::vector<uint16_t> bf16B(elements);
+    auto timeConversion = [&](const std::string &name, void (*convert)(const float *, uint16_t *, size_t), 
+                              std::vector<uint16_t> &dstA, std::vector<uint16_t> &dstB) {
+        auto begin = std::chrono::steady_clock::now();
+        convert(a.data(), dstA.data(), elements);
+        convert(b.data(), dstB.data(), elements);
+        auto end = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
+        std::cout << "HOST-CONVERT-" << name << " = " << elapsed << " [ns] (" 
+                  << (2.0 * elements * sizeof(float)) / elapsed << " GB/s read)" << std::endl;
+    };
+    timeConversion("FP16", convertFloatToHalf, halfA, halfB);
+    timeConversion("BF16", convertFloatToBF16, bf16A, bf16B);
+
+    // Inputs seen by the reduced precision kernels, back in fp32 for the CPU references
+    std::vector<float> roundedA(elements);
+    std::vector<float> roundedB(elements);
+    hostInitTimer.stop();
+
+    ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
+    ze_host_mem_alloc_desc_t hostDesc = {ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC};
+    void *sharedA = nullptr;
+    void *sharedB = nullptr;
+    void *sharedC = nullptr;
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, elements * sizeof(float), 64, device, &sharedA));
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, elements * sizeof(float), 64, device, &sharedB));
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, elements * sizeof(float), 64, device, &sharedC));
+    float *resultC = static_cast<float *>(sharedC);
+
+    std::vector<float> reference32(elements);
+    std::vector<float> reference(elements);
+    cpuMatrixMultiply(a.data(), b.data(), reference32.data(), n);
+
+    bool outputValidationSuccessful = true;
+    double fp32Median = 0;
+    auto runVariant = [&](const std::string &name, const char *spirvFile, const char *kernelName, 
+                          const void *inputA, const void *inputB, size_t elementSize, const float *refA, const float *refB) {
+        memcpy(sharedA, inputA, elements * elementSize);
+        memcpy(sharedB, inputB, elements * elementSize);
+        memset(sharedC, 0, elements * sizeof(float));
+
+        ze_module_handle_t module = buildModule(context, device, readSPIRVFile(spirvFile), "");
+        ze_kernel_desc_t kernelDesc = {ZE_STRUCTURE_TYPE_KERNEL_DESC};
+        kernelDesc.pKernelName = kernelName;
+        ze_kernel_handle_t kernel;
+        VALIDATECALL(zeKernelCreate(module, &kernelDesc, &kernel));
+        recordMxMLaunch(cmdList, kernel, kernelTsEvent, sharedA, sharedB, sharedC, n, true);
+        BenchStats stats = computeStats(timeKernelLaunches(cmdQueue, cmdList, kernelTsEvent, timer, repetitions));
+        if (fp32Median == 0) {
+            fp32Median = stats.median;
+        }
+
+        cpuMatrixMultiply(refA, refB, reference.data(), n);
+        bool valid = validateWithTolerance(resultC, reference.data(), absBound.data(), elements, n);
+        outputValidationSuccessful &= valid;
+
+        std::string shape = name + " N=" + std::to_string(n);
+        printStats("KERNEL-" + shape, stats);
+        std::cout << "GFLOPS-" << shape << " = " << (2.0 * n * n * n) / stats.median << " GFLOP/s" << std::endl;
+        std::cout << "SPEEDUP-" << shape << " = " << (fp32Median / stats.median) << "x (vs FP32)" << std::endl;
+        std::cout << "ERROR-" << shape << " = " << maxRelativeError(resultC, reference32.data(), absBound.data(), elements) 
+                  << " (max error vs FP32 result, relative to sum |a||b|)" << std::endl;
+        std::cout << "VALIDATION-" << shape << " " << (valid ? "PASSED" : "FAILED") << std::endl;
+
+        VALIDATECALL(zeKernelDestroy(kernel));
+        VALIDATECALL(zeModuleDestroy(module));
+    };
+
+    runVariant("FP32", "matrixMultiply.spv", "mxm", a.data(), b.data(), sizeof(float), a.data(), b.data());
+
+    if (fp16Supported) {
+        convertHalfToFloat(halfA.data(), roundedA.data(), elements);
+        convertHalfToFloat(halfB.data(), roundedB.data(), elements);
+        runVariant("FP16", "matrixMultiplyFP16.spv", "mxmFP16", halfA.data(), halfB.data(), sizeof(uint16_t), roundedA.data(), roundedB.data());
+    } else {
+        std::cout << "FP16 N=" << n << ": skipped, the device does not support fp16 (ZE_DEVICE_MODULE_FLAG_FP16)" << std::endl;
+    }
+
+    convertBF16ToFloat(bf16A.data(), roundedA.data(), elements);
+    convertBF16ToFloat(bf16B.data(), roundedB.data(), elements);
+    runVariant("BF16", "matrixMultiplyBF16.spv", "mxmBF16", bf16A.data(), bf16B.data(), sizeof(uint16_t), roundedA.data(), roundedB.data());
+
+    std::cout << "\nMatrix Multiply validation " << (outputValidationSuccessful ? "PASSED" : "FAILED") << "\n";
+
+    // Cleanup
+    PHASE_TIMER("cleanup");
+    VALIDATECALL(zeMemFree(context, sharedA));
+    VALIDATECALL(zeMemFree(context, sharedB));
+    VALIDATECALL(zeMemFree(context, sharedC));
+    VALIDATECALL(zeEventDestroy(kernelTsEvent));
+    VALIDATECALL(zeEventPoolDestroy(eventPool));
+    VALIDATECALL(zeCommandListDestroy(cmdList));
+    VALIDATECALL(zeCommandQueueDestroy(cmdQueue));
+    VALIDATECALL(zeContextDestroy(context));
+    return 0;
+}
+
+// int8 x int8 -> int32 matrix multiplication: scalar int8 kernel and the dp4a kernel (packed
+// B, only built when the device reports ZE_DEVICE_MODULE_FLAG_DP4A), next to the fp32 kernel
+// on the same values. Results are compared (exactly) with the SIMD host reference.
+int runInt8(uint32_t n, int repetitions) {
+
+    if (n % 4 != 0) {
+        std::cout << "The size must be a multiple of 4 for the packed int8 layout\n";
+        return -1;
+    }
+
+    VALIDATECALL(initLevelZero());
+
+    uint32_t driverCount = 1;
+    ze_driver_handle_t driverHandle;
+    VALIDATECALL(zeDriverGet(&driverCount, &driverHandle));
+
+    ze_context_desc_t contextDescription = {};
+    contextDescription.stype = ZE_STRUCTURE_TYPE_CONTEXT_DESC;
+    ze_context_handle_t context;
+    VALIDATECALL(zeContextCreate(driverHandle, &contextDescription, &context));
+
+    uint32_t deviceCount = 1;
+    ze_device_handle_t device;
+    VALIDATECALL(zeDeviceGet(driverHandle, &deviceCount, &device));
+
+    ze_device_properties_t deviceProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES_1_2};
+    VALIDATECALL(zeDeviceGetProperties(device, &deviceProperties));
+    DeviceTimer timer = deviceTimer(driverHandle, device);
+    std::cout << "Device   : " << deviceProperties.name << std::endl;
+
+    ze_device_module_properties_t moduleProperties = {ZE_STRUCTURE_TYPE_DEVICE_MODULE_PROPERTIES};
+    VALIDATECALL(zeDeviceGetModuleProperties(device, &moduleProperties));
+    bool dp4aSupported = (moduleProperties.flags & ZE_DEVICE_MODULE_FLAG_DP4A) != 0;
+    std::cout << "DP4A     : " << (dp4aSupported ? "supported" : "not supported") << std::endl;
+
+    uint32_t ordinal = findComputeOrdinal(device);
+    ze_command_queue_desc_t cmdQueueDesc = {ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC};
+    cmdQueueDesc.ordinal = ordinal;
+    cmdQueueDesc.index = 0;
+    cmdQueueDesc.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
+    ze_command_queue_handle_t cmdQueue;
+    VALIDATECALL(zeCommandQueueCreate(context, device, &cmdQueueDesc, &cmdQueue));
+
+    ze_command_list_handle_t cmdList;
+    ze_command_list_desc_t cmdListDesc = {ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC};
+    cmdListDesc.commandQueueGroupOrdinal = ordinal;
+    VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &cmdList));
+
+    ze_event_pool_handle_t eventPool;
+    ze_event_handle_t kernelTsEvent;
+    createEventPoolAndEvents(context, device, eventPool, ZE_EVENT_POOL_FLAG_KERNEL_TIMESTAMP, 1, &kernelTsEvent);
+
+    PhaseTimer hostInitTimer("host-init");
+    size_t elements = static_cast<size_t>(n) * n;
+    std::vector<int8_t> a(elements);
+    std::vector<int8_t> b(elements);
+    std::vector<int8_t> bPacked(elements);
+    std::vector<float> floatA(elements);
+    std::vector<float> floatB(elements);
+    std::mt19937 generator(17);
+    std::uniform_int_distribution<int> distribution(-128, 127);
+    for (size_t i = 0; i < elements; i++) {
+        a[i] = static_cast<int8_t>(distribution(generator));
+        b[i] = static_cast<int8_t>(distribution(generator));
+        floatA[i] = a[i];
+        floatB[i] = b[i];
+    }
+    auto beginPack = std::chrono::steady_clock::now();
+    packInt8B(b.data(), bPacked.data(), n);
+    auto endPack = std::chrono::steady_clock::now();
+    std::cout << "HOST-PACK-B = " << std::chrono::duration_cast<std::chrono::nanoseconds> (endPack - beginPack).count() << " [ns]" << std::endl;
+    hostInitTimer.stop();
+
+    // Host reference (exact): VNNI with the packed B if available, AVX2 or scalar otherwise
+    std::vector<int32_t> reference(elements);
+    std::vector<double> hostTimes;
+    for (int r = 0; r < std::max(1, repetitions / 2); r++) {
+        auto begin = std::chrono::steady_clock::now();
+        cpuMatrixMultiplyInt8(a.data(), b.data(), bPacked.data(), reference.data(), n);
+        auto end = std::chrono::steady_clock::now();
+        hostTimes.push_back(std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count());
+    }
+    BenchStats hostStats = computeStats(hostTimes);
+    printStats("HOST-INT8 N=" + std::to_string(n) + " (" + cpuInt8Path() + ")", hostStats);
+    std::cout << "GOPS-HOST-INT8 N=" << n << " = " << (2.0 * n * n * n) / hostStats.median << " GOP/s" << std::endl;
+
+    ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
+    ze_host_mem_alloc_desc_t hostDesc = {ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC};
+    void *sharedA = nullptr;
+    void *sharedB = nullptr;
+    void *sharedC = nullptr;
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, elements * sizeof(float), 64, device, &sharedA));
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, elements * sizeof(float), 64, device, &sharedB));
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, elements * sizeof(float), 64, device, &sharedC));
+
+    bool outputValidationSuccessful = true;
+    double fp32Median = 0;
+    auto runVariant = [&](const std::string &name, const char *spirvFile, const char *kernelName, 
+                          const void *inputA, const void *inputB, size_t elementSize) {
+        memcpy(sharedA, inputA, elements * elementSize);
+        memcpy(sharedB, inputB, elements * elementSize);
+        memset(sharedC, 0, elements * sizeof(float));
+
+        ze_module_handle_t module = buildModule(context, device, readSPIRVFile(spirvFile), "");
+        ze_kernel_desc_t kernelDesc = {ZE_STRUCTURE_TYPE_KERNEL_DESC};
+        kernelDesc.pKernelName = kernelName;
+        ze_kernel_handle_t kernel;
+        VALIDATECALL(zeKernelCreate(module, &kernelDesc, &kernel));
+        recordMxMLaunch(cmdList, kernel, kernelTsEvent, sharedA, sharedB, sharedC, n, true);
+        BenchStats stats = computeStats(timeKernelLaunches(cmdQueue, cmdList, kernelTsEvent, timer, repetitions));
+        if (fp32Median == 0) {
+            fp32Median = stats.median;
+        }
+
+        // The int kernels must match exactly. The fp32 sums are only exact while |c| < 2^24,
+        // which is guaranteed for n < 1024 (|c| <= n * 128 * 128)
+        bool isFloat = (name == "FP32");
+        bool valid = true;
+        if (!isFloat || n < 1024) {
+            PHASE_TIMER("validation");
+            for (size_t i = 0; i < elements; i++) {
+                int32_t value = isFloat ? static_cast<int32_t>(static_cast<float *>(sharedC)[i]) : static_cast<int32_t *>(sharedC)[i];
+                if (value != reference[i]) {
+                    valid = false;
+                    break;
+                }
             }
-            c[i * n + j] = sum;
         }
+        outputValidationSuccessful &= valid;
+
+        std::string shape = name + " N=" + std::to_string(n);
+        printStats("KERNEL-" + shape, stats);
+        std::cout << "GOPS-" << shape << " = " << (2.0 * n * n * n) / stats.median << " GOP/s" << std::endl;
+        std::cout << "SPEEDUP-" << shape << " = " << (fp32Median / stats.median) << "x (vs FP32)" << std::endl;
+        std::cout << "VALIDATION-" << shape << " " << (valid ? "PASSED" : "FAILED") << std::endl;
+
+        VALIDATECALL(zeKernelDestroy(kernel));
+        VALIDATECALL(zeModuleDestroy(module));
+    };
+
+    runVariant("FP32", "matrixMultiply.spv", "mxm", floatA.data(), floatB.data(), sizeof(float));
+    runVariant("INT8", "matrixMultiplyInt8.spv", "mxmInt8", a.data(), b.data(), sizeof(int8_t));
+    if (dp4aSupported) {
+        runVariant("DP4A", "matrixMultiplyDP4A.spv", "mxmDP4A", a.data(), bPacked.data(), sizeof(int8_t));
+    } else {
+        std::cout << "DP4A N=" << n << ": skipped, the device does not support dp4a (ZE_DEVICE_MODULE_FLAG_DP4A)" << std::endl;
     }
+
+    std::cout << "\nMatrix Multiply validation " << (outputValidationSuccessful ? "PASSED" : "FAILED") << "\n";
+
+    // Cleanup
+    PHASE_TIMER("cleanup");
+    VALIDATECALL(zeMemFree(context, sharedA));
+    VALIDATECALL(zeMemFree(context, sharedB));
+    VALIDATECALL(zeMemFree(context, sharedC));
+    VALIDATECALL(zeEventDestroy(kernelTsEvent));
+    VALIDATECALL(zeEventPoolDestroy(eventPool));
+    VALIDATECALL(zeCommandListDestroy(cmdList));
+    VALIDATECALL(zeCommandQueueDestroy(cmdQueue));
+    VALIDATECALL(zeContextDestroy(context));
+    return 0;
 }
 
-void createEventPoolAndEvents(ze_context_handle_t &context,
-                              ze_device_handle_t &device,
-                              ze_event_pool_handle_t &eventPool,
-                              ze_event_pool_flag_t poolFlag,
-                              uint32_t poolSize,
-                              ze_event_handle_t *events) {
+// B in row-major order (mxm) vs B transposed (mxmTransposedB) vs B packed in panels of 
+// CPU_PACK_WIDTH columns (mxmPackedB), on the host and on the device. B is rearranged once on 
+// the host; that cost is reported separately (TRANSPOSE-B, PACK-B), with the number of 
+// multiplications with the same B needed to pay it off. Without a GPU only the host runs.
+int runPackedB(uint32_t n, int repetitions) {
 
-    ze_event_pool_desc_t eventPoolDesc = {ZE_STRUCTURE_TYPE_EVENT_POOL_DESC};
-    ze_event_desc_t eventDesc = {ZE_STRUCTURE_TYPE_EVENT_DESC};
+    if (n % CPU_PACK_WIDTH != 0) {
+        std::cout << "The size must be a multiple of " << CPU_PACK_WIDTH << " for the packed layout\n";
+        return -1;
+    }
 
-    eventPoolDesc.count = poolSize;
-    eventPoolDesc.flags = poolFlag;
+    PhaseTimer hostInitTimer("host-init");
+    size_t elements = static_cast<size_t>(n) * n;
+    std::vector<float> a(elements);
+    std::vector<float> b(elements);
+    std::vector<float> bT(elements);
+    std::vector<float> bPacked(elements);
+    std::mt19937 generator(23);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    for (size_t i = 0; i < elements; i++) {
+        a[i] = distribution(generator);
+        b[i] = distribution(generator);
+    }
+    hostInitTimer.stop();
+
+    auto timeHost = [&](const std::string &label, int samples, std::function<void()> work) {
+        std::vector<double> times;
+        for (int r = 0; r < samples; r++) {
+            auto begin = std::chrono::steady_clock::now();
+            work();
+            auto end = std::chrono::steady_clock::now();
+            times.push_back(std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count());
+        }
+        BenchStats stats = computeStats(times);
+        printStats(label, stats);
+        return stats.median;
+    };
+    // Multiplications with the same B needed to pay off rearranging it
+    auto printPayoff = [](const std::string &shape, double rearrangeNs, double rowMajorNs, double variantNs) {
+        std::cout << "PAYOFF-" << shape << " = ";
+        if (variantNs < rowMajorNs) {
+            std::cout << rearrangeNs / (rowMajorNs - variantNs) << " multiplications" << std::endl;
+        } else {
+            std::cout << "never (not faster than row-major B)" << std::endl;
+        }
+    };
+
+    std::string size = " N=" + std::to_string(n);
+    double transposeNs;
+    double packNs;
+    {
+        PHASE_TIMER("transfer");
+        transposeNs = timeHost("TRANSPOSE-B" + size, repetitions, [&]() { cpuTranspose(b.data(), bT.data(), n, n); });
+        packNs = timeHost("PACK-B" + size, repetitions, [&]() { cpuPackB(b.data(), bPacked.data(), n); });
+    }
 
-    VALIDATECALL(zeEventPoolCreate(context, &eventPoolDesc, 1, &device, &eventPool));
+    // Host: the sequential references only for small sizes (O(n^3) in one thread), then the
+    // multi-threaded versions
+    std::vector<float> reference(elements);
+    std::vector<float> hostC(elements);
+    bool outputValidationSuccessful = true;
+    {
+        PHASE_TIMER("kernel");
+        if (n <= 1024) {
+            double seqNs = timeHost("HOST-SEQ-ROWMAJOR" + size, 1, [&]() { matrixMultplyRowMajor(a.data(), b.data(), hostC.data(), n); });
+            double seqTransposedNs = timeHost("HOST-SEQ-TRANSPOSED" + size, 1, [&]() { matrixMultplyTransposed(a.data(), bT.data(), hostC.data(), n); });
+            std::cout << "SPEEDUP-HOST-SEQ-TRANSPOSED" << size << " = " << seqNs / seqTransposedNs << "x (vs row-major B)" << std::endl;
+            printPayoff("HOST-SEQ-TRANSPOSED" + size, transposeNs, seqNs, seqTransposedNs);
+        }
+        double rowMajorNs = timeHost("HOST-ROWMAJOR" + size, repetitions, [&]() { cpuMatrixMultiply(a.data(), b.data(), reference.data(), n); });
+        double packedNs = timeHost("HOST-PACKED" + size, repetitions, [&]() { cpuMatrixMultiplyPackedB(a.data(), bPacked.data(), hostC.data(), n); });
+        std::cout << "GFLOPS-HOST-ROWMAJOR" << size << " = " << (2.0 * n * n * n) / rowMajorNs << " GFLOP/s" << std::endl;
+        std::cout << "GFLOPS-HOST-PACKED" << size << " = " << (2.0 * n * n * n) / packedNs << " GFLOP/s" << std::endl;
+        std::cout << "SPEEDUP-HOST-PACKED" << size << " = " << rowMajorNs / packedNs << "x (vs row-major B)" << std::endl;
+        printPayoff("HOST-PACKED" + size, packNs, rowMajorNs, packedNs);
+    }
 
-    for (uint32_t i = 0; i < poolSize; i++) {
-        eventDesc.index = 0;
-        eventDesc.signal = ZE_EVENT_SCOPE_FLAG_HOST;
-        eventDesc.wait = ZE_EVENT_SCOPE_FLAG_HOST;
-        VALIDATECALL(zeEventCreate(eventPool, &eventDesc, events + i));
+    // sum_k |a_ik| * |b_kj|, for the tolerance of the validation
+    std::vector<float> absA(elements);
+    std::vector<float> absB(elements);
+    std::vector<float> absBound(elements);
+    for (size_t i = 0; i < elements; i++) {
+        absA[i] = std::abs(a[i]);
+        absB[i] = std::abs(b[i]);
+    }
+    cpuMatrixMultiply(absA.data(), absB.data(), absBound.data(), n);
+    bool hostValid = validateWithTolerance(hostC.data(), reference.data(), absBound.data(), elements, n);
+    std::cout << "VALIDATION-HOST-PACKED" << size << " " << (hostValid ? "PASSED" : "FAILED") << std::endl;
+    outputValidationSuccessful &= hostValid;
+
+    if (useCpuBackend()) {
+        std::cout << "\nMatrix Multiply validation " << (outputValidationSuccessful ? "PASSED" : "FAILED") << "\n";
+        return 0;
+    }
+
+    PhaseTimer initTimer("init");
+    VALIDATECALL(initLevelZero());
+    uint32_t driverCount = 1;
+    ze_driver_handle_t driverHandle;
+    VALIDATECALL(zeDriverGet(&driverCount, &driverHandle));
+
+    ze_context_desc_t contextDescription = {};
+    contextDescription.stype = ZE_STRUCTURE_TYPE_CONTEXT_DESC;
+    ze_context_handle_t context;
+    VALIDATECALL(zeContextCreate(driverHandle, &contextDescription, &context));
+
+    uint32_t deviceCount = 1;
+    ze_device_handle_t device;
+    VALIDATECALL(zeDeviceGet(driverHandle, &deviceCount, &device));
+
+    ze_device_properties_t deviceProperties = {ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES_1_2};
+    VALIDATECALL(zeDeviceGetProperties(device, &deviceProperties));
+    DeviceTimer timer = deviceTimer(driverHandle, device);
+    std::cout << "Device   : " << deviceProperties.name << std::endl;
+
+    uint32_t ordinal = findComputeOrdinal(device);
+    ze_command_queue_desc_t cmdQueueDesc = {ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC};
+    cmdQueueDesc.ordinal = ordinal;
+    cmdQueueDesc.index = 0;
+    cmdQueueDesc.mode = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS;
+    ze_command_queue_handle_t cmdQueue;
+    VALIDATECALL(zeCommandQueueCreate(context, device, &cmdQueueDesc, &cmdQueue));
+
+    ze_command_list_handle_t cmdList;
+    ze_command_list_desc_t cmdListDesc = {ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC};
+    cmdListDesc.commandQueueGroupOrdinal = ordinal;
+    VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &cmdList));
+
+    ze_event_pool_handle_t eventPool;
+    ze_event_handle_t kernelTsEvent;
+    createEventPoolAndEvents(context, device, eventPool, ZE_EVENT_POOL_FLAG_KERNEL_TIMESTAMP, 1, &kernelTsEvent);
+    initTimer.stop();
+
+    ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
+    ze_host_mem_alloc_desc_t hostDesc = {ZE_STRUCTURE_TYPE_HOST_MEM_ALLOC_DESC};
+    void *sharedA = nullptr;
+    void *sharedB = nullptr;
+    void *sharedC = nullptr;
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, elements * sizeof(float), 64, device, &sharedA));
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, elements * sizeof(float), 64, device, &sharedB));
+    VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, elements * sizeof(float), 64, device, &sharedC));
+    memcpy(sharedA, a.data(), elements * sizeof(float));
+
+    double rowMajorMedian = 0;
+    auto runVariant = [&](const std::string &name, const char *spirvFile, const char *kernelName, const float *inputB, double rearrangeNs, bool dotLanes) {
+        memcpy(sharedB, inputB, elements * sizeof(float));
+        memset(sharedC, 0, elements * sizeof(float));
+
+        ze_module_handle_t module = buildModule(context, device, readSPIRVFile(spirvFile), "");
+        ze_kernel_desc_t kernelDesc = {ZE_STRUCTURE_TYPE_KERNEL_DESC};
+        kernelDesc.pKernelName = kernelName;
+        ze_kernel_handle_t kernel;
+        VALIDATECALL(zeKernelCreate(module, &kernelDesc, &kernel));
+        if (dotLanes) {
+            recordTransposedLaunch(cmdList, kernel, kernelTsEvent, sharedA, sharedB, sharedC, n);
+        } else {
+            recordMxMLaunch(cmdList, kernel, kernelTsEvent, sharedA, sharedB, sharedC, n, true);
+        }
+        BenchStats stats;
+        {
+            PHASE_TIMER("kernel");
+            stats = computeStats(timeKernelLaunches(cmdQueue, cmdList, kernelTsEvent, timer, repetitions));
+        }
+        if (rowMajorMedian == 0) {
+            rowMajorMedian = stats.median;
+        }
+
+        bool valid = validateWithTolerance(static_cast<float *>(sharedC), reference.data(), absBound.data(), elements, n);
+        outputValidationSuccessful &= valid;
+
+        std::string shape = name + size;
+        printStats("KERNEL-" + shape, stats);
+        std::cout << "GFLOPS-" << shape << " = " << (2.0 * n * n * n) / stats.median << " GFLOP/s" << std::endl;
+        std::cout << "SPEEDUP-" << shape << " = " << (rowMajorMedian / stats.median) << "x (vs row-major B)" << std::endl;
+        if (rearrangeNs > 0) {
+            printPayoff(shape, rearrangeNs, rowMajorMedian, stats.median);
+        }
+        std::cout << "VALIDATION-" << shape << " " << (valid ? "PASSED" : "FAILED") << std::endl;
+
+        VALIDATECALL(zeKernelDestroy(kernel));
+        VALIDATECALL(zeModuleDestroy(module));
+    };
+
+    runVariant("ROWMAJOR", "matrixMultiply.spv", "mxm", b.data(), 0, false);
+    runVariant("TRANSPOSED", "matrixMultiplyPackedB.spv", "mxmTransposedB", bT.data(), transposeNs, true);
+    runVariant("PACKED", "matrixMultiplyPackedB.spv", "mxmPackedB", bPacked.data(), packNs, false);
+
+    std::cout << "\nMatrix Multiply validation " << (outputValidationSuccessful ? "PASSED" : "FAILED") << "\n";
+
+    // Cleanup
+    PHASE_TIMER("cleanup");
+    VALIDATECALL(zeMemFree(context, sharedA));
+    VALIDATECALL(zeMemFree(context, sharedB));
+    VALIDATECALL(zeMemFree(context, sharedC));
+    VALIDATECALL(zeEventDestroy(kernelTsEvent));
+    VALIDATECALL(zeEventPoolDestroy(eventPool));
+    VALIDATECALL(zeCommandListDestroy(cmdList));
+    VALIDATECALL(zeCommandQueueDestroy(cmdQueue));
+    VALIDATECALL(zeContextDestroy(context));
+    return 0;
+}
+
+// SEQ is the time of the sequential reference. When the reference is computed with 
+// Strassen-Winograd, it is not a sequential baseline anymore, so it is reported separately.
+void printReferenceTime(int64_t elapsedReference, double referenceBound) {
+    if (referenceBound == 0) {
+        std::cout << "SEQ = " << elapsedReference << " [ns]" << std::endl;
+        return;
+    }
+    std::cout << "REFERENCE-STRASSEN = " << elapsedReference << " [ns]" << std::endl;
+    std::cout << "REFERENCE-ERROR-BOUND = " << referenceBound << std::endl;
+}
+
+// Host references only: blocked O(n^3) (cpuMatrixMultiply) vs Strassen-Winograd, with the 
+// measured difference between both and the normwise error bounds of each one
+int runStrassenReference(uint32_t n, int repetitions) {
+
+    std::cout << "Device   : CPU backend (" << cpuBackendThreads() << " threads" << (cpuSupportsAVX2() ? ", AVX2" : "") << ")\n"
+              << "Crossover: " << strassenCrossover() << std::endl;
+
+    PhaseTimer hostInitTimer("host-init");
+    size_t elements = static_cast<size_t>(n) * n;
+    std::vector<float> a(elements);
+    std::vector<float> b(elements);
+    std::vector<float> blocked(elements);
+    std::vector<float> strassen(elements);
+    std::mt19937 generator(31);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    for (size_t i = 0; i < elements; i++) {
+        a[i] = distribution(generator);
+        b[i] = distribution(generator);
+    }
+    hostInitTimer.stop();
+
+    PhaseTimer kernelTimer("kernel");
+    auto timeReference = [&](const std::string &label, float *c, bool useStrassen) {
+        std::vector<double> samples;
+        for (int r = 0; r < repetitions; r++) {
+            auto begin = std::chrono::steady_clock::now();
+            if (useStrassen) {
+                cpuMatrixMultiplyStrassen(a.data(), b.data(), c, n);
+            } else {
+                cpuMatrixMultiply(a.data(), b.data(), c, n);
+            }
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count());
+        }
+        BenchStats stats = computeStats(samples);
+        printStats(label, stats);
+        std::cout << "GFLOPS-" << label << " " << (2.0 * n * n * n) / stats.median << std::endl;
+        return stats.median;
+    };
+    double blockedNs = timeReference("REFERENCE-BLOCKED", blocked.data(), false);
+    double strassenNs = timeReference("REFERENCE-STRASSEN", strassen.data(), true);
+    kernelTimer.stop();
+
+    PHASE_TIMER("validation");
+    double maxDifference = 0;
+    for (size_t i = 0; i < elements; i++) {
+        maxDifference = std::max(maxDifference, static_cast<double>(std::abs(blocked[i] - strassen[i])));
+    }
+    std::cout << "SPEEDUP-STRASSEN " << blockedNs / strassenNs << "x" << std::endl;
+    std::cout << "MAX-DIFFERENCE " << maxDifference << std::endl;
+    std::cout << "ERROR-BOUND-BLOCKED " << strassenErrorBound(a.data(), b.data(), n, n) << std::endl;
+    std::cout << "ERROR-BOUND-STRASSEN " << strassenErrorBound(a.data(), b.data(), n) << std::endl;
+    return 0;
+}
+
+// Same workload on the CPU backend (multi-threaded + SIMD). The output keeps the same
+// keys as the GPU version, so runBenchmarks.py can parse it.
+int runCpuBackend(uint32_t n) {
+
+    std::cout << "Device   : CPU backend (" << cpuBackendThreads() << " threads" << (cpuSupportsAVX2() ? ", AVX2" : "") << ")\n"
+              << "Type     : CPU" << std::endl;
+
+    PhaseTimer allocTimer("alloc");
+    size_t allocSize = static_cast<size_t>(n) * n * sizeof(float);
+    float *srcA = (float *)malloc(allocSize);
+    float *srcB = (float *)malloc(allocSize);
+    float *dstFloat = (float *)malloc(allocSize);
+    float *resultSeq = (float *)malloc(allocSize);
+    allocTimer.stop();
+
+    PhaseTimer hostInitTimer("host-init");
+    for (size_t i = 0; i < static_cast<size_t>(n) * n; i++) {
+        srcA[i] = 2.5f;
+        srcB[i] = 3.2f;
+    }
+    hostInitTimer.stop();
+
+    PhaseTimer kernelTimer("kernel");
+    auto begin = std::chrono::steady_clock::now();
+    cpuMatrixMultiply(srcA, srcB, dstFloat, n);
+    auto end = std::chrono::steady_clock::now();
+    kernelTimer.stop();
+
+    PhaseTimer validationTimer("validation");
+    std::chrono::steady_clock::time_point beginSeq = std::chrono::steady_clock::now();
+    double referenceBound = referenceMultiply(srcA, srcB, resultSeq, n);
+    std::chrono::steady_clock::time_point endSeq = std::chrono::steady_clock::now();
+
+    auto elapsedParallel = std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
+    auto elapsedSequential = std::chrono::duration_cast<std::chrono::nanoseconds> (endSeq - beginSeq).count();
+    std::cout << "GPU-KERNEL = " << elapsedParallel << " [ns]" << std::endl;
+    std::cout << "PARALLEL = " << elapsedParallel << " [ns]" << std::endl;
+    printReferenceTime(elapsedSequential, referenceBound);
+
+    if (VALIDATION) {
+        bool outputValidationSuccessful = true;
+        double tolerance = std::max(0.1, referenceBound);
+        for (size_t i = 0; i < static_cast<size_t>(n) * n; i++) {
+            if (std::abs(resultSeq[i] - dstFloat[i]) > tolerance) {
+                outputValidationSuccessful = false;
+                break;
+            }
+        }
+        std::cout << "\nMatrix Multiply validation " << (outputValidationSuccessful ? "PASSED" : "FAILED") << "\n";
     }
+    validationTimer.stop();
 
+    free(srcA);
+    free(srcB);
+    free(dstFloat);
+    free(resultSeq);
+    return 0;
 }
 
 int main(int argc, char **argv) {
@@ -97,8 +1923,63 @@ int main(int argc, char **argv) {
 
     std::cout << "Matrix Size: " << sizeMatrix << " x " << sizeMatrix << std::endl;
 
+    std::string mode = "single";
+    if (argc > 2) {
+        mode = argv[2];
+    }
+
+    if (mode == "cpu" || (mode == "single" && useCpuBackend())) {
+        // No Level Zero GPU available (or CPU_BACKEND=1)
+        return runCpuBackend(sizeMatrix);
+    } else if (mode == "multi") {
+        // Row-partitioned execution across all devices and sub-devices
+        bool measuredWeights = (argc > 3) && (std::string(argv[3]) == "measured");
+        return runMultiDevice(sizeMatrix, measuredWeights);
+    } else if (mode == "async") {
+        // Overlap host validation with the execution of the next iteration
+        int iterations = (argc > 3) ? atoi(argv[3]) : 10;
+        return runAsync(sizeMatrix, iterations);
+    } else if (mode == "wait") {
+        // Tail latency of each completion-wait strategy
+        std::string strategy = (argc > 3) ? argv[3] : "all";
+        int iterations = (argc > 4) ? atoi(argv[4]) : 1000;
+        return runWaitStrategies(sizeMatrix, strategy, iterations);
+    } else if (mode == "build") {
+        // Module build time vs. kernel time for each combination of build flags
+        int repetitions = (argc > 3) ? atoi(argv[3]) : 5;
+        std::vector<std::string> extraFiles(argv + std::min(argc, 4), argv + argc);
+        return runBuildBenchmark(sizeMatrix, repetitions, extraFiles);
+    } else if (mode == "spec") {
+        // Kernel specialized for the matrix size (and TILE_K) at module build time.
+        // More sizes (production shapes) can be given after TILE_K.
+        uint32_t tileK = (argc > 3) ? atoi(argv[3]) : 8;
+        int repetitions = 10;
+        std::vector<uint32_t> sizes = {sizeMatrix};
+        for (int i = 4; i < argc; i++) {
+            sizes.push_back(atoi(argv[i]));
+        }
+        return runSpecialized(sizes, tileK, repetitions);
+    } else if (mode == "half") {
+        // fp16 and bf16 inputs with fp32 accumulation, compared against fp32
+        int repetitions = (argc > 3) ? atoi(argv[3]) : 10;
+        return runHalfPrecision(sizeMatrix, repetitions);
+    } else if (mode == "int8") {
+        // int8 x int8 -> int32, scalar and dp4a kernels, compared against fp32
+        int repetitions = (argc > 3) ? atoi(argv[3]) : 10;
+        return runInt8(sizeMatrix, repetitions);
+    } else if (mode == "packed") {
+        // B transposed or packed once, host and device kernels
+        int repetitions = (argc > 3) ? atoi(argv[3]) : 10;
+        return runPackedB(sizeMatrix, repetitions);
+    } else if (mode == "strassen") {
+        // Host references: blocked vs Strassen-Winograd
+        int repetitions = (argc > 3) ? atoi(argv[3]) : 3;
+        return runStrassenReference(sizeMatrix, repetitions);
+    }
+
     // Initialization
-    VALIDATECALL(zeInit(ZE_INIT_FLAG_GPU_ONLY));
+    PhaseTimer initTimer("init");
+    VALIDATECALL(initLevelZero());
 
     // Get the driver
     uint32_t driverCount = 0;
@@ -123,9 +2004,12 @@ int main(int argc, char **argv) {
     // Print basic properties of the device
     ze_device_properties_t deviceProperties = {};
     VALIDATECALL(zeDeviceGetProperties(device, &deviceProperties));
+    ze_driver_properties_t driverProperties = {ZE_STRUCTURE_TYPE_DRIVER_PROPERTIES};
+    VALIDATECALL(zeDriverGetProperties(driverHandle, &driverProperties));
     std::cout << "Device   : " << deviceProperties.name << "\n" 
               << "Type     : " << ((deviceProperties.type == ZE_DEVICE_TYPE_GPU) ? "GPU" : "FPGA") << "\n"
-              << "Vendor ID: " << std::hex << deviceProperties.vendorId << std::dec << "\n";
+              << "Vendor ID: " << std::hex << deviceProperties.vendorId << std::dec << "\n"
+              << "Driver   : " << driverProperties.driverVersion << "\n";
 
     // Create a command queue
     uint32_t numQueueGroups = 0;
@@ -156,8 +2040,10 @@ int main(int argc, char **argv) {
     ze_command_list_desc_t cmdListDesc = {};
     cmdListDesc.commandQueueGroupOrdinal = cmdQueueDesc.ordinal;    
     VALIDATECALL(zeCommandListCreate(context, device, &cmdListDesc, &cmdList));
+    initTimer.stop();
 
     // Create two buffers
+    PhaseTimer allocTimer("alloc");
     uint32_t items = sizeMatrix;
     size_t allocSize = items * items * sizeof(float);
     ze_device_mem_alloc_desc_t memAllocDesc = {ZE_STRUCTURE_TYPE_DEVICE_MEM_ALLOC_DESC};
@@ -177,15 +2063,18 @@ int main(int argc, char **argv) {
     void *dstResult = nullptr;
     VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, allocSize, 1, device, &dstResult));
 
-
-    // memory initialization
-    memset(sharedA, 2.5, allocSize);
-    memset(sharedB, 3.2, allocSize);
-    memset(dstResult, 0.0, allocSize);
-
     void *timestampBuffer = nullptr;
     VALIDATECALL(zeMemAllocHost(context, &hostDesc, sizeof(ze_kernel_timestamp_result_t), 1, &timestampBuffer));
+    allocTimer.stop();
+
+    // memory initialization
+    PhaseTimer hostInitTimer("host-init");
+    int initNode = firstTouchNode(device);
+    parallelMemset(sharedA, 2.5, allocSize, initNode);
+    parallelMemset(sharedB, 3.2, allocSize, initNode);
+    parallelMemset(dstResult, 0.0, allocSize, initNode);
     memset(timestampBuffer, 0, sizeof(ze_kernel_timestamp_result_t));
+    hostInitTimer.stop();
 
     //VALIDATECALL(zeMemAllocShared(context, &memAllocDesc, &hostDesc, sizeof(ze_kernel_timestamp_result_t), 1, device, &timestampBuffer));
 
@@ -193,6 +2082,7 @@ int main(int argc, char **argv) {
     
 
     // Module Initialization
+    PhaseTimer moduleTimer("module");
     ze_module_handle_t module = nullptr;
     ze_kernel_handle_t kernel = nullptr;
 
@@ -237,6 +2127,7 @@ int main(int argc, char **argv) {
         ze_kernel_desc_t kernelDesc = {};
         kernelDesc.pKernelName = "mxm";
         VALIDATECALL(zeKernelCreate(module, &kernelDesc, &kernel));
+        moduleTimer.stop();
 
         uint32_t groupSizeX = 64u;
         uint32_t groupSizeY = 64u;
@@ -279,53 +2170,32 @@ int main(int argc, char **argv) {
         std::terminate();
     }
 
+    PhaseTimer kernelTimer("kernel");
     begin = std::chrono::steady_clock::now();
     VALIDATECALL(zeCommandListClose(cmdList));
     VALIDATECALL(zeCommandQueueExecuteCommandLists(cmdQueue, 1, &cmdList, nullptr));    
     VALIDATECALL(zeCommandQueueSynchronize(cmdQueue, std::numeric_limits<uint64_t>::max()));
     end = std::chrono::steady_clock::now();
+    kernelTimer.stop();
 
    
     ze_kernel_timestamp_result_t *kernelTsResults = reinterpret_cast<ze_kernel_timestamp_result_t *>(timestampBuffer);
 
-    uint64_t timerResolution = deviceProperties.timerResolution;
-    uint64_t kernelDuration = kernelTsResults->context.kernelEnd - kernelTsResults->context.kernelStart;
-    uint64_t gpuKernelTime;
-
-    std::cout << "Kernel timestamp statistics (V1.2 and later): \n"
-                  << std::fixed
-                  << "\tGlobal start : " << std::dec << kernelTsResults->global.kernelStart << " cycles\n"
-                  << "\tKernel start: " << std::dec << kernelTsResults->context.kernelStart << " cycles\n"
-                  << "\tKernel end: " << std::dec << kernelTsResults->context.kernelEnd << " cycles\n"
-                  << "\tGlobal end: " << std::dec << kernelTsResults->global.kernelEnd << " cycles\n"
-                  << "\ttimerResolution clock: " << std::dec << timerResolution << " cycles/s\n"
-                  << "\tKernel duration : " << std::dec << kernelDuration << " cycles, " << kernelDuration * (1000000000.0 / static_cast<double>(timerResolution)) << " ns\n";
-                  gpuKernelTime =  kernelDuration * (1000000000.0 / static_cast<double>(timerResolution));
+    DeviceTimer timer = deviceTimer(driverHandle, device);
+    uint64_t kernelDuration = timestampCycles(kernelTsResults->context.kernelStart, kernelTsResults->context.kernelEnd, timer.kernelTimestampMask);
+    uint64_t gpuKernelTime = static_cast<uint64_t>(cyclesToNs(timer, kernelDuration));
 
-    if (deviceProperties.stype == ZE_STRUCTURE_TYPE_DEVICE_PROPERTIES_1_2) {
-        std::cout << "Kernel timestamp statistics (V1.2 and later): \n"
-                  << std::fixed
-                  << "\tGlobal start : " << std::dec << kernelTsResults->global.kernelStart << " cycles\n"
-                  << "\tKernel start: " << std::dec << kernelTsResults->context.kernelStart << " cycles\n"
-                  << "\tKernel end: " << std::dec << kernelTsResults->context.kernelEnd << " cycles\n"
-                  << "\tGlobal end: " << std::dec << kernelTsResults->global.kernelEnd << " cycles\n"
-                  << "\ttimerResolution clock: " << std::dec << timerResolution << " cycles/s\n"
-                  << "\tKernel duration : " << std::dec << kernelDuration << " cycles, " << kernelDuration * (1000000000.0 / static_cast<double>(timerResolution)) << " ns\n";
-                  gpuKernelTime =  kernelDuration * (1000000000.0 / static_cast<double>(timerResolution));
-    } else {
-        std::cout << "Kernel timestamp statistics (prior to V1.2): \n"
+    std::cout << "Kernel timestamp statistics: \n"
                   << std::fixed
                   << "\tGlobal start : " << std::dec << kernelTsResults->global.kernelStart << " cycles\n"
                   << "\tKernel start: " << std::dec << kernelTsResults->context.kernelStart << " cycles\n"
                   << "\tKernel end: " << std::dec << kernelTsResults->context.kernelEnd << " cycles\n"
                   << "\tGlobal end: " << std::dec << kernelTsResults->global.kernelEnd << " cycles\n"
-                  << "\ttimerResolution: " << std::dec << timerResolution << " ns\n"
-                  << "\tKernel duration : " << std::dec << kernelDuration << " cycles\n"
-                  << "\tKernel Time: " << kernelDuration * timerResolution << " ns\n";
-                  gpuKernelTime = kernelDuration * timerResolution;
-    }
+                  << "\tTimer clock: " << std::dec << timer.cyclesPerSecond << " cycles/s (" << timer.nsPerCycle << " ns/cycle)\n"
+                  << "\tKernel duration : " << std::dec << kernelDuration << " cycles, " << gpuKernelTime << " ns\n";
 
     // Validate
+    PhaseTimer validationTimer("validation");
     bool outputValidationSuccessful = true;
 
     float *resultSeq = (float *)malloc(allocSize);
@@ -334,14 +2204,14 @@ int main(int argc, char **argv) {
     float *srcB = static_cast<float *>(sharedB);
 
     std::chrono::steady_clock::time_point beginSeq = std::chrono::steady_clock::now();
-    matrixMultply(srcA, srcB, resultSeq, items);
+    double referenceBound = referenceMultiply(srcA, srcB, resultSeq, items);
     std::chrono::steady_clock::time_point endSeq = std::chrono::steady_clock::now();
 
     auto elapsedParallel = std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count();
     auto elapsedSequential = std::chrono::duration_cast<std::chrono::nanoseconds> (endSeq - beginSeq).count();
     std::cout << "GPU-KERNEL = " << gpuKernelTime << " [ns]" << std::endl;
     std::cout << "PARALLEL = " << elapsedParallel << " [ns]" << std::endl;
-    std::cout << "SEQ = " << elapsedSequential << " [ns]" << std::endl;
+    printReferenceTime(elapsedSequential, referenceBound);
     auto speedup = elapsedSequential / elapsedParallel;
     //std::cout << "Speedup = " << speedup << "x" << std::endl;
 
@@ -349,7 +2219,7 @@ int main(int argc, char **argv) {
         int n = items;
         for (int i = 0; i < n; i++) {
             for (int j = 0; j < n; j++) {
-                if (resultSeq[i * n + j] != dstFloat[i * n + j]) {
+                if (std::abs(resultSeq[i * n + j] - dstFloat[i * n + j]) > referenceBound) {
                     outputValidationSuccessful = false;
                     break;
                 } 
@@ -357,8 +2227,10 @@ int main(int argc, char **argv) {
         }
         std::cout << "\nMatrix Multiply validation " << (outputValidationSuccessful ? "PASSED" : "FAILED") << "\n";
     }
+    validationTimer.stop();
  
     // Cleanup
+    PHASE_TIMER("cleanup");
     VALIDATECALL(zeMemFree(context, timestampBuffer));
     VALIDATECALL(zeMemFree(context, dstResult));
     VALIDATECALL(zeMemFree(context, sharedA));
@@ -0,0 +1,203 @@
+#!/usr/bin/python
+
+# MIT License
+#
+# Copyright (c) 2026, Juan Fumero
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+
+# Performance regression detector for the databases of runBenchmarks.py (COPY_PERFORMANCE,
+# KERNEL_PERFORMANCE). For each (NAME, SIZE), the samples of a run are compared against a
+# baseline run with a two-sided Mann-Whitney U test. The effect size is Cliff's delta, plus the
+# relative change of the median. Lower times are better.
+#
+# A (NAME, SIZE) is a regression if the difference is significant (p < alpha), the median is
+# slower by more than the threshold and the effect size is at least --min-effect. The exit code
+# is 1 if there is any regression, so it can be used in scripts and CI.
+
+import sqlite3
+import argparse
+import math
+import sys
+
+TABLES = ["COPY_PERFORMANCE", "KERNEL_PERFORMANCE"]
+
+def median(values):
+    s = sorted(values)
+    n = len(s)
+    return s[n // 2] if n % 2 == 1 else (s[n // 2 - 1] + s[n // 2]) / 2.0
+
+def rankWithTies(values):
+    """ Average ranks (1-based), and the tie groups sizes for the variance correction """
+    order = sorted(range(len(values)), key=lambda i: values[i])
+    ranks = [0.0] * len(values)
+    ties = []
+    i = 0
+    while i < len(order):
+        j = i
+        while j + 1 < len(order) and values[order[j + 1]] == values[order[i]]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[order[k]] = (i + j) / 2.0 + 1
+        if j > i:
+            ties.append(j - i + 1)
+        i = j + 1
+    return ranks, ties
+
+def exactPValue(u, n1, n2):
+    """ Two-sided p-value from the exact distribution of U (no ties), by counting the
+        arrangements with the recurrence f(u; n1, n2) = f(u - n2; n1 - 1, n2) + f(u; n1, n2 - 1) """
+    maxU = n1 * n2
+    counts = [[[0] * (maxU + 1) for _ in range(n2 + 1)] for _ in range(n1 + 1)]
+    for a in range(n1 + 1):
+        for b in range(n2 + 1):
+            if a == 0 or b == 0:
+                counts[a][b][0] = 1
+                continue
+            for x in range(a * b + 1):
+                c = counts[a][b - 1][x]
+                if x >= b:
+                    c += counts[a - 1][b][x - b]
+                counts[a][b][x] = c
+    total = sum(counts[n1][n2])
+    uLow = min(u, maxU - u)
+    tail = sum(counts[n1][n2][x] for x in range(int(math.floor(uLow)) + 1))
+    return min(1.0, 2.0 * tail / total)
+
+def mannWhitney(x, y):
+    """ U statistic of x, two-sided p-value and Cliff's delta (P(x > y) - P(x < y)) """
+    n1 = len(x)
+    n2 = len(y)
+    ranks, ties = rankWithTies(list(x) + list(y))
+    r1 = sum(ranks[:n1])
+    u1 = r1 - n1 * (n1 + 1) / 2.0
+    delta = 2.0 * u1 / (n1 * n2) - 1.0
+    if not ties and n1 + n2 <= 40:
+        p = exactPValue(u1, n1, n2)
+    else:
+        # Normal approximation with tie and continuity corrections
+        n = n1 + n2
+        mean = n1 * n2 / 2.0
+        tieTerm = sum(t ** 3 - t for t in ties) / (n * (n - 1.0))
+        sigma = math.sqrt(n1 * n2 / 12.0 * ((n + 1) - tieTerm))
+        if sigma == 0:
+            p = 1.0
+        else:
+            z = (abs(u1 - mean) - 0.5) / sigma
+            p = min(1.0, math.erfc(max(z, 0) / math.sqrt(2)))
+    return u1, p, delta
+
+def detectTable(conn):
+    names = [row[0] for row in conn.execute("SELECT name FROM sqlite_master WHERE type='table'")]
+    for table in TABLES:
+        if table in names:
+            return table
+    print("No benchmark table found (" + ", ".join(TABLES) + ")")
+    sys.exit(2)
+
+def lastRuns(conn, table):
+    cursor = conn.execute("SELECT DISTINCT run_id FROM " + table + " WHERE run_id IS NOT NULL ORDER BY run_id")
+    return [row[0] for row in cursor]
+
+def runMetadata(conn, runId):
+    cursor = conn.execute("SELECT date, device, driver, commit_id FROM RUN_METADATA WHERE run_id = ?", (runId,))
+    row = cursor.fetchone()
+    if row == None:
+        return "run " + str(runId)
+    return "run " + str(runId) + " (" + str(row[0]) + ", '" + str(row[1]) + "', driver " + str(row[2]) + ", commit " + str(row[3]) + ")"
+
+def loadSamples(conn, table, runId):
+    samples = {}
+    for row in conn.execute("SELECT name, size, time FROM " + table + " WHERE run_id = ?", (runId,)):
+        samples.setdefault((row[0], row[1]), []).append(row[2])
+    return samples
+
+def parseArguments():
+    """ Parse command line arguments """
+    parser = argparse.ArgumentParser(description='Compare a benchmark run against a baseline run and flag performance regressions')
+    parser.add_argument('--db', dest="dbName", help='Data Base File Name (from runBenchmarks.py)', required=True)
+    parser.add_argument('--baseline-db', dest="baselineDbName", default=None, help='Data Base of the baseline run (default: --db)')
+    parser.add_argument('--baseline', dest="baseline", type=int, default=None, help='Baseline RUN_ID (default: the run before --run)')
+    parser.add_argument('--run', dest="run", type=int, default=None, help='RUN_ID to check (default: the last run)')
+    parser.add_argument('--threshold', dest="threshold", type=float, default=5.0, help='Minimum slowdown of the median to report, in %% (default 5)')
+    parser.add_argument('--alpha', dest="alpha", type=float, default=0.05, help='Significance level of the Mann-Whitney test (default 0.05)')
+    parser.add_argument('--min-effect', dest="minEffect", type=float, default=0.33, help="Minimum |Cliff's delta| (default 0.33, medium)")
+    parser.add_argument('--all', action="store_true", dest="showAll", default=False, help='Print all comparisons, not only the changes')
+    args = parser.parse_args()
+    return args
+
+if __name__ == "__main__":
+
+    args = parseArguments()
+
+    conn = sqlite3.connect(args.dbName)
+    baselineConn = sqlite3.connect(args.baselineDbName) if args.baselineDbName else conn
+    table = detectTable(conn)
+    baselineTable = detectTable(baselineConn)
+
+    runs = lastRuns(conn, table)
+    runId = args.run if args.run != None else (runs[-1] if runs else None)
+    if args.baseline != None:
+        baselineId = args.baseline
+    elif baselineConn is conn:
+        previous = [r for r in runs if runId != None and r < runId]
+        baselineId = previous[-1] if previous else None
+    else:
+        baselineRuns = lastRuns(baselineConn, baselineTable)
+        baselineId = baselineRuns[-1] if baselineRuns else None
+    if runId == None or baselineId == None:
+        print("Two runs are needed (runs with RUN_ID in " + args.dbName + ": " + str(runs) + ")")
+        sys.exit(2)
+
+    print("BASELINE: " + runMetadata(baselineConn, baselineId))
+    print("RUN     : " + runMetadata(conn, runId))
+
+    baseline = loadSamples(baselineConn, baselineTable, baselineId)
+    current = loadSamples(conn, table, runId)
+
+    regressions = 0
+    improvements = 0
+    print("STATUS NAME SIZE MEDIAN-BASELINE MEDIAN-RUN CHANGE(%) P-VALUE CLIFFS-DELTA N-BASELINE N-RUN")
+    for key in sorted(set(baseline) & set(current), key=lambda k: (k[0], k[1])):
+        x = current[key]
+        y = baseline[key]
+        if len(x) < 2 or len(y) < 2:
+            continue
+        u, p, delta = mannWhitney(x, y)
+        medianX = median(x)
+        medianY = median(y)
+        change = 100.0 * (medianX - medianY) / medianY if medianY != 0 else 0.0
+        significant = p < args.alpha and abs(delta) >= args.minEffect and abs(change) > args.threshold
+        if significant and change > 0:
+            status = "REGRESSION"
+            regressions += 1
+        elif significant and change < 0:
+            status = "IMPROVEMENT"
+            improvements += 1
+        else:
+            status = "SAME"
+        if status != "SAME" or args.showAll:
+            print(status, key[0], key[1], medianY, medianX, "%.2f" % change, "%.4g" % p, "%.3f" % delta, len(y), len(x))
+
+    missing = sorted(set(baseline) - set(current))
+    if missing:
+        print("Not in the run: " + ", ".join(str(k[0]) + "/" + str(k[1]) for k in missing))
+    print("REGRESSIONS = " + str(regressions) + " IMPROVEMENTS = " + str(improvements))
+    sys.exit(1 if regressions > 0 else 0)
@@ -0,0 +1,275 @@
+/*
+ * MIT License
+ * 
+ * Copyright (c) 2026, Juan Fumero
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Interception layer for the Level Zero API calls used in the examples. 
+// Each wrapper forwards the call to the real implementation (the next definition of the 
+// symbol, usually the Level Zero loader) and records the number of calls and the host-side 
+// latency in a log2 histogram. A summary per API is printed when the process exits.
+// 
+// Use it preloaded:
+//     LD_PRELOAD=/path/to/libzeTracer.so ./mxm 512
+// or compiled in, by adding zeTracer.cpp to the build of a program (and -ldl).
+// 
+// Environment variables:
+//     ZE_TRACER_OUTPUT=<file>   write the summary to a file instead of stderr
+//     ZE_TRACER_HISTOGRAM=1     also print the latency histogram of each API
+
+#include <ze_api.h>
+
+#include <dlfcn.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Bucket i counts calls with latency in [2^i, 2^(i+1)) ns. Bucket 0 also counts 0 ns.
+constexpr int NUM_BUCKETS = 48;
+
+struct ApiStats {
+    explicit ApiStats(const char *name) : name(name), calls(0), totalNs(0), maxNs(0), minNs(UINT64_MAX) {
+        for (auto &bucket : histogram) {
+            bucket = 0;
+        }
+    }
+
+    void record(uint64_t ns) {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        totalNs.fetch_add(ns, std::memory_order_relaxed);
+        uint64_t currentMax = maxNs.load(std::memory_order_relaxed);
+        while (ns > currentMax && !maxNs.compare_exchange_weak(currentMax, ns, std::memory_order_relaxed)) {
+        }
+        uint64_t currentMin = minNs.load(std::memory_order_relaxed);
+        while (ns < currentMin && !minNs.compare_exchange_weak(currentMin, ns, std::memory_order_relaxed)) {
+        }
+        int bucket = (ns == 0) ? 0 : 63 - __builtin_clzll(ns);
+        histogram[std::min(bucket, NUM_BUCKETS - 1)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Upper bound of the bucket that contains the given percentile
+    uint64_t percentileUpperBound(double p) const {
+        uint64_t total = calls.load();
+        uint64_t target = static_cast<uint64_t>(p / 100.0 * total);
+        uint64_t accumulated = 0;
+        for (int i = 0; i < NUM_BUCKETS; i++) {
+            accumulated += histogram[i].load();
+            if (accumulated > target) {
+                return std::min(1ULL << (i + 1), static_cast<unsigned long long>(maxNs.load()));
+            }
+        }
+        return maxNs.load();
+    }
+
+    const char *name;
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> totalNs;
+    std::atomic<uint64_t> maxNs;
+    std::atomic<uint64_t> minNs;
+    std::atomic<uint64_t> histogram[NUM_BUCKETS];
+};
+
+// Stats objects are never freed, so they are still alive when the summary is printed at exit
+struct Registry {
+    std::mutex lock;
+    std::vector<ApiStats *> apis;
+
+    ApiStats *get(const char *name) {
+        std::lock_guard<std::mutex> guard(lock);
+        ApiStats *stats = new ApiStats(name);
+        apis.push_back(stats);
+        return stats;
+    }
+};
+
+Registry &registry() {
+    static Registry *instance = new Registry();
+    return *instance;
+}
+
+void *lookupRealFunction(const char *name) {
+    void *function = dlsym(RTLD_NEXT, name);
+    if (function == nullptr) {
+        fprintf(stderr, "[zeTracer] Symbol not found: %s\n", name);
+        std::abort();
+    }
+    return function;
+}
+
+void printSummary() {
+    const char *outputFile = std::getenv("ZE_TRACER_OUTPUT");
+    FILE *out = (outputFile != nullptr) ? fopen(outputFile, "w") : stderr;
+    if (out == nullptr) {
+        out = stderr;
+    }
+    bool printHistogram = (std::getenv("ZE_TRACER_HISTOGRAM") != nullptr);
+
+    std::vector<ApiStats *> apis;
+    {
+        std::lock_guard<std::mutex> guard(registry().lock);
+        for (auto stats : registry().apis) {
+            if (stats->calls.load() > 0) {
+                apis.push_back(stats);
+            }
+        }
+    }
+    std::sort(apis.begin(), apis.end(), [](ApiStats *a, ApiStats *b) {
+        return a->totalNs.load() > b->totalNs.load();
+    });
+
+    uint64_t totalNs = 0;
+    for (auto stats : apis) {
+        totalNs += stats->totalNs.load();
+    }
+
+    fprintf(out, "\n[zeTracer] Host time per Level Zero API call (percentiles are upper bounds of log2 buckets)\n");
+    fprintf(out, "%-42s %10s %14s %7s %12s %12s %12s %12s %12s\n", 
+            "API", "CALLS", "TOTAL(ns)", "%", "MEAN(ns)", "MIN(ns)", "P50(ns)", "P99(ns)", "MAX(ns)");
+    for (auto stats : apis) {
+        uint64_t calls = stats->calls.load();
+        uint64_t total = stats->totalNs.load();
+        fprintf(out, "%-42s %10lu %14lu %7.2f %12lu %12lu %12lu %12lu %12lu\n", 
+                stats->name, 
+                static_cast<unsigned long>(calls), 
+                static_cast<unsigned long>(total), 
+                (totalNs > 0) ? 100.0 * total / totalNs : 0.0,
+                static_cast<unsigned long>(total / calls), 
+                static_cast<unsigned long>(stats->minNs.load()), 
+                static_cast<unsigned long>(stats->percentileUpperBound(50)), 
+                static_cast<unsigned long>(stats->percentileUpperBound(99)), 
+                static_cast<unsigned long>(stats->maxNs.load()));
+        if (printHistogram) {
+            for (int i = 0; i < NUM_BUCKETS; i++) {
+                uint64_t count = stats->histogram[i].load();
+                if (count > 0) {
+                    fprintf(out, "    [%12llu, %12llu) ns : %lu\n", 1ULL << i, 1ULL << (i + 1), static_cast<unsigned long>(count));
+                }
+            }
+        }
+    }
+    fprintf(out, "%-42s %10s %14lu\n", "TOTAL", "", static_cast<unsigned long>(totalNs));
+
+    if (out != stderr) {
+        fclose(out);
+    }
+}
+
+__attribute__((destructor)) void zeTracerAtExit() {
+    printSummary();
+}
+
+} // namespace
+
+// Define a wrapper with the same signature as the API. The real function and the stats 
+// object are resolved the first time the API is called.
+#define ZE_TRACE(name, params, args)                                                              \
+    extern "C" ze_result_t name params {                                                          \
+        using FunctionType = ze_result_t (*) params;                                              \
+        static FunctionType realFunction = reinterpret_cast<FunctionType>(lookupRealFunction(#name)); \
+        static ApiStats *stats = registry().get(#name);                                           \
+        auto begin = std::chrono::steady_clock::now();                                            \
+        ze_result_t result = realFunction args;                                                   \
+        auto end = std::chrono::steady_clock::now();                                              \
+        stats->record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()); \
+        return result;                                                                            \
+    }
+
+// Initialization and devices
+ZE_TRACE(zeInit, (ze_init_flags_t flags), (flags))
+ZE_TRACE(zeDriverGet, (uint32_t *pCount, ze_driver_handle_t *phDrivers), (pCount, phDrivers))
+ZE_TRACE(zeDriverGetApiVersion, (ze_driver_handle_t hDriver, ze_api_version_t *version), (hDriver, version))
+ZE_TRACE(zeDriverGetProperties, (ze_driver_handle_t hDriver, ze_driver_properties_t *pDriverProperties), (hDriver, pDriverProperties))
+ZE_TRACE(zeDeviceGet, (ze_driver_handle_t hDriver, uint32_t *pCount, ze_device_handle_t *phDevices), (hDriver, pCount, phDevices))
+ZE_TRACE(zeDeviceGetSubDevices, (ze_device_handle_t hDevice, uint32_t *pCount, ze_device_handle_t *phSubdevices), (hDevice, pCount, phSubdevices))
+ZE_TRACE(zeDeviceGetProperties, (ze_device_handle_t hDevice, ze_device_properties_t *pDeviceProperties), (hDevice, pDeviceProperties))
+ZE_TRACE(zeDeviceGetModuleProperties, (ze_device_handle_t hDevice, ze_device_module_properties_t *pModuleProperties), (hDevice, pModuleProperties))
+ZE_TRACE(zeDeviceGetMemoryProperties, (ze_device_handle_t hDevice, uint32_t *pCount, ze_device_memory_properties_t *pMemProperties), (hDevice, pCount, pMemProperties))
+ZE_TRACE(zeDeviceGetMemoryAccessProperties, (ze_device_handle_t hDevice, ze_device_memory_access_properties_t *pMemAccessProperties), (hDevice, pMemAccessProperties))
+ZE_TRACE(zeDevicePciGetPropertiesExt, (ze_device_handle_t hDevice, ze_pci_ext_properties_t *pPciProperties), (hDevice, pPciProperties))
+ZE_TRACE(zeDeviceGetCommandQueueGroupProperties, (ze_device_handle_t hDevice, uint32_t *pCount, ze_command_queue_group_properties_t *pCommandQueueGroupProperties), (hDevice, pCount, pCommandQueueGroupProperties))
+ZE_TRACE(zeContextCreate, (ze_driver_handle_t hDriver, const ze_context_desc_t *desc, ze_context_handle_t *phContext), (hDriver, desc, phContext))
+ZE_TRACE(zeContextDestroy, (ze_context_handle_t hContext), (hContext))
+
+// Command queues and command lists
+ZE_TRACE(zeCommandQueueCreate, (ze_context_handle_t hContext, ze_device_handle_t hDevice, const ze_command_queue_desc_t *desc, ze_command_queue_handle_t *phCommandQueue), (hContext, hDevice, desc, phCommandQueue))
+ZE_TRACE(zeCommandQueueDestroy, (ze_command_queue_handle_t hCommandQueue), (hCommandQueue))
+ZE_TRACE(zeCommandQueueExecuteCommandLists, (ze_command_queue_handle_t hCommandQueue, uint32_t numCommandLists, ze_command_list_handle_t *phCommandLists, ze_fence_handle_t hFence), (hCommandQueue, numCommandLists, phCommandLists, hFence))
+ZE_TRACE(zeCommandQueueSynchronize, (ze_command_queue_handle_t hCommandQueue, uint64_t timeout), (hCommandQueue, timeout))
+ZE_TRACE(zeCommandListCreate, (ze_context_handle_t hContext, ze_device_handle_t hDevice, const ze_command_list_desc_t *desc, ze_command_list_handle_t *phCommandList), (hContext, hDevice, desc, phCommandList))
+ZE_TRACE(zeCommandListCreateImmediate, (ze_context_handle_t hContext, ze_device_handle_t hDevice, const ze_command_queue_desc_t *altdesc, ze_command_list_handle_t *phCommandList), (hContext, hDevice, altdesc, phCommandList))
+ZE_TRACE(zeCommandListDestroy, (ze_command_list_handle_t hCommandList), (hCommandList))
+ZE_TRACE(zeCommandListClose, (ze_command_list_handle_t hCommandList), (hCommandList))
+ZE_TRACE(zeCommandListReset, (ze_command_list_handle_t hCommandList), (hCommandList))
+ZE_TRACE(zeCommandListAppendBarrier, (ze_command_list_handle_t hCommandList, ze_event_handle_t hSignalEvent, uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents), (hCommandList, hSignalEvent, numWaitEvents, phWaitEvents))
+ZE_TRACE(zeCommandListAppendMemoryCopy, (ze_command_list_handle_t hCommandList, void *dstptr, const void *srcptr, size_t size, ze_event_handle_t hSignalEvent, uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents), (hCommandList, dstptr, srcptr, size, hSignalEvent, numWaitEvents, phWaitEvents))
+ZE_TRACE(zeCommandListAppendMemoryCopyRegion, (ze_command_list_handle_t hCommandList, void *dstptr, const ze_copy_region_t *dstRegion, uint32_t dstPitch, uint32_t dstSlicePitch, const void *srcptr, const ze_copy_region_t *srcRegion, uint32_t srcPitch, uint32_t srcSlicePitch, ze_event_handle_t hSignalEvent, uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents), (hCommandList, dstptr, dstRegion, dstPitch, dstSlicePitch, srcptr, srcRegion, srcPitch, srcSlicePitch, hSignalEvent, numWaitEvents, phWaitEvents))
+ZE_TRACE(zeCommandListAppendMemoryFill, (ze_command_list_handle_t hCommandList, void *ptr, const void *pattern, size_t patternSize, size_t size, ze_event_handle_t hSignalEvent, uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents), (hCommandList, ptr, pattern, patternSize, size, hSignalEvent, numWaitEvents, phWaitEvents))
+ZE_TRACE(zeCommandListAppendMemoryPrefetch, (ze_command_list_handle_t hCommandList, const void *ptr, size_t size), (hCommandList, ptr, size))
+ZE_TRACE(zeCommandListAppendMemAdvise, (ze_command_list_handle_t hCommandList, ze_device_handle_t hDevice, const void *ptr, size_t size, ze_memory_advice_t advice), (hCommandList, hDevice, ptr, size, advice))
+ZE_TRACE(zeCommandListAppendLaunchKernel, (ze_command_list_handle_t hCommandList, ze_kernel_handle_t hKernel, const ze_group_count_t *pLaunchFuncArgs, ze_event_handle_t hSignalEvent, uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents), (hCommandList, hKernel, pLaunchFuncArgs, hSignalEvent, numWaitEvents, phWaitEvents))
+ZE_TRACE(zeCommandListAppendWriteGlobalTimestamp, (ze_command_list_handle_t hCommandList, uint64_t *dstptr, ze_event_handle_t hSignalEvent, uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents), (hCommandList, dstptr, hSignalEvent, numWaitEvents, phWaitEvents))
+ZE_TRACE(zeCommandListAppendQueryKernelTimestamps, (ze_command_list_handle_t hCommandList, uint32_t numEvents, ze_event_handle_t *phEvents, void *dstptr, const size_t *pOffsets, ze_event_handle_t hSignalEvent, uint32_t numWaitEvents, ze_event_handle_t *phWaitEvents), (hCommandList, numEvents, phEvents, dstptr, pOffsets, hSignalEvent, numWaitEvents, phWaitEvents))
+ZE_TRACE(zeCommandListAppendSignalEvent, (ze_command_list_handle_t hCommandList, ze_event_handle_t hEvent), (hCommandList, hEvent))
+ZE_TRACE(zeCommandListAppendWaitOnEvents, (ze_command_list_handle_t hCommandList, uint32_t numEvents, ze_event_handle_t *phEvents), (hCommandList, numEvents, phEvents))
+ZE_TRACE(zeCommandListAppendEventReset, (ze_command_list_handle_t hCommandList, ze_event_handle_t hEvent), (hCommandList, hEvent))
+
+// Synchronization
+ZE_TRACE(zeFenceCreate, (ze_command_queue_handle_t hCommandQueue, const ze_fence_desc_t *desc, ze_fence_handle_t *phFence), (hCommandQueue, desc, phFence))
+ZE_TRACE(zeFenceDestroy, (ze_fence_handle_t hFence), (hFence))
+ZE_TRACE(zeFenceHostSynchronize, (ze_fence_handle_t hFence, uint64_t timeout), (hFence, timeout))
+ZE_TRACE(zeFenceQueryStatus, (ze_fence_handle_t hFence), (hFence))
+ZE_TRACE(zeFenceReset, (ze_fence_handle_t hFence), (hFence))
+ZE_TRACE(zeEventPoolCreate, (ze_context_handle_t hContext, const ze_event_pool_desc_t *desc, uint32_t numDevices, ze_device_handle_t *phDevices, ze_event_pool_handle_t *phEventPool), (hContext, desc, numDevices, phDevices, phEventPool))
+ZE_TRACE(zeEventPoolDestroy, (ze_event_pool_handle_t hEventPool), (hEventPool))
+ZE_TRACE(zeEventCreate, (ze_event_pool_handle_t hEventPool, const ze_event_desc_t *desc, ze_event_handle_t *phEvent), (hEventPool, desc, phEvent))
+ZE_TRACE(zeEventDestroy, (ze_event_handle_t hEvent), (hEvent))
+ZE_TRACE(zeEventHostSignal, (ze_event_handle_t hEvent), (hEvent))
+ZE_TRACE(zeEventHostSynchronize, (ze_event_handle_t hEvent, uint64_t timeout), (hEvent, timeout))
+ZE_TRACE(zeEventQueryStatus, (ze_event_handle_t hEvent), (hEvent))
+ZE_TRACE(zeEventHostReset, (ze_event_handle_t hEvent), (hEvent))
+ZE_TRACE(zeEventQueryKernelTimestamp, (ze_event_handle_t hEvent, ze_kernel_timestamp_result_t *dstptr), (hEvent, dstptr))
+
+// Memory
+ZE_TRACE(zeMemAllocShared, (ze_context_handle_t hContext, const ze_device_mem_alloc_desc_t *deviceDesc, const ze_host_mem_alloc_desc_t *hostDesc, size_t size, size_t alignment, ze_device_handle_t hDevice, void **pptr), (hContext, deviceDesc, hostDesc, size, alignment, hDevice, pptr))
+ZE_TRACE(zeMemAllocDevice, (ze_context_handle_t hContext, const ze_device_mem_alloc_desc_t *deviceDesc, size_t size, size_t alignment, ze_device_handle_t hDevice, void **pptr), (hContext, deviceDesc, size, alignment, hDevice, pptr))
+ZE_TRACE(zeMemAllocHost, (ze_context_handle_t hContext, const ze_host_mem_alloc_desc_t *hostDesc, size_t size, size_t alignment, void **pptr), (hContext, hostDesc, size, alignment, pptr))
+ZE_TRACE(zeMemFree, (ze_context_handle_t hContext, void *ptr), (hContext, ptr))
+
+// Modules and kernels
+ZE_TRACE(zeModuleCreate, (ze_context_handle_t hContext, ze_device_handle_t hDevice, const ze_module_desc_t *desc, ze_module_handle_t *phModule, ze_module_build_log_handle_t *phBuildLog), (hContext, hDevice, desc, phModule, phBuildLog))
+ZE_TRACE(zeModuleDestroy, (ze_module_handle_t hModule), (hModule))
+ZE_TRACE(zeModuleBuildLogDestroy, (ze_module_build_log_handle_t hModuleBuildLog), (hModuleBuildLog))
+ZE_TRACE(zeModuleBuildLogGetString, (ze_module_build_log_handle_t hModuleBuildLog, size_t *pSize, char *pBuildLog), (hModuleBuildLog, pSize, pBuildLog))
+ZE_TRACE(zeKernelCreate, (ze_module_handle_t hModule, const ze_kernel_desc_t *desc, ze_kernel_handle_t *phKernel), (hModule, desc, phKernel))
+ZE_TRACE(zeKernelDestroy, (ze_kernel_handle_t hKernel), (hKernel))
+ZE_TRACE(zeKernelSetGroupSize, (ze_kernel_handle_t hKernel, uint32_t groupSizeX, uint32_t groupSizeY, uint32_t groupSizeZ), (hKernel, groupSizeX, groupSizeY, groupSizeZ))
+ZE_TRACE(zeKernelSuggestGroupSize, (ze_kernel_handle_t hKernel, uint32_t globalSizeX, uint32_t globalSizeY, uint32_t globalSizeZ, uint32_t *groupSizeX, uint32_t *groupSizeY, uint32_t *groupSizeZ), (hKernel, globalSizeX, globalSizeY, globalSizeZ, groupSizeX, groupSizeY, groupSizeZ))
+ZE_TRACE(zeKernelSetArgumentValue, (ze_kernel_handle_t hKernel, uint32_t argIndex, size_t argSize, const void *pArgValue), (hKernel, argIndex, argSize, pArgValue))
+ZE_TRACE(zeKernelSetIndirectAccess, (ze_kernel_handle_t hKernel, ze_kernel_indirect_access_flags_t flags), (hKernel, flags))